@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_ASYNCASSET_HH_
+#define GZ_RENDERING_ASYNCASSET_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/common/Image.hh>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/Export.hh"
+#include "gz/rendering/MeshDescriptor.hh"
+#include "gz/rendering/RenderTypes.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    // forward declarations
+    class AsyncAssetPrivate;
+    class AsyncAssetLoaderPrivate;
+
+    /// \brief Kind of asset loaded asynchronously
+    enum class GZ_RENDERING_VISIBLE AsyncAssetType : uint8_t
+    {
+      /// \brief A mesh file, see Scene::LoadMeshAsync
+      MESH = 0,
+
+      /// \brief An image file, see Scene::LoadTextureAsync
+      TEXTURE = 1
+    };
+
+    /// \brief Loading state of an asynchronous asset
+    enum class GZ_RENDERING_VISIBLE AsyncAssetState : uint8_t
+    {
+      /// \brief The asset is being decoded or waits for its upload
+      PENDING = 0,
+
+      /// \brief The asset is decoded and uploaded
+      READY = 1,
+
+      /// \brief The asset could not be loaded
+      FAILED = 2
+    };
+
+    /// \brief Handle of an asset loaded in the background.
+    ///
+    /// Files are decoded on worker threads. Render engine resources are
+    /// created on the render thread, either during Scene::PreRender within
+    /// the budget set with Scene::SetAssetUploadBudget, or when waiting
+    /// for the asset with Scene::WaitForAssets.
+    /// \sa Scene::LoadMeshAsync
+    /// \sa Scene::LoadTextureAsync
+    class GZ_RENDERING_VISIBLE AsyncAsset
+    {
+      /// \brief Constructor
+      /// \param[in] _type Kind of asset
+      /// \param[in] _name Mesh or image file name
+      public: AsyncAsset(AsyncAssetType _type, const std::string &_name);
+
+      /// \brief Destructor
+      public: ~AsyncAsset();
+
+      /// \brief Get the kind of asset
+      /// \return Kind of asset
+      public: AsyncAssetType Type() const;
+
+      /// \brief Get the mesh or image file name
+      /// \return File name of the asset
+      public: std::string Name() const;
+
+      /// \brief Get the loading state. Can be called from any thread.
+      /// \return Loading state of the asset
+      public: AsyncAssetState State() const;
+
+      /// \brief Get the loaded mesh. Other meshes created from the same
+      /// descriptor share its render engine buffers.
+      /// \return Mesh ready to be attached to a visual, null until the
+      /// asset is ready or if it is not a mesh
+      public: MeshPtr Mesh() const;
+
+      /// \brief Get the decoded image, which can be given to
+      /// Material::SetTexture together with the asset name
+      /// \return Decoded image, null until the asset is ready or if it is
+      /// not a texture
+      public: std::shared_ptr<const common::Image> Image() const;
+
+      /// \internal
+      /// \brief Get the mesh descriptor of a mesh asset
+      /// \return Mesh descriptor
+      public: MeshDescriptor &Descriptor();
+
+      /// \internal
+      /// \brief Take ownership of the mesh decoded by a worker thread, which
+      /// still has to be registered with the mesh manager
+      /// \return Decoded mesh, null if the mesh was already registered
+      public: common::Mesh *TakeDecodedMesh();
+
+      /// \internal
+      /// \brief Mark the asset as uploaded
+      /// \param[in] _mesh Mesh created from the asset, null for textures
+      public: void SetReady(MeshPtr _mesh);
+
+      /// \internal
+      /// \brief Mark the asset as failed
+      public: void SetFailed();
+
+      /// \brief Pointer to private data
+      private: std::unique_ptr<AsyncAssetPrivate> dataPtr;
+
+      /// \brief The loader fills in the decoded data
+      private: friend class AsyncAssetLoader;
+
+      /// \brief The loader workers fill in the decoded data
+      private: friend class AsyncAssetLoaderPrivate;
+    };
+
+    /// \internal
+    /// \brief Decodes mesh and image files on worker threads shared by the
+    /// loaders of all scenes in the process. Decoded assets are queued
+    /// per loader until the render thread creates their render engine
+    /// resources, see BaseScene.
+    class GZ_RENDERING_VISIBLE AsyncAssetLoader
+    {
+      /// \brief Constructor. Starts the workers if no other loader exists.
+      public: AsyncAssetLoader();
+
+      /// \brief Destructor. Pending assets of the loader are failed. The
+      /// workers stop with the last loader.
+      public: ~AsyncAssetLoader();
+
+      /// \brief Queue a mesh file for decoding. Must be called on the
+      /// render thread.
+      /// \param[in] _desc Mesh descriptor whose mesh name is the mesh file
+      /// \return Handle of the mesh
+      public: AsyncAssetPtr LoadMesh(const MeshDescriptor &_desc);
+
+      /// \brief Queue an image file for decoding
+      /// \param[in] _texture Image file name
+      /// \return Handle of the texture
+      public: AsyncAssetPtr LoadTexture(const std::string &_texture);
+
+      /// \brief Take the next decoded asset waiting for its upload
+      /// \return Decoded asset, null if none is waiting
+      public: AsyncAssetPtr NextDecoded();
+
+      /// \brief Block until one of the given assets is decoded, then take
+      /// it. Other decoded assets keep waiting for their upload.
+      /// \param[in] _assets Assets to wait for
+      /// \return Decoded asset, null if none of the assets is waiting for
+      /// its upload and no asset is being decoded
+      public: AsyncAssetPtr WaitForDecoded(
+                  const std::vector<AsyncAssetPtr> &_assets);
+
+      /// \brief Pointer to private data
+      private: std::unique_ptr<AsyncAssetLoaderPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
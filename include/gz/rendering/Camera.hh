@@ -158,6 +158,17 @@ namespace gz
       public: virtual VisualPtr VisualAt(const gz::math::Vector2i
                   &_mousePos) = 0;
 
+      /// \brief Get the visual for a given mouse position, and the index of
+      /// the instance under the mouse if the visual is an InstancedVisual
+      /// \param[in] _mousePos mouse position
+      /// \param[out] _instanceIndex Index of the instance, 0 if the visual
+      /// is not instanced
+      /// \return visual for that position, null if no visual was found
+      /// \sa InstancedVisual
+      public: virtual VisualPtr VisualInstanceAt(
+                  const gz::math::Vector2i &_mousePos,
+                  unsigned int &_instanceIndex) = 0;
+
       /// \brief Renders a new frame.
       /// This is a convenience function for single-camera scenes. It wraps the
       /// pre-render, render, and post-render into a single
@@ -354,6 +365,19 @@ namespace gz
       /// \internal
       /// \brief Notify that shadows are dirty and need to be regenerated
       public: virtual void SetShadowsDirty() = 0;
+
+      /// \brief Set whether the camera may render while textures are still
+      /// being loaded, showing placeholder textures until they are ready.
+      /// By default a camera waits for pending textures so that every frame
+      /// is complete and deterministic, which is what sensors need. Cameras
+      /// only displayed in a GUI can allow placeholders to avoid stalling.
+      /// \param[in] _allow True to render with placeholder textures
+      public: virtual void SetAllowPlaceholderTextures(bool _allow) = 0;
+
+      /// \brief Get whether the camera may render with placeholder textures
+      /// \return True if the camera does not wait for pending textures
+      /// \sa SetAllowPlaceholderTextures
+      public: virtual bool AllowPlaceholderTextures() const = 0;
     };
     }
   }
@@ -218,6 +218,34 @@ inline namespace GZ_RENDERING_VERSION_NAMESPACE {
     /// \param[in] _sampling The heightmap's sampling per datum.
     public: void SetSampling(unsigned int _sampling);
 
+    /// \brief Get the number of samples along each side of a terrain tile
+    /// \return Samples per tile side, 0 if the heightmap is not tiled
+    /// \sa SetTileSize
+    public: unsigned int TileSize() const;
+
+    /// \brief Split the heightmap into a grid of square tiles which are
+    /// loaded and unloaded depending on the distance to the cameras, so
+    /// that only the terrain near the cameras is kept in GPU memory. Tiles
+    /// share their edge samples so they join without seams. Only
+    /// supported by ogre2. Defaults to 0, which loads the whole heightmap
+    /// as one terrain.
+    /// \param[in] _size Samples per tile side, after sampling. Must be a
+    /// power of two.
+    /// \sa SetTileLoadDistance
+    public: void SetTileSize(unsigned int _size);
+
+    /// \brief Get the distance from a camera within which terrain tiles
+    /// are loaded
+    /// \return Load distance in meters
+    public: double TileLoadDistance() const;
+
+    /// \brief Set the horizontal distance from a camera within which
+    /// terrain tiles are loaded before rendering. Tiles a bit further away
+    /// are prepared in the background, and tiles far from every camera
+    /// are unloaded. Defaults to 1000 meters.
+    /// \param[in] _distance Load distance in meters
+    public: void SetTileLoadDistance(double _distance);
+
     /// \brief Get the number of heightmap textures.
     /// \return Number of heightmap textures contained in this Heightmap object.
     public: uint64_t TextureCount() const;
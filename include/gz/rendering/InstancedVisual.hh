@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_INSTANCEDVISUAL_HH_
+#define GZ_RENDERING_INSTANCEDVISUAL_HH_
+
+#include <gz/math/Color.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+#include "gz/rendering/config.hh"
+#include "gz/rendering/RenderTypes.hh"
+#include "gz/rendering/Visual.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \class InstancedVisual InstancedVisual.hh
+    /// gz/rendering/InstancedVisual.hh
+    /// \brief A visual that draws many copies of one mesh with one material,
+    /// e.g. trees, boxes or crowd props. The visual owns packed arrays of the
+    /// pose, scale, color and visibility of a fixed number of instances,
+    /// which are far cheaper than one visual per copy and are drawn with
+    /// hardware instancing.
+    ///
+    /// Instances are identified by their index in [0, Capacity()). Poses
+    /// are relative to the instanced visual. Each instance is reported as
+    /// a separate object by segmentation and bounding box cameras, while
+    /// selection reports the instanced visual and the index of the
+    /// instance, see Camera::VisualAt.
+    /// \sa Scene::CreateInstancedVisual
+    class GZ_RENDERING_VISIBLE InstancedVisual :
+      public virtual Visual
+    {
+      /// \brief Constructor
+      protected: InstancedVisual();
+
+      /// \brief Destructor
+      public: virtual ~InstancedVisual();
+
+      /// \brief Get the number of instances
+      /// \return Number of instances
+      public: virtual unsigned int Capacity() const = 0;
+
+      /// \brief Set the pose of an instance relative to this visual
+      /// \param[in] _index Index of the instance
+      /// \param[in] _pose Pose of the instance
+      public: virtual void SetInstancePose(unsigned int _index,
+                  const math::Pose3d &_pose) = 0;
+
+      /// \brief Get the pose of an instance relative to this visual
+      /// \param[in] _index Index of the instance
+      /// \return Pose of the instance, or identity if _index is out of
+      /// range
+      public: virtual math::Pose3d InstancePose(unsigned int _index)
+                  const = 0;
+
+      /// \brief Set the scale of an instance
+      /// \param[in] _index Index of the instance
+      /// \param[in] _scale Scale of the instance
+      public: virtual void SetInstanceScale(unsigned int _index,
+                  const math::Vector3d &_scale) = 0;
+
+      /// \brief Get the scale of an instance
+      /// \param[in] _index Index of the instance
+      /// \return Scale of the instance, or one if _index is out of range
+      public: virtual math::Vector3d InstanceScale(unsigned int _index)
+                  const = 0;
+
+      /// \brief Set whether an instance is drawn
+      /// \param[in] _index Index of the instance
+      /// \param[in] _visible True to draw the instance
+      public: virtual void SetInstanceVisible(unsigned int _index,
+                  bool _visible) = 0;
+
+      /// \brief Get whether an instance is drawn
+      /// \param[in] _index Index of the instance
+      /// \return True if the instance is drawn, false if it is hidden or
+      /// _index is out of range
+      public: virtual bool InstanceVisible(unsigned int _index) const = 0;
+
+      /// \brief Set the color an instance is tinted with. The color
+      /// multiplies the shaded color of the material. Defaults to white,
+      /// i.e. no tint.
+      /// \param[in] _index Index of the instance
+      /// \param[in] _color Tint color
+      public: virtual void SetInstanceColor(unsigned int _index,
+                  const math::Color &_color) = 0;
+
+      /// \brief Get the color an instance is tinted with
+      /// \param[in] _index Index of the instance
+      /// \return Tint color, or white if _index is out of range
+      public: virtual math::Color InstanceColor(unsigned int _index)
+                  const = 0;
+    };
+    }
+  }
+}
+#endif
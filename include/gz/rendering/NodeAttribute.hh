@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_NODEATTRIBUTE_HH_
+#define GZ_RENDERING_NODEATTRIBUTE_HH_
+
+#include <cstdint>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/Export.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Type of the values stored for an interned node attribute
+    /// \sa Scene::InternAttribute
+    enum class GZ_RENDERING_VISIBLE NodeAttributeType : uint16_t
+    {
+      /// \brief Floating point values. Accepts float, double and int
+      /// user data.
+      FLOAT = 0,
+
+      /// \brief Integer values. Accepts int user data only.
+      INT = 1
+    };
+    }
+  }
+}
+#endif
@@ -22,6 +22,7 @@
 #include "gz/rendering/config.hh"
 #include "gz/rendering/GraphicsAPI.hh"
 #include "gz/rendering/RenderTypes.hh"
+#include "gz/rendering/StartupTimeline.hh"
 #include "gz/rendering/Export.hh"
 
 namespace gz
@@ -183,6 +184,17 @@ namespace gz
 
       /// \brief Get the render pass system for this engine.
       public: virtual RenderPassSystemPtr RenderPassSystem() const = 0;
+
+      /// \brief Get how long each phase of loading and initializing the
+      /// engine took, e.g. creating the graphics context, loading plugins,
+      /// registering resources and compiling shaders, together with the
+      /// number of resources and shaders each phase created. If the
+      /// "startupTracePath" engine parameter, or else the
+      /// GZ_RENDERING_STARTUP_TRACE environment variable, is set, the
+      /// timeline is also written to that file as a Chrome trace once the
+      /// engine is initialized.
+      /// \return Startup phases, empty until the engine is loaded
+      public: virtual const StartupTimeline &StartupTimings() const = 0;
     };
     }
   }
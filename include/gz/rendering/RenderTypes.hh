@@ -47,6 +47,7 @@ namespace gz
     using shared_ptr = std::shared_ptr<T>;
 
     class ArrowVisual;
+    class AsyncAsset;
     class AxisVisual;
     class BoundingBoxCamera;
     class Camera;
@@ -63,6 +64,7 @@ namespace gz
     class Heightmap;
     class Image;
     class InertiaVisual;
+    class InstancedVisual;
     class Light;
     class LightVisual;
     class JointVisual;
@@ -101,6 +103,10 @@ namespace gz
     /// \brief Shared pointer to ArrowVisual
     typedef shared_ptr<ArrowVisual> ArrowVisualPtr;
 
+    /// \typedef AsyncAssetPtr
+    /// \brief Shared pointer to AsyncAsset
+    typedef shared_ptr<AsyncAsset> AsyncAssetPtr;
+
     /// \typedef AxisVisualPtr
     /// \brief Shared pointer to AxisVisual
     typedef shared_ptr<AxisVisual> AxisVisualPtr;
@@ -197,6 +203,10 @@ namespace gz
     /// \brief Shared pointer to FrustumVisual
     typedef shared_ptr<FrustumVisual> FrustumVisualPtr;
 
+    /// \typedef InstancedVisualPtr
+    /// \brief Shared pointer to InstancedVisual
+    typedef shared_ptr<InstancedVisual> InstancedVisualPtr;
+
     /// \typedef MaterialPtr
     /// \brief Shared pointer to Material
     typedef shared_ptr<Material> MaterialPtr;
@@ -363,6 +373,10 @@ namespace gz
     /// \brief Shared pointer to const FrustumVisual
     typedef shared_ptr<const FrustumVisual> ConstFrustumVisualPtr;
 
+    /// \typedef const InstancedVisualPtr
+    /// \brief Shared pointer to const InstancedVisual
+    typedef shared_ptr<const InstancedVisual> ConstInstancedVisualPtr;
+
     /// \typedef const MaterialPtr
     /// \brief Shared pointer to const Material
     typedef shared_ptr<const Material> ConstMaterialPtr;
@@ -18,8 +18,10 @@
 #define GZ_RENDERING_SCENE_HH_
 
 #include <array>
+#include <chrono>
 #include <string>
 #include <limits>
+#include <vector>
 
 #include <gz/common/Material.hh>
 #include <gz/common/Mesh.hh>
@@ -28,11 +30,16 @@
 
 #include "gz/rendering/base/SceneExt.hh"
 
+#include "gz/rendering/AsyncAsset.hh"
 #include "gz/rendering/config.hh"
 #include "gz/rendering/HeightmapDescriptor.hh"
 #include "gz/rendering/MeshDescriptor.hh"
+#include "gz/rendering/NodeAttribute.hh"
 #include "gz/rendering/RenderTypes.hh"
+#include "gz/rendering/SceneChange.hh"
 #include "gz/rendering/Storage.hh"
+#include "gz/rendering/VisualDescriptor.hh"
+#include "gz/rendering/WarmUpOptions.hh"
 #include "gz/rendering/Export.hh"
 
 namespace gz
@@ -816,6 +823,25 @@ namespace gz
       public: virtual VisualPtr CreateVisual(
                   unsigned int _id, const std::string &_name) = 0;
 
+      /// \brief Create a batch of visuals described by the given
+      /// descriptors. This is equivalent to calling CreateVisual, CreateMesh,
+      /// AddGeometry, SetMaterial and AddChild for each descriptor but
+      /// validates the whole batch up front, registers all visuals in a
+      /// single pass and resolves meshes shared between descriptors only
+      /// once. Materials are shared, not cloned. If any descriptor has an
+      /// invalid parent index or a name that is already in use, no visual
+      /// is created.
+      /// \param[in] _batch Descriptors of the visuals to create. Parents
+      /// must appear before their children.
+      /// \param[in] _parent Parent of the visuals whose descriptor has no
+      /// parent index. Null to leave them detached.
+      /// \return The created visuals in the same order as the descriptors.
+      /// An entry is null if its visual could not be created. An empty
+      /// vector is returned if the batch is invalid.
+      public: virtual std::vector<VisualPtr> CreateVisuals(
+                  const std::vector<VisualDescriptor> &_batch,
+                  VisualPtr _parent = nullptr) = 0;
+
       /// \brief Create new arrow visual. A unique ID and name will
       /// automatically be assigned to the visual.
       /// \return The created arrow visual
@@ -1135,6 +1161,22 @@ namespace gz
       public: virtual FrustumVisualPtr CreateFrustumVisual(
                   unsigned int _id, const std::string &_name) = 0;
 
+      /// \brief Create new instanced visual that draws many copies of a
+      /// mesh with one material. Instances are placed with
+      /// InstancedVisual::SetInstancePose and all start at the origin of the
+      /// visual.
+      /// \remarks Not all rendering engines support this.
+      /// ogre2 plugin does.
+      /// \param[in] _desc Mesh of each instance
+      /// \param[in] _material Material of each instance. If null, the
+      /// materials of the mesh are used.
+      /// \param[in] _capacity Number of instances
+      /// \return The created instanced visual, or null on failure or if
+      /// instanced visuals are not supported
+      public: virtual InstancedVisualPtr CreateInstancedVisual(
+                  const MeshDescriptor &_desc, MaterialPtr _material,
+                  unsigned int _capacity) = 0;
+
       /// \brief Create new heightmap geomerty. The rendering::Heightmap will be
       /// created from the given HeightmapDescriptor.
       /// \param[in] _desc Data about the heightmap
@@ -1363,6 +1405,239 @@ namespace gz
       /// SetCameraPassCountPerGpuFlush
       public: virtual bool LegacyAutoGpuFlush() const = 0;
 
+      /// \brief Enable or disable recycling of the underlying render engine
+      /// objects of destroyed visuals and geometries. When enabled,
+      /// destroying a visual or mesh geometry returns its engine objects
+      /// (e.g. scene nodes and items) to a free list and creating a new
+      /// visual or a geometry of the same mesh reuses them. This avoids
+      /// allocation and bookkeeping spikes in scenes that create and destroy
+      /// many short-lived objects, e.g. markers. Disabling pooling releases
+      /// all pooled objects. Disabled by default.
+      /// \remarks Not all rendering engines support this.
+      /// ogre2 plugin does.
+      /// \param[in] _enabled True to enable object pooling
+      public: virtual void SetObjectPoolingEnabled(bool _enabled) = 0;
+
+      /// \brief Get whether object pooling is enabled
+      /// \return True if object pooling is enabled.
+      /// ALWAYS returns false for plugins that do not support it.
+      /// \sa SetObjectPoolingEnabled
+      public: virtual bool ObjectPoolingEnabled() const = 0;
+
+      /// \brief Enable or disable automatic level of detail generation for
+      /// meshes loaded afterwards. When enabled, simplified versions of each
+      /// dense mesh are generated when it is loaded, and cameras and sensors
+      /// switch to a simplified version when its geometric error projects
+      /// to less than a pixel, scaled by Sensor::LodBias. Open borders and
+      /// texture or normal seams are preserved. Skeletal meshes are not
+      /// simplified. Disabled by default.
+      /// \remarks Not all rendering engines support this.
+      /// ogre2 plugin does.
+      /// \param[in] _enabled True to generate mesh LODs
+      public: virtual void SetMeshLodEnabled(bool _enabled) = 0;
+
+      /// \brief Get whether automatic mesh LOD generation is enabled
+      /// \return True if mesh LODs are generated.
+      /// ALWAYS returns false for plugins that do not support it.
+      /// \sa SetMeshLodEnabled
+      public: virtual bool MeshLodEnabled() const = 0;
+
+      /// \brief Enable or disable compact vertex formats for meshes loaded
+      /// afterwards. When enabled, vertex normals and tangents are packed
+      /// into a single quaternion of 16 bit integers, which reduces GPU
+      /// memory use and vertex fetch bandwidth at the cost of slightly less
+      /// precise shading. Positions keep full precision. Independently of
+      /// this setting, texture coordinates are stored as half floats and
+      /// submeshes with fewer than 65536 vertices use 16 bit indices.
+      /// Disabled by default.
+      /// \remarks Not all rendering engines support this.
+      /// ogre2 plugin does.
+      /// \param[in] _enabled True to quantize mesh vertex attributes
+      public: virtual void SetMeshQuantizationEnabled(bool _enabled) = 0;
+
+      /// \brief Get whether mesh vertex attributes are quantized
+      /// \return True if mesh vertex attributes are quantized.
+      /// ALWAYS returns false for plugins that do not support it.
+      /// \sa SetMeshQuantizationEnabled
+      public: virtual bool MeshQuantizationEnabled() const = 0;
+
+      /// \brief Merge the meshes of static visuals that share a material
+      /// into batches, so they are drawn with far fewer draw calls. Meshes
+      /// are grouped by material, visibility flags and the cells of a
+      /// regular grid, so batches far from the camera are still culled.
+      /// Existing batches are rebuilt. Batched visuals must not be moved
+      /// and their materials must not be changed while batched; call this
+      /// function again, or ClearStaticBatches, after doing so. Hiding,
+      /// removing from its parent, destroying or setting a batched visual
+      /// as non static removes the batches it belongs to, as does hiding or
+      /// removing one of its ancestors. Batches use the full detail mesh.
+      /// \remarks Not all rendering engines support this.
+      /// ogre2 plugin does.
+      /// \param[in] _cellSize Edge length of the grid cells in meters
+      /// \return Number of batches created.
+      /// ALWAYS returns 0 for plugins that do not support it.
+      /// \sa Visual::SetStatic
+      public: virtual unsigned int BuildStaticBatches(
+                  double _cellSize = 10.0) = 0;
+
+      /// \brief Destroy all static batches and draw the batched visuals
+      /// individually again
+      /// \sa BuildStaticBatches
+      public: virtual void ClearStaticBatches() = 0;
+
+      /// \brief Get the number of static batches currently drawn
+      /// \return Number of static batches.
+      /// ALWAYS returns 0 for plugins that do not support it.
+      /// \sa BuildStaticBatches
+      public: virtual unsigned int StaticBatchCount() const = 0;
+
+      /// \brief Load a mesh in the background. The mesh file is decoded
+      /// on a worker thread, then its render engine buffers are created on
+      /// the render thread during PreRender, within the asset upload
+      /// budget. COLLADA, OBJ and STL files are decoded in the background,
+      /// other formats are loaded by the mesh manager during the upload.
+      /// Must be called on the render thread.
+      /// \param[in] _desc Mesh descriptor. Its mesh name is the mesh file,
+      /// or the name of a mesh already known by the mesh manager.
+      /// \return Handle of the mesh
+      /// \sa WaitForAssets
+      public: virtual AsyncAssetPtr LoadMeshAsync(
+                  const MeshDescriptor &_desc) = 0;
+
+      /// \brief Decode an image file in the background. Once ready, the
+      /// image can be given to Material::SetTexture together with the
+      /// asset name, so only the GPU upload happens on the render thread.
+      /// \param[in] _texture Image file name
+      /// \return Handle of the texture
+      /// \sa WaitForAssets
+      public: virtual AsyncAssetPtr LoadTextureAsync(
+                  const std::string &_texture) = 0;
+
+      /// \brief Block until the given assets are loaded, uploading them as
+      /// soon as they are decoded regardless of the upload budget. Other
+      /// decoded assets are still uploaded within the budget of PreRender.
+      /// Sensor pipelines that need deterministic frames call this before
+      /// rendering the frames that use the assets.
+      /// \param[in] _assets Assets to wait for
+      /// \return True if all the assets are ready, false if any failed
+      public: virtual bool WaitForAssets(
+                  const std::vector<AsyncAssetPtr> &_assets) = 0;
+
+      /// \brief Set the time PreRender may spend creating the render engine
+      /// resources of decoded assets. At least one asset is uploaded per
+      /// frame. Default is 4 milliseconds.
+      /// \param[in] _budget Upload time per frame
+      /// \sa LoadMeshAsync
+      public: virtual void SetAssetUploadBudget(
+                  std::chrono::steady_clock::duration _budget) = 0;
+
+      /// \brief Get the time PreRender may spend uploading decoded assets
+      /// \return Upload time per frame
+      /// \sa SetAssetUploadBudget
+      public: virtual std::chrono::steady_clock::duration
+                  AssetUploadBudget() const = 0;
+
+      /// \brief Compile the shaders of the scene ahead of time. The first
+      /// use of a material in a render mode, e.g. the solid color mode of
+      /// GPU rays, the thermal mode or the segmentation and bounding box
+      /// modes, otherwise generates and compiles its shaders in the middle
+      /// of a frame. This renders every camera and sensor of the scene
+      /// once, or once per direction, without updating their outputs or
+      /// emitting new frame events, so that their first updates take as
+      /// long as the following ones. Call it after the scene and its
+      /// sensors are created, on the render thread. Cameras are left at
+      /// their current pose.
+      /// \param[in] _options Warm up options
+      /// \return Number of cameras and sensors rendered
+      public: virtual unsigned int WarmUp(
+                  const WarmUpOptions &_options = WarmUpOptions()) = 0;
+
+      /// \brief Enable or disable the scene change journal. When enabled,
+      /// the scene records node creation and destruction, reparenting, and
+      /// pose, material and visibility changes. Consumers that mirror the
+      /// scene can drain the journal once per frame with DrainChanges and
+      /// only process what changed instead of traversing the whole scene.
+      /// Repeated pose, material or visibility changes of the same node
+      /// are recorded once until the journal is drained. Disabling the
+      /// journal discards all recorded changes. Disabled by default.
+      /// \param[in] _enabled True to enable the change journal
+      public: virtual void SetChangeJournalEnabled(bool _enabled) = 0;
+
+      /// \brief Get whether the scene change journal is enabled
+      /// \return True if the change journal is enabled
+      /// \sa SetChangeJournalEnabled
+      public: virtual bool ChangeJournalEnabled() const = 0;
+
+      /// \brief Get all changes recorded since the last call and clear the
+      /// journal
+      /// \return Recorded changes in the order they occurred
+      /// \sa SetChangeJournalEnabled
+      public: virtual std::vector<SceneChange> DrainChanges() = 0;
+
+      /// \brief Record a change in the scene change journal. This is called
+      /// by scene objects and does nothing if the journal is disabled.
+      /// \param[in] _change Change to record
+      /// \sa SetChangeJournalEnabled
+      public: virtual void RecordChange(const SceneChange &_change) = 0;
+
+      /// \brief Intern a node user data key as a typed attribute. Values
+      /// of interned keys set with Node::SetUserData are mirrored in dense
+      /// per-attribute storage, so hot paths such as material switchers can
+      /// read them by numeric handle instead of looking up and decoding
+      /// string-keyed user data for every object on every frame. User data
+      /// of existing visuals is mirrored when the key is interned, so keys
+      /// are best interned before visuals are created. The "temperature"
+      /// and "laser_retro" (FLOAT) and "label" (INT) keys are interned
+      /// when the scene is initialized.
+      /// \param[in] _key User data key
+      /// \param[in] _type Type of the attribute values
+      /// \return Handle of the attribute. Interning a key again returns the
+      /// same handle. Returns 0 if the key is empty or was already interned
+      /// with a different type.
+      public: virtual unsigned int InternAttribute(const std::string &_key,
+                  NodeAttributeType _type) = 0;
+
+      /// \brief Get the handle of an interned attribute
+      /// \param[in] _key User data key
+      /// \return Handle of the attribute, or 0 if the key is not interned
+      /// \sa InternAttribute
+      public: virtual unsigned int AttributeHandle(
+                  const std::string &_key) const = 0;
+
+      /// \brief Get the value of a FLOAT attribute of a node
+      /// \param[in] _handle Handle of the attribute
+      /// \param[in] _nodeId Id of the node
+      /// \param[out] _value Value of the attribute
+      /// \return True if the node has a value for the attribute
+      /// \sa InternAttribute
+      public: virtual bool FloatAttribute(unsigned int _handle,
+                  unsigned int _nodeId, float &_value) const = 0;
+
+      /// \brief Get the value of an INT attribute of a node
+      /// \param[in] _handle Handle of the attribute
+      /// \param[in] _nodeId Id of the node
+      /// \param[out] _value Value of the attribute
+      /// \return True if the node has a value for the attribute
+      /// \sa InternAttribute
+      public: virtual bool IntAttribute(unsigned int _handle,
+                  unsigned int _nodeId, int &_value) const = 0;
+
+      /// \brief Set the attribute value of a node. This is called by nodes
+      /// when user data of an interned key is set. Values of a type the
+      /// attribute does not accept remove the node's value.
+      /// \param[in] _handle Handle of the attribute
+      /// \param[in] _nodeId Id of the node
+      /// \param[in] _value New value
+      /// \sa InternAttribute
+      public: virtual void SetAttribute(unsigned int _handle,
+                  unsigned int _nodeId, const Variant &_value) = 0;
+
+      /// \brief Remove all attribute values of a node. This is called by
+      /// nodes when they are destroyed.
+      /// \param[in] _nodeId Id of the node
+      /// \sa InternAttribute
+      public: virtual void RemoveAttributes(unsigned int _nodeId) = 0;
+
       /// \brief Remove and destroy all objects from the scene graph. This does
       /// not completely destroy scene resources, so new objects can be created
       /// and added to the scene afterwards.
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_SCENECHANGE_HH_
+#define GZ_RENDERING_SCENECHANGE_HH_
+
+#include <cstdint>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/Export.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Type of change recorded in the scene change journal
+    /// \sa Scene::SetChangeJournalEnabled
+    enum class GZ_RENDERING_VISIBLE SceneChangeType : uint16_t
+    {
+      /// \brief A node was created and registered in the scene
+      NODE_CREATED = 0,
+
+      /// \brief A node was destroyed
+      NODE_DESTROYED = 1,
+
+      /// \brief A node was attached to or detached from a parent node
+      NODE_REPARENTED = 2,
+
+      /// \brief The local pose or scale of a node changed
+      POSE_CHANGED = 3,
+
+      /// \brief The material of a visual changed
+      MATERIAL_CHANGED = 4,
+
+      /// \brief The visibility of a visual changed
+      VISIBILITY_CHANGED = 5
+    };
+
+    /// \struct SceneChange SceneChange.hh gz/rendering/SceneChange.hh
+    /// \brief A single entry in the scene change journal
+    struct GZ_RENDERING_VISIBLE SceneChange
+    {
+      /// \brief Type of change
+      public: SceneChangeType type = SceneChangeType::NODE_CREATED;
+
+      /// \brief Id of the node that changed
+      public: unsigned int nodeId = 0u;
+
+      /// \brief Id of the new parent node for NODE_REPARENTED changes.
+      /// 0 if the node was detached from its parent.
+      public: unsigned int parentId = 0u;
+    };
+    }
+  }
+}
+#endif
@@ -42,6 +42,20 @@ namespace gz
       /// \brief Get visibility mask
       /// \return visibility mask
       public: virtual uint32_t VisibilityMask() const = 0;
+
+      /// \brief Set the level of detail bias of the sensor. Mesh LODs are
+      /// switched when their geometric error projects to one pixel of the
+      /// sensor image, multiplied by the bias. Values greater than 1 keep
+      /// detailed LODs longer, values less than 1 switch to simplified LODs
+      /// sooner. The default is 1.
+      /// \param[in] _bias LOD bias, must be positive
+      /// \sa Scene::SetMeshLodEnabled
+      public: virtual void SetLodBias(double _bias) = 0;
+
+      /// \brief Get the level of detail bias of the sensor
+      /// \return LOD bias
+      /// \sa SetLodBias
+      public: virtual double LodBias() const = 0;
     };
     }
   }
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_STARTUPTIMELINE_HH_
+#define GZ_RENDERING_STARTUPTIMELINE_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gz/utils/SuppressWarning.hh>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/Export.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \struct StartupPhase StartupTimeline.hh
+    /// gz/rendering/StartupTimeline.hh
+    /// \brief Time spent in one phase of loading or initializing a render
+    /// engine
+    struct GZ_RENDERING_VISIBLE StartupPhase
+    {
+      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Name of the phase, e.g. "CreateContext"
+      public: std::string name;
+      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+
+      /// \brief Start of the phase relative to the start of the engine load
+      public: std::chrono::steady_clock::duration start{0};
+
+      /// \brief Wall time spent in the phase
+      public: std::chrono::steady_clock::duration duration{0};
+
+      /// \brief Number of resources, e.g. resource locations or indexed
+      /// files, registered during the phase
+      public: uint64_t resourceCount = 0u;
+
+      /// \brief Number of shader programs created during the phase
+      public: uint64_t shaderCount = 0u;
+    };
+
+    /// \struct StartupTimeline StartupTimeline.hh
+    /// gz/rendering/StartupTimeline.hh
+    /// \brief Phases of loading and initializing a render engine, in the
+    /// order they ran
+    /// \sa RenderEngine::StartupTimings
+    struct GZ_RENDERING_VISIBLE StartupTimeline
+    {
+      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Recorded phases
+      public: std::vector<StartupPhase> phases;
+      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+
+      /// \brief Get the time from the start of the first phase to the end
+      /// of the last one
+      /// \return Total startup time
+      public: std::chrono::steady_clock::duration Total() const;
+
+      /// \brief Get the phases in the Chrome trace event format, which can
+      /// be opened with chrome://tracing or Perfetto
+      /// \param[in] _processName Name of the process shown in the trace
+      /// \return JSON trace
+      public: std::string ChromeTrace(
+                  const std::string &_processName = "gz-rendering") const;
+
+      /// \brief Write the phases to a file in the Chrome trace event format
+      /// \param[in] _path Path of the file
+      /// \return True if the file was written
+      public: bool WriteChromeTrace(const std::string &_path) const;
+    };
+    }
+  }
+}
+#endif
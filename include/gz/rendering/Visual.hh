@@ -134,6 +134,19 @@ namespace gz
       /// \param[in] _flags Visibility flags
       public: virtual void RemoveVisibilityFlags(uint32_t _flags) = 0;
 
+      /// \brief Mark the visual as static, i.e. it will not be moved and
+      /// its material will not change. Static visuals that share a material
+      /// can be merged into fewer draw calls by Scene::BuildStaticBatches.
+      /// Setting a batched visual as non static removes it from its batch.
+      /// \param[in] _static True if the visual is static
+      /// \sa Scene::BuildStaticBatches
+      public: virtual void SetStatic(bool _static) = 0;
+
+      /// \brief Get whether the visual is static
+      /// \return True if the visual is static
+      /// \sa SetStatic
+      public: virtual bool Static() const = 0;
+
       /// \brief Get the bounding box in world frame coordinates.
       /// \return The axis aligned bounding box
       public: virtual gz::math::AxisAlignedBox BoundingBox() const = 0;
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_VISUALDESCRIPTOR_HH_
+#define GZ_RENDERING_VISUALDESCRIPTOR_HH_
+
+#include <string>
+
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/utils/SuppressWarning.hh>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/MeshDescriptor.hh"
+#include "gz/rendering/RenderTypes.hh"
+#include "gz/rendering/Export.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \struct VisualDescriptor VisualDescriptor.hh
+    /// gz/rendering/VisualDescriptor.hh
+    /// \brief Describes a visual to be created as part of a batch using
+    /// Scene::CreateVisuals
+    struct GZ_RENDERING_VISIBLE VisualDescriptor
+    {
+      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Name of the visual. An empty string signifies a unique name
+      /// should be automatically assigned.
+      public: std::string name;
+      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+
+      /// \brief Index of the parent visual's descriptor within the batch.
+      /// The parent must appear before this descriptor in the batch.
+      /// A negative value attaches the visual to the parent given to
+      /// Scene::CreateVisuals, if any.
+      public: int parentIndex = -1;
+
+      /// \brief Local pose of the visual
+      public: math::Pose3d localPose = math::Pose3d::Zero;
+
+      /// \brief Local scale of the visual
+      public: math::Vector3d localScale = math::Vector3d::One;
+
+      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Mesh to attach to the visual as geometry. No geometry is
+      /// created if neither the mesh nor the mesh name are set. Descriptors
+      /// referring to the same mesh share a single mesh lookup.
+      public: MeshDescriptor mesh;
+
+      /// \brief Material to assign to the visual. The material is shared
+      /// by all visuals that reference it and is not cloned. Null to keep
+      /// the default material.
+      public: MaterialPtr material;
+      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+
+      /// \brief True if the visual should be visible
+      public: bool visible = true;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_WARMUPOPTIONS_HH_
+#define GZ_RENDERING_WARMUPOPTIONS_HH_
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/Export.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \struct WarmUpOptions WarmUpOptions.hh
+    /// gz/rendering/WarmUpOptions.hh
+    /// \brief Options of Scene::WarmUp
+    struct GZ_RENDERING_VISIBLE WarmUpOptions
+    {
+      /// \brief Besides its current view, also render each camera looking
+      /// along the six world axes, so that objects outside of the initial
+      /// view of a sensor get their shaders compiled too. Objects beyond
+      /// the far clip distance of every camera are not covered.
+      public: bool allDirections = true;
+
+      /// \brief Save the shader cache of the render engine after the warm
+      /// up, if the engine has one, so that later processes load the
+      /// compiled shaders instead of compiling them again
+      public: bool saveShaderCache = true;
+    };
+    }
+  }
+}
+#endif
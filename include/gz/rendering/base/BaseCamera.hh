@@ -108,6 +108,11 @@ namespace gz
       public: virtual VisualPtr VisualAt(const gz::math::Vector2i
                   &_mousePos) override;
 
+      // Documentation inherited.
+      public: virtual VisualPtr VisualInstanceAt(
+                  const gz::math::Vector2i &_mousePos,
+                  unsigned int &_instanceIndex) override;
+
       // Documentation inherited.
       public: virtual math::Matrix4d ProjectionMatrix() const override;
 
@@ -200,6 +205,12 @@ namespace gz
       // Documentation inherited.
       public: virtual void SetShadowsDirty() override;
 
+      // Documentation inherited.
+      public: virtual void SetAllowPlaceholderTextures(bool _allow) override;
+
+      // Documentation inherited.
+      public: virtual bool AllowPlaceholderTextures() const override;
+
       protected: virtual void *CreateImageBuffer() const;
 
       protected: virtual void Load() override;
@@ -263,6 +274,10 @@ namespace gz
       /// \brief Camera projection type
       protected: CameraProjectionType projectionType = CPT_PERSPECTIVE;
 
+      /// \brief True if the camera renders without waiting for pending
+      /// textures
+      protected: bool allowPlaceholderTextures = false;
+
       friend class BaseDepthCamera<T>;
     };
 
@@ -642,6 +657,16 @@ namespace gz
       return VisualPtr();
     }
 
+    //////////////////////////////////////////////////
+    template <class T>
+    VisualPtr BaseCamera<T>::VisualInstanceAt(
+        const gz::math::Vector2i &_mousePos, unsigned int &_instanceIndex)
+    {
+      // engines without instanced visuals only have instance 0
+      _instanceIndex = 0u;
+      return this->VisualAt(_mousePos);
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseCamera<T>::SetHFOV(const math::Angle &_hfov)
@@ -862,6 +887,20 @@ namespace gz
     {
       // no op
     }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseCamera<T>::SetAllowPlaceholderTextures(bool _allow)
+    {
+      this->allowPlaceholderTextures = _allow;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseCamera<T>::AllowPlaceholderTextures() const
+    {
+      return this->allowPlaceholderTextures;
+    }
     }
   }
 }
@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_RENDERING_BASEINSTANCEDVISUAL_HH_
+#define GZ_RENDERING_BASEINSTANCEDVISUAL_HH_
+
+#include <cstdint>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "gz/rendering/InstancedVisual.hh"
+#include "gz/rendering/base/BaseObject.hh"
+#include "gz/rendering/base/BaseRenderTypes.hh"
+#include "gz/rendering/Scene.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    /// \brief Base implementation of an instanced visual. Stores the
+    /// instance data in packed arrays and records which instances changed
+    /// so render engines only update those.
+    template <class T>
+    class BaseInstancedVisual :
+      public virtual InstancedVisual,
+      public virtual T
+    {
+      // Documentation inherited
+      protected: BaseInstancedVisual();
+
+      // Documentation inherited
+      public: virtual ~BaseInstancedVisual();
+
+      // Documentation inherited
+      public: virtual unsigned int Capacity() const override;
+
+      // Documentation inherited
+      public: virtual void SetInstancePose(unsigned int _index,
+                  const math::Pose3d &_pose) override;
+
+      // Documentation inherited
+      public: virtual math::Pose3d InstancePose(unsigned int _index)
+                  const override;
+
+      // Documentation inherited
+      public: virtual void SetInstanceScale(unsigned int _index,
+                  const math::Vector3d &_scale) override;
+
+      // Documentation inherited
+      public: virtual math::Vector3d InstanceScale(unsigned int _index)
+                  const override;
+
+      // Documentation inherited
+      public: virtual void SetInstanceVisible(unsigned int _index,
+                  bool _visible) override;
+
+      // Documentation inherited
+      public: virtual bool InstanceVisible(unsigned int _index)
+                  const override;
+
+      // Documentation inherited
+      public: virtual void SetInstanceColor(unsigned int _index,
+                  const math::Color &_color) override;
+
+      // Documentation inherited
+      public: virtual math::Color InstanceColor(unsigned int _index)
+                  const override;
+
+      /// \brief Allocate the instance arrays. All instances start at the
+      /// origin of the visual, unscaled, visible and white.
+      /// \param[in] _capacity Number of instances
+      protected: void SetCapacity(unsigned int _capacity);
+
+      /// \brief Check that an instance index is in range
+      /// \param[in] _index Index of the instance
+      /// \return True if the index is valid
+      protected: bool ValidInstance(unsigned int _index) const;
+
+      /// \brief Record that an instance changed since the last call to
+      /// ClearDirtyInstances
+      /// \param[in] _index Index of the instance
+      protected: void MarkInstanceDirty(unsigned int _index);
+
+      /// \brief Forget the changed instances once they have been applied
+      protected: void ClearDirtyInstances();
+
+      /// \brief Pose of each instance relative to the visual
+      protected: std::vector<math::Pose3d> instancePoses;
+
+      /// \brief Scale of each instance
+      protected: std::vector<math::Vector3d> instanceScales;
+
+      /// \brief Tint color of each instance
+      protected: std::vector<math::Color> instanceColors;
+
+      /// \brief Visibility of each instance, 1 if visible
+      protected: std::vector<uint8_t> instanceVisible;
+
+      /// \brief Indices of the instances changed since the last call to
+      /// ClearDirtyInstances
+      protected: std::vector<unsigned int> dirtyInstances;
+
+      /// \brief 1 for each instance in dirtyInstances, so instances that
+      /// change several times are only recorded once
+      protected: std::vector<uint8_t> instanceDirty;
+    };
+
+    /////////////////////////////////////////////////
+    // BaseInstancedVisual
+    /////////////////////////////////////////////////
+    template <class T>
+    BaseInstancedVisual<T>::BaseInstancedVisual()
+    {
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    BaseInstancedVisual<T>::~BaseInstancedVisual()
+    {
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    unsigned int BaseInstancedVisual<T>::Capacity() const
+    {
+      return static_cast<unsigned int>(this->instancePoses.size());
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    void BaseInstancedVisual<T>::SetInstancePose(unsigned int _index,
+        const math::Pose3d &_pose)
+    {
+      if (!this->ValidInstance(_index))
+        return;
+
+      this->instancePoses[_index] = _pose;
+      this->MarkInstanceDirty(_index);
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    math::Pose3d BaseInstancedVisual<T>::InstancePose(unsigned int _index)
+        const
+    {
+      if (_index >= this->instancePoses.size())
+        return math::Pose3d::Zero;
+      return this->instancePoses[_index];
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    void BaseInstancedVisual<T>::SetInstanceScale(unsigned int _index,
+        const math::Vector3d &_scale)
+    {
+      if (!this->ValidInstance(_index))
+        return;
+
+      this->instanceScales[_index] = _scale;
+      this->MarkInstanceDirty(_index);
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    math::Vector3d BaseInstancedVisual<T>::InstanceScale(unsigned int _index)
+        const
+    {
+      if (_index >= this->instanceScales.size())
+        return math::Vector3d::One;
+      return this->instanceScales[_index];
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    void BaseInstancedVisual<T>::SetInstanceVisible(unsigned int _index,
+        bool _visible)
+    {
+      if (!this->ValidInstance(_index))
+        return;
+
+      this->instanceVisible[_index] = _visible ? 1u : 0u;
+      this->MarkInstanceDirty(_index);
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    bool BaseInstancedVisual<T>::InstanceVisible(unsigned int _index) const
+    {
+      if (_index >= this->instanceVisible.size())
+        return false;
+      return this->instanceVisible[_index] != 0u;
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    void BaseInstancedVisual<T>::SetInstanceColor(unsigned int _index,
+        const math::Color &_color)
+    {
+      if (!this->ValidInstance(_index))
+        return;
+
+      this->instanceColors[_index] = _color;
+      this->MarkInstanceDirty(_index);
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    math::Color BaseInstancedVisual<T>::InstanceColor(unsigned int _index)
+        const
+    {
+      if (_index >= this->instanceColors.size())
+        return math::Color::White;
+      return this->instanceColors[_index];
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    void BaseInstancedVisual<T>::SetCapacity(unsigned int _capacity)
+    {
+      this->instancePoses.assign(_capacity, math::Pose3d::Zero);
+      this->instanceScales.assign(_capacity, math::Vector3d::One);
+      this->instanceColors.assign(_capacity, math::Color::White);
+      this->instanceVisible.assign(_capacity, 1u);
+      this->instanceDirty.assign(_capacity, 0u);
+      this->dirtyInstances.clear();
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    bool BaseInstancedVisual<T>::ValidInstance(unsigned int _index) const
+    {
+      if (_index >= this->instancePoses.size())
+      {
+        gzerr << "Instance index [" << _index << "] out of range for "
+              << "instanced visual [" << this->Name() << "] with capacity ["
+              << this->instancePoses.size() << "]" << std::endl;
+        return false;
+      }
+      return true;
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    void BaseInstancedVisual<T>::MarkInstanceDirty(unsigned int _index)
+    {
+      if (this->instanceDirty[_index])
+        return;
+      this->instanceDirty[_index] = 1u;
+      this->dirtyInstances.push_back(_index);
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    void BaseInstancedVisual<T>::ClearDirtyInstances()
+    {
+      for (unsigned int index : this->dirtyInstances)
+        this->instanceDirty[index] = 0u;
+      this->dirtyInstances.clear();
+    }
+    }
+  }
+}
+#endif
@@ -21,6 +21,7 @@
 #include <string>
 
 #include "gz/rendering/Node.hh"
+#include "gz/rendering/SceneChange.hh"
 #include "gz/rendering/Storage.hh"
 #include "gz/rendering/base/BaseStorage.hh"
 
@@ -200,6 +201,14 @@ namespace gz
       protected: virtual void SetLocalScaleImpl(
                      const math::Vector3d &_scale) = 0;
 
+      /// \brief Record a change in the scene change journal
+      /// \param[in] _type Type of change
+      /// \param[in] _nodeId Id of the node that changed
+      /// \param[in] _parentId Id of the new parent node for reparent changes
+      /// \sa Scene::SetChangeJournalEnabled
+      protected: void RecordChange(SceneChangeType _type,
+                     unsigned int _nodeId, unsigned int _parentId = 0u) const;
+
       protected: math::Vector3d origin;
 
       /// \brief Flag to indicate whether initial local pose
@@ -254,6 +263,8 @@ namespace gz
       if (this->AttachChild(_child))
       {
         this->Children()->Add(_child);
+        this->RecordChange(SceneChangeType::NODE_REPARENTED, _child->Id(),
+            this->Id());
       }
     }
 
@@ -262,7 +273,11 @@ namespace gz
     NodePtr BaseNode<T>::RemoveChild(NodePtr _child)
     {
       NodePtr child = this->Children()->Remove(_child);
-      if (child) this->DetachChild(child);
+      if (child)
+      {
+        this->DetachChild(child);
+        this->RecordChange(SceneChangeType::NODE_REPARENTED, child->Id());
+      }
       return child;
     }
 
@@ -271,7 +286,11 @@ namespace gz
     NodePtr BaseNode<T>::RemoveChildById(unsigned int _id)
     {
       NodePtr child = this->Children()->RemoveById(_id);
-      if (child) this->DetachChild(child);
+      if (child)
+      {
+        this->DetachChild(child);
+        this->RecordChange(SceneChangeType::NODE_REPARENTED, child->Id());
+      }
       return child;
     }
 
@@ -280,7 +299,11 @@ namespace gz
     NodePtr BaseNode<T>::RemoveChildByName(const std::string &_name)
     {
       NodePtr child = this->Children()->RemoveByName(_name);
-      if (child) this->DetachChild(child);
+      if (child)
+      {
+        this->DetachChild(child);
+        this->RecordChange(SceneChangeType::NODE_REPARENTED, child->Id());
+      }
       return child;
     }
 
@@ -289,7 +312,11 @@ namespace gz
     NodePtr BaseNode<T>::RemoveChildByIndex(unsigned int _index)
     {
       NodePtr child = this->Children()->RemoveByIndex(_index);
-      if (child) this->DetachChild(child);
+      if (child)
+      {
+        this->DetachChild(child);
+        this->RecordChange(SceneChangeType::NODE_REPARENTED, child->Id());
+      }
       return child;
     }
 
@@ -353,6 +380,7 @@ namespace gz
       }
 
       this->SetRawLocalPose(pose);
+      this->RecordChange(SceneChangeType::POSE_CHANGED, this->Id());
     }
 
     //////////////////////////////////////////////////
@@ -637,6 +665,11 @@ namespace gz
     {
       T::Destroy();
       this->RemoveParent();
+      this->RecordChange(SceneChangeType::NODE_DESTROYED, this->Id());
+
+      auto scene = this->Scene();
+      if (scene)
+        scene->RemoveAttributes(this->Id());
     }
 
     //////////////////////////////////////////////////
@@ -694,6 +727,15 @@ namespace gz
     void BaseNode<T>::SetUserData(const std::string &_key, Variant _value)
     {
      this->userData[_key] = _value;
+
+     // mirror values of interned keys in the scene attribute storage
+     auto scene = this->Scene();
+     if (scene)
+     {
+       unsigned int handle = scene->AttributeHandle(_key);
+       if (handle != 0u)
+         scene->SetAttribute(handle, this->Id(), _value);
+     }
     }
 
     //////////////////////////////////////////////////
@@ -713,6 +755,16 @@ namespace gz
     {
       return this->userData.find(_key) != this->userData.end();
     }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseNode<T>::RecordChange(SceneChangeType _type,
+        unsigned int _nodeId, unsigned int _parentId) const
+    {
+      auto scene = this->Scene();
+      if (scene && scene->ChangeJournalEnabled())
+        scene->RecordChange({_type, _nodeId, _parentId});
+    }
   }
 }
 #endif
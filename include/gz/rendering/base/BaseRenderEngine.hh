@@ -17,6 +17,8 @@
 #ifndef GZ_RENDERING_BASE_BASERENDERENGINE_HH_
 #define GZ_RENDERING_BASE_BASERENDERENGINE_HH_
 
+#include <chrono>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -103,6 +105,9 @@ namespace gz
       // Documentation Inherited
       public: virtual RenderPassSystemPtr RenderPassSystem() const override;
 
+      // Documentation Inherited
+      public: virtual const StartupTimeline &StartupTimings() const override;
+
       protected: virtual void PrepareScene(ScenePtr _scene);
 
       protected: virtual unsigned int NextSceneId();
@@ -114,6 +119,17 @@ namespace gz
 
       protected: virtual bool InitImpl() = 0;
 
+      /// \brief Add a phase to the startup timeline
+      /// \param[in] _name Name of the phase
+      /// \param[in] _start Time the phase started
+      /// \param[in] _resourceCount Number of resources registered during the
+      /// phase
+      /// \param[in] _shaderCount Number of shaders created during the phase
+      protected: void RecordStartupPhase(const std::string &_name,
+                     std::chrono::steady_clock::time_point _start,
+                     uint64_t _resourceCount = 0u,
+                     uint64_t _shaderCount = 0u);
+
       protected: virtual ScenePtr CreateSceneImpl(unsigned int _id,
                   const std::string &_name) = 0;
 
@@ -130,6 +146,9 @@ namespace gz
 
       protected: unsigned int nextSceneId;
 
+      /// \brief Time the engine started loading, start of the timeline
+      protected: std::chrono::steady_clock::time_point startupBegin;
+
       GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
       /// \brief a list of paths that render engines use to locate their
       /// resources
@@ -137,6 +156,13 @@ namespace gz
 
       /// \brief Render pass system for this render engine.
       protected: RenderPassSystemPtr renderPassSystem;
+
+      /// \brief Phases of loading and initializing the engine
+      protected: StartupTimeline startupTimeline;
+
+      /// \brief File the startup timeline is written to as a Chrome trace,
+      /// empty if disabled
+      protected: std::string startupTracePath;
       GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
     };
     }
@@ -18,8 +18,13 @@
 #define GZ_RENDERING_BASE_BASESCENE_HH_
 
 #include <array>
+#include <chrono>
+#include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <gz/common/Console.hh>
 #include <gz/utils/SuppressWarning.hh>
@@ -401,6 +406,11 @@ namespace gz
       public: virtual VisualPtr CreateVisual(unsigned int _id,
                   const std::string &_name) override;
 
+      // Documentation inherited.
+      public: virtual std::vector<VisualPtr> CreateVisuals(
+                  const std::vector<VisualDescriptor> &_batch,
+                  VisualPtr _parent = nullptr) override;
+
       public: virtual ArrowVisualPtr CreateArrowVisual() override;
 
       public: virtual ArrowVisualPtr CreateArrowVisual(unsigned int _id)
@@ -552,6 +562,11 @@ namespace gz
       public: virtual FrustumVisualPtr CreateFrustumVisual(unsigned int _id,
                                             const std::string &_name) override;
 
+      // Documentation inherited.
+      public: virtual InstancedVisualPtr CreateInstancedVisual(
+                  const MeshDescriptor &_desc, MaterialPtr _material,
+                  unsigned int _capacity) override;
+
       // Documentation inherited.
       public: virtual HeightmapPtr CreateHeightmap(
           const HeightmapDescriptor &_desc) override;
@@ -634,6 +649,94 @@ namespace gz
       // Documentation inherited.
       public: virtual bool LegacyAutoGpuFlush() const override;
 
+      // Documentation inherited.
+      public: virtual void SetObjectPoolingEnabled(bool _enabled) override;
+
+      // Documentation inherited.
+      public: virtual bool ObjectPoolingEnabled() const override;
+
+      // Documentation inherited.
+      public: virtual void SetMeshLodEnabled(bool _enabled) override;
+
+      // Documentation inherited.
+      public: virtual bool MeshLodEnabled() const override;
+
+      // Documentation inherited.
+      public: virtual void SetMeshQuantizationEnabled(bool _enabled)
+                  override;
+
+      // Documentation inherited.
+      public: virtual bool MeshQuantizationEnabled() const override;
+
+      // Documentation inherited.
+      public: virtual unsigned int BuildStaticBatches(
+                  double _cellSize = 10.0) override;
+
+      // Documentation inherited.
+      public: virtual void ClearStaticBatches() override;
+
+      // Documentation inherited.
+      public: virtual unsigned int StaticBatchCount() const override;
+
+      // Documentation inherited.
+      public: virtual AsyncAssetPtr LoadMeshAsync(
+                  const MeshDescriptor &_desc) override;
+
+      // Documentation inherited.
+      public: virtual AsyncAssetPtr LoadTextureAsync(
+                  const std::string &_texture) override;
+
+      // Documentation inherited.
+      public: virtual bool WaitForAssets(
+                  const std::vector<AsyncAssetPtr> &_assets) override;
+
+      // Documentation inherited.
+      public: virtual void SetAssetUploadBudget(
+                  std::chrono::steady_clock::duration _budget) override;
+
+      // Documentation inherited.
+      public: virtual std::chrono::steady_clock::duration
+                  AssetUploadBudget() const override;
+
+      // Documentation inherited.
+      public: virtual unsigned int WarmUp(
+                  const WarmUpOptions &_options = WarmUpOptions()) override;
+
+      // Documentation inherited.
+      public: virtual void SetChangeJournalEnabled(bool _enabled) override;
+
+      // Documentation inherited.
+      public: virtual bool ChangeJournalEnabled() const override;
+
+      // Documentation inherited.
+      public: virtual std::vector<SceneChange> DrainChanges() override;
+
+      // Documentation inherited.
+      public: virtual void RecordChange(const SceneChange &_change) override;
+
+      // Documentation inherited.
+      public: virtual unsigned int InternAttribute(const std::string &_key,
+                  NodeAttributeType _type) override;
+
+      // Documentation inherited.
+      public: virtual unsigned int AttributeHandle(
+                  const std::string &_key) const override;
+
+      // Documentation inherited.
+      public: virtual bool FloatAttribute(unsigned int _handle,
+                  unsigned int _nodeId, float &_value) const override;
+
+      // Documentation inherited.
+      public: virtual bool IntAttribute(unsigned int _handle,
+                  unsigned int _nodeId, int &_value) const override;
+
+      // Documentation inherited.
+      public: virtual void SetAttribute(unsigned int _handle,
+                  unsigned int _nodeId, const Variant &_value) override;
+
+      // Documentation inherited.
+      public: virtual void RemoveAttributes(unsigned int _nodeId) override;
+
       protected: virtual unsigned int CreateObjectId();
 
       protected: virtual std::string CreateObjectName(unsigned int _id,
@@ -810,6 +913,29 @@ namespace gz
       protected: virtual FrustumVisualPtr CreateFrustumVisualImpl(unsigned int _id,
                      const std::string &_name) = 0;
 
+      /// \brief Implementation for creating an instanced visual
+      /// \param[in] _id Unique object id.
+      /// \param[in] _name Unique object name.
+      /// \param[in] _desc Mesh of each instance.
+      /// \param[in] _material Material of each instance.
+      /// \param[in] _capacity Number of instances.
+      /// \return Pointer to an instanced visual.
+      protected: virtual InstancedVisualPtr CreateInstancedVisualImpl(
+                     unsigned int _id, const std::string &_name,
+                     const MeshDescriptor &_desc, MaterialPtr _material,
+                     unsigned int _capacity)
+                 {
+                   // The following lines will avoid doxygen warnings
+                   (void)_id;
+                   (void)_name;
+                   (void)_desc;
+                   (void)_material;
+                   (void)_capacity;
+                   gzerr << "Instanced visual not supported by: "
+                          << this->Engine()->Name() << std::endl;
+                   return InstancedVisualPtr();
+                 }
+
       /// \brief Implementation for creating a heightmap geometry
       /// \param[in] _id Unique object id.
       /// \param[in] _name Unique object name.
@@ -903,6 +1029,15 @@ namespace gz
       private: void DestroyNodeRecursive(NodePtr _node,
           std::set<unsigned int> &_nodeIds);
 
+      /// \brief Create the render engine resources of decoded assets
+      /// \param[in] _budget Time to spend uploading. At least one asset is
+      /// uploaded if any is decoded.
+      private: void UploadAssets(std::chrono::steady_clock::duration _budget);
+
+      /// \brief Create the render engine resources of a decoded asset
+      /// \param[in] _asset Decoded asset
+      private: void UploadAsset(const AsyncAssetPtr &_asset);
+
       protected: unsigned int id;
 
       GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
@@ -939,6 +1074,61 @@ namespace gz
       GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
       private: NodeStorePtr nodes;
       GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+
+      /// \brief True if scene changes are recorded in the change journal
+      private: bool changeJournalEnabled = false;
+
+      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Changes recorded since the journal was last drained
+      private: std::vector<SceneChange> changes;
+
+      /// \brief Pose, material and visibility changes recorded since the
+      /// journal was last drained. Used to record repeated changes of the
+      /// same node only once.
+      private: std::set<std::pair<SceneChangeType, unsigned int>>
+          pendingChanges;
+
+      /// \brief Dense storage of an interned node attribute. Values are
+      /// packed in the vector matching the attribute type, parallel to
+      /// nodeIds.
+      private: struct AttributeColumn
+      {
+        /// \brief Type of the attribute values
+        NodeAttributeType type = NodeAttributeType::FLOAT;
+
+        /// \brief Ids of the nodes that have a value
+        std::vector<unsigned int> nodeIds;
+
+        /// \brief Values of FLOAT attributes
+        std::vector<float> floatValues;
+
+        /// \brief Values of INT attributes
+        std::vector<int> intValues;
+
+        /// \brief Map of node id to index in the packed vectors
+        std::unordered_map<unsigned int, std::size_t> slots;
+      };
+
+      /// \brief Remove the value of a node from an attribute column
+      /// \param[in] _column Attribute column
+      /// \param[in] _nodeId Id of the node
+      private: static void RemoveAttributeValue(AttributeColumn &_column,
+                  unsigned int _nodeId);
+
+      /// \brief Map of interned user data keys to attribute handles
+      private: std::unordered_map<std::string, unsigned int> attributeHandles;
+
+      /// \brief Attribute columns, indexed by handle - 1
+      private: std::vector<AttributeColumn> attributes;
+
+      /// \brief Queues the assets of the scene decoded in the background by
+      /// the worker threads shared between scenes, created on first use
+      private: std::unique_ptr<AsyncAssetLoader> assetLoader;
+
+      /// \brief Time PreRender may spend uploading decoded assets
+      private: std::chrono::steady_clock::duration assetUploadBudget =
+          std::chrono::milliseconds(4);
+      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
     };
     }
   }
@@ -17,6 +17,8 @@
 #ifndef GZ_RENDERING_BASE_BASESENSOR_HH_
 #define GZ_RENDERING_BASE_BASESENSOR_HH_
 
+#include <gz/common/Console.hh>
+
 #include "gz/rendering/Sensor.hh"
 
 namespace gz
@@ -40,8 +42,17 @@ namespace gz
       // Documentation inherited.
       public: virtual uint32_t VisibilityMask() const override;
 
+      // Documentation inherited.
+      public: virtual void SetLodBias(double _bias) override;
+
+      // Documentation inherited.
+      public: virtual double LodBias() const override;
+
       /// \brief Camera's visibility mask
       protected: uint32_t visibilityMask = GZ_VISIBILITY_ALL;
+
+      /// \brief Level of detail bias
+      protected: double lodBias = 1.0;
     };
 
     //////////////////////////////////////////////////
@@ -69,6 +80,26 @@ namespace gz
     {
       return this->visibilityMask;
     }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseSensor<T>::SetLodBias(double _bias)
+    {
+      if (!(_bias > 0.0))
+      {
+        gzerr << "LOD bias must be positive, got [" << _bias << "]"
+              << std::endl;
+        return;
+      }
+      this->lodBias = _bias;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    double BaseSensor<T>::LodBias() const
+    {
+      return this->lodBias;
+    }
     }
   }
 }
@@ -17,9 +17,13 @@
 #ifndef GZ_RENDERING_BASE_BASESTORAGE_HH_
 #define GZ_RENDERING_BASE_BASESTORAGE_HH_
 
+#include <algorithm>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <gz/common/Console.hh>
@@ -84,7 +88,190 @@ namespace gz
     };
 
     //////////////////////////////////////////////////
-    template <class T, class U>
+    /// \brief Name and value pair of a CompactNameMap. The value can be
+    /// replaced through a const reference, the name can't, like the key of
+    /// a std::map entry.
+    template <class V>
+    class CompactNameMapEntry
+    {
+      /// \brief Name of the entry
+      public: std::string first;
+
+      /// \brief Value of the entry
+      public: mutable V second;
+    };
+
+    //////////////////////////////////////////////////
+    /// \brief Compact name-keyed container for small per-object stores,
+    /// such as the children of a node or the geometries of a visual. Most
+    /// nodes have few children, so entries live in a single vector kept
+    /// sorted by name, an empty container allocates nothing and name
+    /// lookups are a binary search. Once a container grows past
+    /// SmallSize entries, e.g. the root visual of a large scene, the
+    /// entries move to a tree, so inserting and erasing stay logarithmic.
+    /// Iteration and index order match std::map in both cases.
+    template <class V>
+    class CompactNameMap
+    {
+      /// \brief Name and value pair
+      public: typedef CompactNameMapEntry<V> value_type;
+
+      /// \brief Maximum number of entries kept in the sorted vector
+      public: static constexpr std::size_t SmallSize = 16u;
+
+      /// \brief Orders entries and names, allowing lookups by name
+      private: class EntryLess
+      {
+        /// \brief Allow heterogeneous lookups
+        public: typedef void is_transparent;
+
+        /// \brief Compare two entries
+        public: bool operator()(const value_type &_a,
+            const value_type &_b) const;
+
+        /// \brief Compare an entry with a name
+        public: bool operator()(const value_type &_a,
+            const std::string &_b) const;
+
+        /// \brief Compare a name with an entry
+        public: bool operator()(const std::string &_a,
+            const value_type &_b) const;
+      };
+
+      /// \brief Sorted vector storage of small containers
+      private: typedef std::vector<value_type> Entries;
+
+      /// \brief Tree storage of large containers
+      private: typedef std::set<value_type, EntryLess> Index;
+
+      /// \brief Bidirectional iterator over the entries of either storage.
+      /// Inserting an entry may move all entries to the tree, which
+      /// invalidates every iterator.
+      public: class iterator
+      {
+        /// \brief Iterator category
+        public: typedef std::bidirectional_iterator_tag iterator_category;
+
+        /// \brief Entry type
+        public: typedef CompactNameMapEntry<V> value_type;
+
+        /// \brief Distance type
+        public: typedef std::ptrdiff_t difference_type;
+
+        /// \brief Entry pointer type
+        public: typedef const value_type *pointer;
+
+        /// \brief Entry reference type
+        public: typedef const value_type &reference;
+
+        /// \brief Dereference the iterator
+        /// \return Current entry
+        public: reference operator*() const;
+
+        /// \brief Access the current entry
+        /// \return Pointer to the current entry
+        public: pointer operator->() const;
+
+        /// \brief Move to the next entry
+        /// \return This iterator
+        public: iterator &operator++();
+
+        /// \brief Move to the next entry
+        /// \return Iterator to the entry before moving
+        public: iterator operator++(int);
+
+        /// \brief Move to the previous entry
+        /// \return This iterator
+        public: iterator &operator--();
+
+        /// \brief Move to the previous entry
+        /// \return Iterator to the entry before moving
+        public: iterator operator--(int);
+
+        /// \brief Check if two iterators point to the same entry
+        /// \param[in] _other Iterator to compare with
+        /// \return True if both point to the same entry
+        public: bool operator==(const iterator &_other) const;
+
+        /// \brief Check if two iterators point to different entries
+        /// \param[in] _other Iterator to compare with
+        /// \return True if they point to different entries
+        public: bool operator!=(const iterator &_other) const;
+
+        /// \brief Position in the sorted vector
+        private: typename Entries::const_iterator small;
+
+        /// \brief Position in the tree
+        private: typename Index::const_iterator large;
+
+        /// \brief True if the iterator points into the tree
+        private: bool isLarge = false;
+
+        /// \brief The container creates the iterators
+        private: friend class CompactNameMap;
+      };
+
+      /// \brief Const iterator, entry values can be replaced through either
+      public: typedef iterator const_iterator;
+
+      /// \brief Return an iterator to the first entry
+      /// \return Iterator to the first entry
+      public: iterator begin() const;
+
+      /// \brief Return an iterator past the last entry
+      /// \return Iterator past the last entry
+      public: iterator end() const;
+
+      /// \brief Get the number of entries
+      /// \return Number of entries
+      public: std::size_t size() const;
+
+      /// \brief Remove all entries and release the storage
+      public: void clear();
+
+      /// \brief Find the entry with the given name
+      /// \param[in] _name Name to look up
+      /// \return Iterator to the entry, or end() if not found
+      public: iterator find(const std::string &_name) const;
+
+      /// \brief Get the value with the given name, inserting a default
+      /// value in sorted position if it does not exist yet
+      /// \param[in] _name Name of the entry
+      /// \return Reference to the value
+      public: V &operator[](const std::string &_name);
+
+      /// \brief Remove a single entry
+      /// \param[in] _iter Entry to remove
+      /// \return Iterator following the removed entry
+      public: iterator erase(const_iterator _iter);
+
+      /// \brief Remove a range of entries
+      /// \param[in] _first First entry to remove
+      /// \param[in] _last Entry following the last one to remove
+      /// \return Iterator following the removed range
+      public: iterator erase(const_iterator _first, const_iterator _last);
+
+      /// \brief Get an iterator into the sorted vector
+      /// \param[in] _iter Vector position
+      /// \return Iterator
+      private: static iterator SmallIter(
+          typename Entries::const_iterator _iter);
+
+      /// \brief Get an iterator into the tree
+      /// \param[in] _iter Tree position
+      /// \return Iterator
+      private: static iterator LargeIter(typename Index::const_iterator _iter);
+
+      /// \brief Entries sorted by name, while there are at most SmallSize
+      private: Entries entries;
+
+      /// \brief Entries of large containers, null while they are small
+      private: std::unique_ptr<Index> index;
+    };
+
+    //////////////////////////////////////////////////
+    template <class T, class U,
+              class S = std::map<std::string, std::shared_ptr<U>>>
     class BaseStore :
       public Store<T>
     {
@@ -94,7 +281,7 @@ namespace gz
 
       typedef std::shared_ptr<U> UPtr;
 
-      typedef std::map<std::string, UPtr> UStore;
+      typedef S UStore;
 
       typedef typename UStore::iterator UIter;
 
@@ -346,7 +533,7 @@ namespace gz
 
     template <class T>
     class  BaseNodeStore :
-      public BaseStore<Node, T>
+      public BaseStore<Node, T, CompactNameMap<std::shared_ptr<T>>>
     {
     };
 
@@ -370,7 +557,7 @@ namespace gz
 
     template <class T>
     class  BaseGeometryStore :
-      public BaseStore<Geometry, T>
+      public BaseStore<Geometry, T, CompactNameMap<std::shared_ptr<T>>>
     {
     };
 
@@ -546,91 +733,319 @@ namespace gz
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    BaseStore<T, U>::BaseStore()
+    template <class V>
+    bool CompactNameMap<V>::EntryLess::operator()(const value_type &_a,
+        const value_type &_b) const
     {
+      return _a.first < _b.first;
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    BaseStore<T, U>::~BaseStore()
+    template <class V>
+    bool CompactNameMap<V>::EntryLess::operator()(const value_type &_a,
+        const std::string &_b) const
     {
+      return _a.first < _b;
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    unsigned int BaseStore<T, U>::Size() const
+    template <class V>
+    bool CompactNameMap<V>::EntryLess::operator()(const std::string &_a,
+        const value_type &_b) const
+    {
+      return _a < _b.first;
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    typename CompactNameMap<V>::iterator::reference
+    CompactNameMap<V>::iterator::operator*() const
+    {
+      return this->isLarge ? *this->large : *this->small;
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    typename CompactNameMap<V>::iterator::pointer
+    CompactNameMap<V>::iterator::operator->() const
+    {
+      return &**this;
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    typename CompactNameMap<V>::iterator &
+    CompactNameMap<V>::iterator::operator++()
+    {
+      if (this->isLarge)
+        ++this->large;
+      else
+        ++this->small;
+      return *this;
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    typename CompactNameMap<V>::iterator
+    CompactNameMap<V>::iterator::operator++(int)
+    {
+      iterator result = *this;
+      ++(*this);
+      return result;
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    typename CompactNameMap<V>::iterator &
+    CompactNameMap<V>::iterator::operator--()
+    {
+      if (this->isLarge)
+        --this->large;
+      else
+        --this->small;
+      return *this;
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    typename CompactNameMap<V>::iterator
+    CompactNameMap<V>::iterator::operator--(int)
+    {
+      iterator result = *this;
+      --(*this);
+      return result;
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    bool CompactNameMap<V>::iterator::operator==(const iterator &_other) const
+    {
+      if (this->isLarge != _other.isLarge)
+        return false;
+      return this->isLarge ? this->large == _other.large :
+          this->small == _other.small;
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    bool CompactNameMap<V>::iterator::operator!=(const iterator &_other) const
+    {
+      return !(*this == _other);
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    typename CompactNameMap<V>::iterator CompactNameMap<V>::SmallIter(
+        typename Entries::const_iterator _iter)
+    {
+      iterator result;
+      result.small = _iter;
+      return result;
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    typename CompactNameMap<V>::iterator CompactNameMap<V>::LargeIter(
+        typename Index::const_iterator _iter)
+    {
+      iterator result;
+      result.large = _iter;
+      result.isLarge = true;
+      return result;
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    typename CompactNameMap<V>::iterator CompactNameMap<V>::begin() const
+    {
+      return this->index ? LargeIter(this->index->begin()) :
+          SmallIter(this->entries.begin());
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    typename CompactNameMap<V>::iterator CompactNameMap<V>::end() const
+    {
+      return this->index ? LargeIter(this->index->end()) :
+          SmallIter(this->entries.end());
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    std::size_t CompactNameMap<V>::size() const
+    {
+      return this->index ? this->index->size() : this->entries.size();
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    void CompactNameMap<V>::clear()
+    {
+      Entries().swap(this->entries);
+      this->index.reset();
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    typename CompactNameMap<V>::iterator
+    CompactNameMap<V>::find(const std::string &_name) const
+    {
+      if (this->index)
+        return LargeIter(this->index->find(_name));
+
+      auto iter = std::lower_bound(this->entries.begin(), this->entries.end(),
+          _name, EntryLess());
+      return SmallIter((iter != this->entries.end() && iter->first == _name) ?
+          iter : this->entries.end());
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    V &CompactNameMap<V>::operator[](const std::string &_name)
+    {
+      if (!this->index)
+      {
+        auto iter = std::lower_bound(this->entries.begin(),
+            this->entries.end(), _name, EntryLess());
+        if (iter != this->entries.end() && iter->first == _name)
+          return iter->second;
+
+        if (this->entries.size() < SmallSize)
+          return this->entries.insert(iter, value_type{_name, V()})->second;
+
+        // too large to shift entries on every insertion, move them to a
+        // tree. They are already sorted, so each is inserted at the end.
+        this->index = std::make_unique<Index>();
+        for (auto &entry : this->entries)
+          this->index->insert(this->index->end(), std::move(entry));
+        Entries().swap(this->entries);
+      }
+
+      return this->index->insert(value_type{_name, V()}).first->second;
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    typename CompactNameMap<V>::iterator
+    CompactNameMap<V>::erase(const_iterator _iter)
+    {
+      if (!_iter.isLarge)
+        return SmallIter(this->entries.erase(_iter.small));
+
+      auto next = this->index->erase(_iter.large);
+      if (!this->index->empty())
+        return LargeIter(next);
+
+      // an emptied container goes back to the vector
+      this->index.reset();
+      return this->end();
+    }
+
+    //////////////////////////////////////////////////
+    template <class V>
+    typename CompactNameMap<V>::iterator
+    CompactNameMap<V>::erase(const_iterator _first, const_iterator _last)
+    {
+      if (_first == _last)
+        return _first;
+
+      if (!_first.isLarge)
+        return SmallIter(this->entries.erase(_first.small, _last.small));
+
+      auto next = this->index->erase(_first.large, _last.large);
+      if (!this->index->empty())
+        return LargeIter(next);
+
+      this->index.reset();
+      return this->end();
+    }
+
+    //////////////////////////////////////////////////
+    template <class T, class U, class S>
+    BaseStore<T, U, S>::BaseStore()
+    {
+    }
+
+    //////////////////////////////////////////////////
+    template <class T, class U, class S>
+    BaseStore<T, U, S>::~BaseStore()
+    {
+    }
+
+    //////////////////////////////////////////////////
+    template <class T, class U, class S>
+    unsigned int BaseStore<T, U, S>::Size() const
     {
       return this->store.size();
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UIter
-    BaseStore<T, U>::Begin()
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UIter
+    BaseStore<T, U, S>::Begin()
     {
       return this->store.begin();
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UIter
-    BaseStore<T, U>::End()
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UIter
+    BaseStore<T, U, S>::End()
     {
       return this->store.end();
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    bool BaseStore<T, U>::Contains(ConstTPtr _object) const
+    template <class T, class U, class S>
+    bool BaseStore<T, U, S>::Contains(ConstTPtr _object) const
     {
       auto iter = this->ConstIter(_object);
       return this->IsValidIter(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    bool BaseStore<T, U>::ContainsId(unsigned int _id) const
+    template <class T, class U, class S>
+    bool BaseStore<T, U, S>::ContainsId(unsigned int _id) const
     {
       auto iter = this->ConstIterById(_id);
       return this->IsValidIter(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    bool BaseStore<T, U>::ContainsName(const std::string &_name) const
+    template <class T, class U, class S>
+    bool BaseStore<T, U, S>::ContainsName(const std::string &_name) const
     {
       auto iter = this->ConstIterByName(_name);
       return this->IsValidIter(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::TPtr
-    BaseStore<T, U>::GetById(unsigned int _id) const
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::TPtr
+    BaseStore<T, U, S>::GetById(unsigned int _id) const
     {
       return this->DerivedById(_id);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::TPtr
-    BaseStore<T, U>::GetByName(const std::string &_name) const
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::TPtr
+    BaseStore<T, U, S>::GetByName(const std::string &_name) const
     {
       return this->DerivedByName(_name);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::TPtr
-    BaseStore<T, U>::GetByIndex(unsigned int _index) const
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::TPtr
+    BaseStore<T, U, S>::GetByIndex(unsigned int _index) const
     {
       return this->DerivedByIndex(_index);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    bool BaseStore<T, U>::Add(TPtr _object)
+    template <class T, class U, class S>
+    bool BaseStore<T, U, S>::Add(TPtr _object)
     {
       if (!_object)
       {
@@ -652,80 +1067,80 @@ namespace gz
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::TPtr
-    BaseStore<T, U>::Remove(TPtr _object)
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::TPtr
+    BaseStore<T, U, S>::Remove(TPtr _object)
     {
       auto iter = this->Iter(_object);
       return this->RemoveImpl(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::TPtr
-    BaseStore<T, U>::RemoveById(unsigned int _id)
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::TPtr
+    BaseStore<T, U, S>::RemoveById(unsigned int _id)
     {
       return this->RemoveDerivedById(_id);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::TPtr
-    BaseStore<T, U>::RemoveByName(const std::string &_name)
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::TPtr
+    BaseStore<T, U, S>::RemoveByName(const std::string &_name)
     {
       return this->RemoveDerivedByName(_name);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::TPtr
-    BaseStore<T, U>::RemoveByIndex(unsigned int _index)
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::TPtr
+    BaseStore<T, U, S>::RemoveByIndex(unsigned int _index)
     {
       return this->RemoveDerivedByIndex(_index);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    void BaseStore<T, U>::RemoveAll()
+    template <class T, class U, class S>
+    void BaseStore<T, U, S>::RemoveAll()
     {
       this->store.clear();
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    void BaseStore<T, U>::Destroy(TPtr _object)
+    template <class T, class U, class S>
+    void BaseStore<T, U, S>::Destroy(TPtr _object)
     {
       auto iter = this->Iter(_object);
       this->DestroyImpl(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    void BaseStore<T, U>::DestroyById(unsigned int _id)
+    template <class T, class U, class S>
+    void BaseStore<T, U, S>::DestroyById(unsigned int _id)
     {
       auto iter = this->IterById(_id);
       this->DestroyImpl(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    void BaseStore<T, U>::DestroyByName(const std::string &_name)
+    template <class T, class U, class S>
+    void BaseStore<T, U, S>::DestroyByName(const std::string &_name)
     {
       auto iter = this->IterByName(_name);
       this->DestroyImpl(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    void BaseStore<T, U>::DestroyByIndex(unsigned int _index)
+    template <class T, class U, class S>
+    void BaseStore<T, U, S>::DestroyByIndex(unsigned int _index)
     {
       auto iter = this->IterByIndex(_index);
       this->DestroyImpl(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    void BaseStore<T, U>::DestroyAll()
+    template <class T, class U, class S>
+    void BaseStore<T, U, S>::DestroyAll()
     {
       unsigned int i = this->Size();
 
@@ -736,35 +1151,35 @@ namespace gz
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UPtr
-    BaseStore<T, U>::DerivedById(unsigned int _id) const
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UPtr
+    BaseStore<T, U, S>::DerivedById(unsigned int _id) const
     {
       auto iter = this->ConstIterById(_id);
       return (this->IsValidIter(iter)) ? iter->second : nullptr;
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UPtr
-    BaseStore<T, U>::DerivedByName(const std::string &_name) const
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UPtr
+    BaseStore<T, U, S>::DerivedByName(const std::string &_name) const
     {
       auto iter = this->ConstIterByName(_name);
       return (this->IsValidIter(iter)) ? iter->second : nullptr;
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UPtr
-    BaseStore<T, U>::DerivedByIndex(unsigned int _index) const
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UPtr
+    BaseStore<T, U, S>::DerivedByIndex(unsigned int _index) const
     {
       auto iter = this->ConstIterByIndex(_index);
       return (this->IsValidIter(iter)) ? iter->second : nullptr;
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    bool BaseStore<T, U>::AddDerived(UPtr _object)
+    template <class T, class U, class S>
+    bool BaseStore<T, U, S>::AddDerived(UPtr _object)
     {
       if (!_object)
       {
@@ -776,45 +1191,45 @@ namespace gz
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UPtr
-    BaseStore<T, U>::RemoveDerived(UPtr _object)
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UPtr
+    BaseStore<T, U, S>::RemoveDerived(UPtr _object)
     {
       auto iter = this->Iter(_object);
       return this->RemoveImpl(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UPtr
-    BaseStore<T, U>::RemoveDerivedById(unsigned int _id)
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UPtr
+    BaseStore<T, U, S>::RemoveDerivedById(unsigned int _id)
     {
       auto iter = this->IterById(_id);
       return this->RemoveImpl(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UPtr
-    BaseStore<T, U>::RemoveDerivedByName(const std::string &_name)
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UPtr
+    BaseStore<T, U, S>::RemoveDerivedByName(const std::string &_name)
     {
       auto iter = this->IterByName(_name);
       return this->RemoveImpl(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UPtr
-    BaseStore<T, U>::RemoveDerivedByIndex(unsigned int _index)
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UPtr
+    BaseStore<T, U, S>::RemoveDerivedByIndex(unsigned int _index)
     {
       auto iter = this->IterByIndex(_index);
       return this->RemoveImpl(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::ConstUIter
-    BaseStore<T, U>::ConstIter(ConstTPtr _object) const
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::ConstUIter
+    BaseStore<T, U, S>::ConstIter(ConstTPtr _object) const
     {
       auto begin = this->store.begin();
       auto end = this->store.end();
@@ -831,9 +1246,9 @@ namespace gz
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::ConstUIter
-    BaseStore<T, U>::ConstIterById(unsigned int _id) const
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::ConstUIter
+    BaseStore<T, U, S>::ConstIterById(unsigned int _id) const
     {
       auto begin = this->store.begin();
       auto end = this->store.end();
@@ -850,17 +1265,17 @@ namespace gz
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::ConstUIter
-    BaseStore<T, U>::ConstIterByName(const std::string &_name) const
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::ConstUIter
+    BaseStore<T, U, S>::ConstIterByName(const std::string &_name) const
     {
       return this->store.find(_name);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::ConstUIter
-    BaseStore<T, U>::ConstIterByIndex(unsigned int _index) const
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::ConstUIter
+    BaseStore<T, U, S>::ConstIterByIndex(unsigned int _index) const
     {
       if (_index >= this->Size())
       {
@@ -868,50 +1283,60 @@ namespace gz
         return this->store.end();
       }
 
+      // walk from the nearest end, so that removing entries from the back
+      // of a large store, as RemoveAll and DestroyAll do, is cheap
+      const unsigned int size = this->Size();
+      if (_index >= size / 2u)
+      {
+        auto iter = this->store.end();
+        std::advance(iter, -static_cast<std::ptrdiff_t>(size - _index));
+        return iter;
+      }
+
       auto iter = this->store.begin();
       std::advance(iter, _index);
       return iter;
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UIter
-    BaseStore<T, U>::Iter(ConstTPtr _object)
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UIter
+    BaseStore<T, U, S>::Iter(ConstTPtr _object)
     {
       auto iter = this->ConstIter(_object);
       return this->RemoveConstness(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UIter
-    BaseStore<T, U>::IterById(unsigned int _id)
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UIter
+    BaseStore<T, U, S>::IterById(unsigned int _id)
     {
       auto iter = this->ConstIterById(_id);
       return this->RemoveConstness(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UIter
-    BaseStore<T, U>::IterByName(const std::string &_name)
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UIter
+    BaseStore<T, U, S>::IterByName(const std::string &_name)
     {
       auto iter = this->ConstIterByName(_name);
       return this->RemoveConstness(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UIter
-    BaseStore<T, U>::IterByIndex(unsigned int _index)
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UIter
+    BaseStore<T, U, S>::IterByIndex(unsigned int _index)
     {
       auto iter = this->ConstIterByIndex(_index);
       return this->RemoveConstness(iter);
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    bool BaseStore<T, U>::AddImpl(UPtr _object)
+    template <class T, class U, class S>
+    bool BaseStore<T, U, S>::AddImpl(UPtr _object)
     {
       unsigned int id = _object->Id();
       std::string name = _object->Name();
@@ -934,9 +1359,9 @@ namespace gz
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UPtr
-    BaseStore<T, U>::RemoveImpl(UIter _iter)
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UPtr
+    BaseStore<T, U, S>::RemoveImpl(UIter _iter)
     {
       if (!this->IsValidIter(_iter))
       {
@@ -949,24 +1374,24 @@ namespace gz
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    void BaseStore<T, U>::DestroyImpl(UIter _iter)
+    template <class T, class U, class S>
+    void BaseStore<T, U, S>::DestroyImpl(UIter _iter)
     {
       UPtr result = this->RemoveImpl(_iter);
       if (result) result->Destroy();
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    bool BaseStore<T, U>::IsValidIter(ConstUIter _iter) const
+    template <class T, class U, class S>
+    bool BaseStore<T, U, S>::IsValidIter(ConstUIter _iter) const
     {
       return _iter != this->store.end();
     }
 
     //////////////////////////////////////////////////
-    template <class T, class U>
-    typename BaseStore<T, U>::UIter
-    BaseStore<T, U>::RemoveConstness(ConstUIter _iter)
+    template <class T, class U, class S>
+    typename BaseStore<T, U, S>::UIter
+    BaseStore<T, U, S>::RemoveConstness(ConstUIter _iter)
     {
       return (this->IsValidIter(_iter)) ?
           this->store.erase(_iter, _iter) : this->store.end();
@@ -100,6 +100,12 @@ namespace gz
       // Documentation inherited.
       public: virtual void RemoveVisibilityFlags(uint32_t _flags) override;
 
+      // Documentation inherited.
+      public: virtual void SetStatic(bool _static) override;
+
+      // Documentation inherited.
+      public: virtual bool Static() const override;
+
       // Documentation inherited.
       public: virtual void PreRender() override;
 
@@ -139,6 +145,9 @@ namespace gz
 
       /// \brief True if wireframe mode is enabled else false
       protected: bool wireframe = false;
+
+      /// \brief True if the visual is static
+      protected: bool isStatic = false;
     };
 
     //////////////////////////////////////////////////
@@ -179,6 +188,7 @@ namespace gz
       }
 
       this->SetRawLocalPose(rawPose);
+      this->RecordChange(SceneChangeType::POSE_CHANGED, this->Id());
     }
 
     //////////////////////////////////////////////////
@@ -256,6 +266,7 @@ namespace gz
       this->SetChildMaterial(_material, false);
       this->SetGeometryMaterial(_material, false);
       this->material = _material;
+      this->RecordChange(SceneChangeType::MATERIAL_CHANGED, this->Id());
     }
 
     //////////////////////////////////////////////////
@@ -266,7 +277,7 @@ namespace gz
       _material = (_unique && count > 0) ? _material->Clone() : _material;
 
       auto children_ =
-          std::dynamic_pointer_cast<BaseStore<gz::rendering::Node, T>>(
+          std::dynamic_pointer_cast<BaseNodeStore<T>>(
           this->Children());
       if (!children_)
       {
@@ -326,7 +337,7 @@ namespace gz
     void BaseVisual<T>::PreRenderChildren()
     {
       auto children_ =
-          std::dynamic_pointer_cast<BaseStore<gz::rendering::Node, T>>(
+          std::dynamic_pointer_cast<BaseNodeStore<T>>(
           this->Children());
       if (!children_)
       {
@@ -385,7 +396,7 @@ namespace gz
 
       // Recursively loop through child visuals
       auto childNodes =
-          std::dynamic_pointer_cast<BaseStore<gz::rendering::Node, T>>(
+          std::dynamic_pointer_cast<BaseNodeStore<T>>(
           this->Children());
       if (!childNodes)
       {
@@ -414,7 +425,7 @@ namespace gz
 
       // Recursively loop through child visuals
       auto childNodes =
-          std::dynamic_pointer_cast<BaseStore<gz::rendering::Node, T>>(
+          std::dynamic_pointer_cast<BaseNodeStore<T>>(
           this->Children());
       if (!childNodes)
       {
@@ -445,6 +456,20 @@ namespace gz
       this->SetVisibilityFlags(this->VisibilityFlags() & ~(_flags));
     }
 
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseVisual<T>::SetStatic(bool _static)
+    {
+      this->isStatic = _static;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseVisual<T>::Static() const
+    {
+      return this->isStatic;
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseVisual<T>::SetVisibilityFlags(uint32_t _flags)
@@ -453,7 +478,7 @@ namespace gz
 
       // recursively set child visuals' visibility flags
       auto childNodes =
-          std::dynamic_pointer_cast<BaseStore<gz::rendering::Node, T>>(
+          std::dynamic_pointer_cast<BaseNodeStore<T>>(
           this->Children());
       if (!childNodes)
       {
@@ -513,10 +538,11 @@ namespace gz
       result->SetLocalPose(this->LocalPose());
       result->SetVisibilityFlags(this->VisibilityFlags());
       result->SetWireframe(this->Wireframe());
+      result->SetStatic(this->Static());
 
       // if the visual that was cloned has child visuals, clone those as well
       auto children_ =
-          std::dynamic_pointer_cast<BaseStore<gz::rendering::Node, T>>(
+          std::dynamic_pointer_cast<BaseNodeStore<T>>(
           this->Children());
       if (!children_)
       {
@@ -99,4 +99,5 @@ void OgreFrustumVisual::SetVisible(bool _visible)
 {
   this->dataPtr->visible = _visible;
   this->ogreNode->setVisible(this->dataPtr->visible);
+  this->RecordChange(SceneChangeType::VISIBILITY_CHANGED, this->Id());
 }
@@ -519,4 +519,5 @@ void OgreLidarVisual::SetVisible(bool _visible)
 {
   this->dataPtr->visible = _visible;
   this->ogreNode->setVisible(this->dataPtr->visible);
+  this->RecordChange(SceneChangeType::VISIBILITY_CHANGED, this->Id());
 }
@@ -107,6 +107,7 @@ void OgreVisual::SetVisible(bool _visible)
     return;
 
   this->ogreNode->setVisible(_visible);
+  this->RecordChange(SceneChangeType::VISIBILITY_CHANGED, this->Id());
 }
 
 //////////////////////////////////////////////////
@@ -115,6 +115,11 @@ namespace gz
       public: virtual VisualPtr VisualAt(const gz::math::Vector2i
                   &_mousePos) override;
 
+      // Documentation inherited
+      public: virtual VisualPtr VisualInstanceAt(
+                  const gz::math::Vector2i &_mousePos,
+                  unsigned int &_instanceIndex) override;
+
       // Documentation Inherited.
       // \sa Camera::SetMaterial(const MaterialPtr &)
       public: virtual void SetMaterial(
@@ -163,10 +168,8 @@ namespace gz
       /// \brief Create internal camera object
       private: void CreateCamera();
 
-      /// \brief Notifies us that the shadow node definition is about to be
-      /// updated. This means our compositor workspace must be destroyed
-      /// because the shadow node definition it's using will become a
-      /// dangling pointer otherwise
+      /// \brief Notifies us that the scene switched to another shadow node
+      /// definition. Our compositor workspace is updated in place to use it.
       /// \sa SetShadowsDirty
       private: void SetShadowsNodeDefDirty();
 
@@ -146,10 +146,8 @@ namespace gz
       /// \brief Create the camera.
       protected: void CreateCamera();
 
-      /// \brief Notifies us that the shadow node definition is about to be
-      /// updated. This means our compositor workspace must be destroyed
-      /// because the shadow node definition it's using will become a
-      /// dangling pointer otherwise
+      /// \brief Notifies us that the scene switched to another shadow node
+      /// definition. Our compositor workspace is updated in place to use it.
       /// \sa SetShadowsDirty
       private: void SetShadowsNodeDefDirty();
 
@@ -18,8 +18,11 @@
 #ifndef GZ_RENDERING_OGRE2_OGRE2HEIGHTMAP_HH_
 #define GZ_RENDERING_OGRE2_OGRE2HEIGHTMAP_HH_
 
+#include <cstddef>
 #include <memory>
 
+#include <gz/math/Vector3.hh>
+
 #include "gz/rendering/base/BaseHeightmap.hh"
 #include "gz/rendering/ogre2/Ogre2Geometry.hh"
 
@@ -35,6 +38,7 @@ namespace Ogre
 {
   class Camera;
   class Terra;
+  class Vector4;
 }
 
 namespace gz
@@ -65,7 +69,8 @@ namespace gz
       public: virtual void PreRender() override;
 
       /// \brief Returns the Terra pointer as it is a movable object that
-      /// must be attached to a regular SceneNode
+      /// must be attached to a regular SceneNode. Tiled heightmaps return
+      /// an empty object whose SceneNode the tiles are attached to.
       /// \remarks This behavior is different from ogre1
       /// \return Terra pointer
       public: virtual Ogre::MovableObject *OgreObject() const override;
@@ -83,17 +88,46 @@ namespace gz
           override;
 
       /// \internal
-      /// \brief Retrieves the internal Terra pointer
-      /// \return internal Terra pointer
+      /// \brief Retrieves the internal Terra pointer. For tiled heightmaps
+      /// this is the loaded tile closest to the last camera.
+      /// \return internal Terra pointer, null if no tile is loaded
       public: Ogre::Terra* Terra();
 
+      /// \internal
+      /// \brief Set a solid color on all the loaded Terras, see
+      /// Ogre::Terra::SetSolidColor
+      /// \param[in] _idx Index of the solid color
+      /// \param[in] _solidColor Color value
+      public: void SetSolidColor(size_t _idx,
+                  const Ogre::Vector4 &_solidColor);
+
+      /// \internal
+      /// \brief Unset the solid colors of all the loaded Terras
+      public: void UnsetSolidColors();
+
+      /// \internal
+      /// \brief Intersect a ray with the heightmap on the CPU, using its
+      /// height data instead of rendering it
+      /// \param[in] _origin Origin of the ray, in world coordinates
+      /// \param[in] _direction Direction of the ray, in world coordinates
+      /// \param[out] _t Ray parameter of the closest intersection, i.e. the
+      /// point is _origin + _direction * _t
+      /// \return True if the ray hits the heightmap in front of its origin
+      public: bool Intersect(const math::Vector3d &_origin,
+                  const math::Vector3d &_direction, double &_t);
+
       /// \internal
       /// \brief Must be called before rendering with the camera
       /// that will perform rendering.
       ///
-      /// May update shadows if light direction changed
+      /// May update shadows if light direction changed. Terras farther than
+      /// the far clip distance of the camera are not updated.
       /// \param[in] _activeCamera Camera about to be used for rendering
-      public: void UpdateForRender(Ogre::Camera *_activeCamera);
+      /// \param[in] _allDirections True to select the cells of all the
+      /// directions around the camera position, e.g. for the faces of a
+      /// cube map, instead of only the cells in the camera frustum
+      public: void UpdateForRender(Ogre::Camera *_activeCamera,
+                  bool _allDirections = false);
 
       // Documentation inherited.
       // \todo(iche033) rename this to Destroy and
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2INSTANCEDVISUAL_HH_
+#define GZ_RENDERING_OGRE2_OGRE2INSTANCEDVISUAL_HH_
+
+#include <memory>
+
+#include "gz/rendering/MeshDescriptor.hh"
+#include "gz/rendering/base/BaseInstancedVisual.hh"
+#include "gz/rendering/ogre2/Ogre2Visual.hh"
+
+namespace Ogre
+{
+  class MovableObject;
+}
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    // Forward declaration
+    class Ogre2InstancedVisualPrivate;
+
+    /// \brief Ogre 2.x implementation of an instanced visual.
+    ///
+    /// Each instance is a lightweight ogre item and scene node sharing the
+    /// vertex buffers and material of one mesh, without a gz Visual of its
+    /// own. Ogre merges items that share a mesh, material and shader into
+    /// instanced draw calls, so all instances are drawn in a few draw calls
+    /// while still being frustum culled individually.
+    class GZ_RENDERING_OGRE2_VISIBLE Ogre2InstancedVisual :
+      public BaseInstancedVisual<Ogre2Visual>
+    {
+      /// \brief Constructor
+      /// \param[in] _desc Descriptor of the mesh shared by all instances
+      /// \param[in] _material Material of the instances, null to use the
+      /// mesh materials
+      /// \param[in] _capacity Number of instances
+      protected: Ogre2InstancedVisual(const MeshDescriptor &_desc,
+                     MaterialPtr _material, unsigned int _capacity);
+
+      /// \brief Destructor
+      public: virtual ~Ogre2InstancedVisual();
+
+      // Documentation inherited.
+      public: virtual void Init() override;
+
+      // Documentation inherited.
+      public: virtual void PreRender() override;
+
+      // Documentation inherited.
+      public: virtual void Destroy() override;
+
+      // Documentation inherited.
+      public: virtual void SetVisible(bool _visible) override;
+
+      // Documentation inherited.
+      public: virtual void SetVisibilityFlags(uint32_t _flags) override;
+
+      // Documentation inherited.
+      public: virtual math::AxisAlignedBox BoundingBox() const override;
+
+      // Documentation inherited.
+      public: virtual math::AxisAlignedBox LocalBoundingBox() const override;
+
+      /// \internal
+      /// \brief Get the instance index stored in an ogre object created by
+      /// an instanced visual
+      /// \param[in] _object Ogre object, e.g. an item found by a selection
+      /// or segmentation pass
+      /// \param[out] _index Index of the instance
+      /// \return True if the object is an instance of an instanced visual
+      public: static bool InstanceIndex(const Ogre::MovableObject *_object,
+                  unsigned int &_index);
+
+      /// \brief Create the ogre items and nodes of the instances
+      private: void CreateInstances();
+
+      /// \brief Merge the boxes of the visible instances into a box
+      /// \param[in,out] _box Box to merge the instance boxes into
+      /// \param[in] _pose Pose of the visual in the frame of the box
+      private: void InstancesBoundingBox(math::AxisAlignedBox &_box,
+                   const math::Pose3d &_pose) const;
+
+      /// \brief Pointer to private data class
+      private: std::unique_ptr<Ogre2InstancedVisualPrivate> dataPtr;
+
+      /// \brief Only the ogre scene can instantiate this class
+      private: friend class Ogre2Scene;
+    };
+    }
+  }
+}
+#endif
@@ -32,6 +32,14 @@ namespace Ogre
   class Item;
 }
 
+namespace gz
+{
+  namespace common
+  {
+    class SubMesh;
+  }
+}
+
 namespace gz
 {
   namespace rendering
@@ -79,6 +87,27 @@ namespace gz
       /// \param[in] _desc Input mesh descriptor
       protected: virtual bool LoadImpl(const MeshDescriptor &_desc);
 
+      /// \brief Build an ogre v2 mesh directly from the input mesh
+      /// descriptor by filling interleaved VaoManager vertex and index
+      /// buffers. Used for meshes without a skeleton.
+      /// \param[in] _desc Input mesh descriptor
+      /// \return True if the mesh was created
+      protected: virtual bool LoadV2Impl(const MeshDescriptor &_desc);
+
+      /// \brief Build an ogre v1 mesh from the input mesh descriptor. The v1
+      /// mesh is imported to v2 when an item is first created from it.
+      /// Used for skeletal meshes, which are not supported by LoadV2Impl.
+      /// \param[in] _desc Input mesh descriptor
+      /// \return True if the mesh was created
+      protected: virtual bool LoadV1Impl(const MeshDescriptor &_desc);
+
+      /// \brief Create the material of a submesh
+      /// \param[in] _desc Mesh descriptor that owns the submesh
+      /// \param[in] _subMesh Submesh to create the material for
+      /// \return Name of the created material
+      protected: std::string CreateSubMeshMaterial(const MeshDescriptor &_desc,
+                     const common::SubMesh &_subMesh);
+
       /// \brief Get the mesh name from the mesh descriptor
       /// \param[in] _desc Mesh descriptor containing the mesh name
       protected: virtual std::string MeshName(const MeshDescriptor &_desc);
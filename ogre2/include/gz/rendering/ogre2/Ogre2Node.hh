@@ -124,6 +124,11 @@ namespace gz
       /// \brief A list of child nodes
       protected: Ogre2NodeStorePtr children;
 
+      /// \brief True if the ogre scene node can be recycled by the scene's
+      /// object pool when this node is destroyed
+      /// \sa Scene::SetObjectPoolingEnabled
+      protected: bool recyclable = false;
+
       // TODO(anyone): remove the need for a visual friend class
       private: friend class Ogre2Visual;
     };
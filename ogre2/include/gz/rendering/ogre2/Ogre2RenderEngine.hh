@@ -97,10 +97,20 @@ namespace gz
       // Documentation Inherited.
       public: virtual std::string Name() const override;
 
-      /// \brief Add path to resource in ogre2's resource manager
+      /// \brief Add path to resource in ogre2's resource manager. Paths
+      /// that were already added are ignored. New paths are registered with
+      /// OGRE right away if the engine is loaded, otherwise by
+      /// LoadResourcePaths, which scenes call before rendering.
       /// \param[in] _uri Resource path in the form of an uri
       public: void AddResourcePath(const std::string &_uri) override;
 
+      /// \brief Register the resource paths added while the engine was not
+      /// loaded as OGRE resource locations and parse the material scripts
+      /// they contain. Each directory is scanned once, directories inside an
+      /// already registered directory are not registered again, and each
+      /// material script is parsed once.
+      public: void LoadResourcePaths();
+
       /// \brief return the ogre window
       public: Ogre::Window * OgreWindow() const;
 
@@ -154,6 +164,13 @@ namespace gz
       /// \brief Register Hlms
       private: void RegisterHlms();
 
+      /// \brief Enable the shader microcode cache and load the HLMS and
+      /// microcode caches, if the HLMS cache is enabled and was not loaded
+      /// yet since the engine was loaded
+      /// \param[in] _hlmsFolder Folder of the HLMS templates, which are
+      /// hashed to select the cache
+      private: void LoadHlmsCache(const std::string &_hlmsFolder);
+
       /// \brief Create ogre root
       private: void CreateRoot();
 
@@ -179,6 +196,46 @@ namespace gz
       /// \return a list of FSAA levels
       public: std::vector<unsigned int> FSAALevels() const;
 
+      /// \brief Get the directory of the on-disk mesh buffer cache. It is
+      /// set with the "meshCachePath" engine parameter, or else with the
+      /// GZ_RENDERING_MESH_CACHE_PATH environment variable.
+      /// \return Cache directory, empty if the mesh cache is disabled
+      public: std::string MeshCachePath() const;
+
+      /// \brief Get the directory of the on-disk texture cache. It is set
+      /// with the "textureCachePath" engine parameter, or else with the
+      /// GZ_RENDERING_TEXTURE_CACHE_PATH environment variable. When set,
+      /// texture files are converted once to GPU ready mipmapped and, where
+      /// supported, block compressed textures, which are stored in the
+      /// cache and uploaded directly on later loads.
+      /// \return Cache directory, empty if the texture cache is disabled
+      public: std::string TextureCachePath() const;
+
+      /// \brief Get the directory of the on-disk heightmap cache, which
+      /// holds the sampled and normalized heights of heightmaps loaded from
+      /// files. It is set with the "heightmapCachePath" engine parameter, or
+      /// else with the GZ_RENDERING_HEIGHTMAP_CACHE_PATH environment
+      /// variable.
+      /// \return Cache directory, empty if the heightmap cache is disabled
+      public: std::string HeightmapCachePath() const;
+
+      /// \brief Get the directory of the on-disk HLMS shader cache. It is
+      /// set with the "hlmsCachePath" engine parameter, or else with the
+      /// GZ_RENDERING_HLMS_CACHE_PATH environment variable. When set, the
+      /// generated shaders of every HLMS and the compiled shader microcodes
+      /// are loaded when the engine is loaded and saved when it is
+      /// destroyed. Caches are kept per HLMS template hash, render system,
+      /// device and driver.
+      /// \return Cache directory, empty if the HLMS cache is disabled
+      public: std::string HlmsCachePath() const;
+
+      /// \brief Save the HLMS and shader microcode caches now, e.g. after
+      /// the first frames of a simulation compiled most shaders, so that
+      /// processes which don't shut down cleanly still fill the cache
+      /// \return True if the caches were saved, false if the HLMS cache is
+      /// disabled or could not be written
+      public: bool SaveHlmsCache();
+
       /// \brief Deprecated. Use SphericalClipMinDistance instead
       public: Ogre2GzHlmsSphericalClipMinDistance GZ_DEPRECATED(7) &
           HlmsCustomizations();
@@ -155,6 +155,17 @@ namespace gz
       /// \param[in] _mask Visibility mask
       public: virtual void SetVisibilityMask(uint32_t _mask);
 
+      /// \brief Set whether this render target may be rendered while
+      /// textures are still being loaded
+      /// \param[in] _allow True to render with placeholder textures
+      /// \sa Camera::SetAllowPlaceholderTextures
+      public: void SetAllowPlaceholderTextures(bool _allow);
+
+      /// \brief Get whether this render target may be rendered while
+      /// textures are still being loaded
+      /// \return True if placeholder textures are allowed
+      public: bool AllowPlaceholderTextures() const;
+
       /// \brief Update the render pass chain
       public: static void UpdateRenderPassChain(
           Ogre::CompositorWorkspace *_workspace,
@@ -165,6 +176,18 @@ namespace gz
           Ogre::TextureGpu *(*_ogreTextures)[2],
           bool _isRenderWindow);
 
+      /// \brief Switch the scene passes of a workspace to another shadow
+      /// node definition. The workspace is updated in place instead of
+      /// being recreated.
+      /// \param[in] _workspace Workspace to update
+      /// \param[in] _baseNode Name of the node definition holding the scene
+      /// passes
+      /// \param[in] _shadowNodeName Name of the shadow node definition
+      public: static void SetShadowNode(
+          Ogre::CompositorWorkspace *_workspace,
+          const std::string &_baseNode,
+          const std::string &_shadowNodeName);
+
       /// \brief Update the background color
       protected: virtual void UpdateBackgroundColor();
 
@@ -230,6 +253,9 @@ namespace gz
       /// \brief visibility mask associated with this render target
       protected: uint32_t visibilityMask = GZ_VISIBILITY_ALL;
 
+      /// \brief True if rendering does not wait for pending textures
+      protected: bool allowPlaceholderTextures = false;
+
       /// \brief Pointer to private data
       private: std::unique_ptr<Ogre2RenderTargetPrivate> dataPtr;
     };
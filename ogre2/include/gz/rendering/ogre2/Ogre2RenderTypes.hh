@@ -43,6 +43,7 @@ namespace gz
     class Ogre2Grid;
     class Ogre2Heightmap;
     class Ogre2InertiaVisual;
+    class Ogre2InstancedVisual;
     class Ogre2JointVisual;
     class Ogre2Light;
     class Ogre2LightVisual;
@@ -97,6 +98,7 @@ namespace gz
     typedef shared_ptr<Ogre2Grid>                 Ogre2GridPtr;
     typedef shared_ptr<Ogre2Heightmap>            Ogre2HeightmapPtr;
     typedef shared_ptr<Ogre2InertiaVisual>        Ogre2InertiaVisualPtr;
+    typedef shared_ptr<Ogre2InstancedVisual>      Ogre2InstancedVisualPtr;
     typedef shared_ptr<Ogre2JointVisual>          Ogre2JointVisualPtr;
     typedef shared_ptr<Ogre2Light>                Ogre2LightPtr;
     typedef shared_ptr<Ogre2LightVisual>          Ogre2LightVisualPtr;
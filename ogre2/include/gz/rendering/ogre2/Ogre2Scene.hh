@@ -40,8 +40,10 @@
 
 namespace Ogre
 {
+  class Item;
   class Root;
   class SceneManager;
+  class SceneNode;
 }
 
 namespace gz
@@ -109,6 +111,39 @@ namespace gz
       // Documentation inherited.
       public: virtual bool LegacyAutoGpuFlush() const override;
 
+      // Documentation inherited.
+      public: virtual void SetObjectPoolingEnabled(bool _enabled) override;
+
+      // Documentation inherited.
+      public: virtual bool ObjectPoolingEnabled() const override;
+
+      // Documentation inherited.
+      public: virtual void SetMeshLodEnabled(bool _enabled) override;
+
+      // Documentation inherited.
+      public: virtual bool MeshLodEnabled() const override;
+
+      // Documentation inherited.
+      public: virtual void SetMeshQuantizationEnabled(bool _enabled)
+                  override;
+
+      // Documentation inherited.
+      public: virtual bool MeshQuantizationEnabled() const override;
+
+      // Documentation inherited.
+      public: virtual unsigned int BuildStaticBatches(
+                  double _cellSize = 10.0) override;
+
+      // Documentation inherited.
+      public: virtual void ClearStaticBatches() override;
+
+      // Documentation inherited.
+      public: virtual unsigned int StaticBatchCount() const override;
+
+      // Documentation inherited.
+      public: virtual unsigned int WarmUp(
+                  const WarmUpOptions &_options = WarmUpOptions()) override;
+
       /// \brief Get a pointer to the ogre scene manager
       /// \return Pointer to the ogre scene manager
       public: virtual Ogre::SceneManager *OgreSceneManager() const;
@@ -145,7 +180,11 @@ namespace gz
       /// \param _camera camera that is about to render, used
       /// by heightmaps (Terra). See Ogre2Scene::UpdateAllHeightmaps
       /// Can be null
-      public: void StartRendering(Ogre::Camera *_camera);
+      /// \param[in] _allowPlaceholderTextures True if the camera can be
+      /// rendered while textures are still being loaded. Otherwise the
+      /// first render of each frame waits for pending textures.
+      public: void StartRendering(Ogre::Camera *_camera,
+                  bool _allowPlaceholderTextures = false);
 
       /// \internal
       /// \brief Every Render() function calls this function with
@@ -191,6 +230,54 @@ namespace gz
       /// \return True if the number of shadow casting lights changed
       /// \sa ShadowsDirty
       public: bool ShadowsDirty() const;
+
+      /// \internal
+      /// \brief Get the name of the compositor shadow node definition
+      /// cameras render with. It changes with the number of shadow casting
+      /// lights.
+      /// \return Name of the shadow node definition
+      public: const std::string &ShadowNodeName() const;
+
+      /// \internal
+      /// \brief Get an ogre scene node for a new visual. A recycled node is
+      /// returned if object pooling is enabled and one is available,
+      /// otherwise a new node is created.
+      /// \return Ogre scene node
+      /// \sa SetObjectPoolingEnabled
+      public: Ogre::SceneNode *AcquireOgreSceneNode();
+
+      /// \internal
+      /// \brief Give back an ogre scene node that is no longer used. The node
+      /// is reset and kept for reuse if object pooling is enabled,
+      /// otherwise it is destroyed.
+      /// \param[in] _node Ogre scene node to release
+      public: void ReleaseOgreSceneNode(Ogre::SceneNode *_node);
+
+      /// \internal
+      /// \brief Get a recycled ogre item created from the specified mesh
+      /// \param[in] _meshName Name of the ogre mesh
+      /// \return Recycled ogre item or null if none is available
+      public: Ogre::Item *AcquireOgreItem(const std::string &_meshName);
+
+      /// \internal
+      /// \brief Give back an ogre item that is no longer used. The item is
+      /// reset and kept for reuse if object pooling is enabled, otherwise
+      /// it is destroyed.
+      /// \param[in] _item Ogre item to release
+      public: void ReleaseOgreItem(Ogre::Item *_item);
+
+      /// \internal
+      /// \brief Render either the static batches or the original items of
+      /// the batched visuals. Passes that need to tell visuals apart, e.g.
+      /// selection and segmentation, render the original items.
+      /// \param[in] _active True to render the static batches
+      public: void SetStaticBatchesActive(bool _active);
+
+      /// \internal
+      /// \brief Destroy the static batches that contain a visual, so that
+      /// its original items are rendered again
+      /// \param[in] _visualId Id of the visual
+      public: void RemoveFromStaticBatches(unsigned int _visualId);
       /// \endcond
 
       // Documentation inherited
@@ -323,6 +410,12 @@ namespace gz
       protected: virtual FrustumVisualPtr CreateFrustumVisualImpl(unsigned int _id,
                      const std::string &_name) override;
 
+      // Documentation inherited
+      protected: virtual InstancedVisualPtr CreateInstancedVisualImpl(
+                     unsigned int _id, const std::string &_name,
+                     const MeshDescriptor &_desc, MaterialPtr _material,
+                     unsigned int _capacity) override;
+
       // Documentation inherited
       protected: virtual WireBoxPtr CreateWireBoxImpl(unsigned int _id,
                      const std::string &_name) override;
@@ -363,18 +456,27 @@ namespace gz
 
       /// \internal
       /// \brief Iterates through all Heightmaps and calls
-      /// Ogre2Heightmap::UpdateForRender on each of them
+      /// Ogre2Heightmap::UpdateForRender on each of them. Nothing is done
+      /// if the heightmaps were already updated for the same camera pose
+      /// during the current frame.
       /// \param[in] _camera Camera about to be used for rendering
-      public: void UpdateAllHeightmaps(Ogre::Camera *_camera);
+      /// \param[in] _allDirections True if several cameras at the position
+      /// of _camera render in different directions, e.g. the faces of a
+      /// cube map. The update is then valid for all of them.
+      public: void UpdateAllHeightmaps(Ogre::Camera *_camera,
+                  bool _allDirections = false);
 
       /// \internal
       /// \brief Return all heightmaps in the scene
       public: const std::vector<std::weak_ptr<Ogre2Heightmap>> &Heightmaps()
           const;
 
-      /// \brief Create a compositor shadow node with the same number of shadow
-      /// textures as the number of shadow casting lights
-      protected: void UpdateShadowNode();
+      /// \brief Select the compositor shadow node with the same number of
+      /// shadow textures as the number of shadow casting lights, creating it
+      /// if this light configuration was not seen before
+      /// \return True if the shadow node definition the cameras should use
+      /// changed, false if they can keep their current workspaces
+      protected: bool UpdateShadowNode();
 
       /// \brief Create ogre compositor shadow node definition. The function
       /// takes a vector of parameters that describe the type, number, and
@@ -421,6 +523,9 @@ namespace gz
       /// \brief Create the vaiours storage objects
       private: void CreateStores();
 
+      /// \brief Destroy all ogre objects held in the object pool
+      private: void ClearObjectPools();
+
       /// \brief Remove internal material cache for a specific material
       /// \param[in] _name Name of the template material to remove.
       public: void ClearMaterialsCache(const std::string &_name);
@@ -20,6 +20,11 @@
 #include "gz/rendering/base/BaseSensor.hh"
 #include "gz/rendering/ogre2/Ogre2Node.hh"
 
+namespace Ogre
+{
+  class Camera;
+}
+
 namespace gz
 {
   namespace rendering
@@ -35,6 +40,15 @@ namespace gz
 
       /// \brief Destructor
       public: virtual ~Ogre2Sensor();
+
+      /// \brief Update the LOD bias of an ogre camera used by this sensor,
+      /// so that mesh LODs switch where their geometric error projects to
+      /// one pixel of the sensor image, scaled by LodBias(). Call before
+      /// rendering, after the field of view of the camera is set.
+      /// \param[in] _camera Ogre camera to update
+      /// \param[in] _imageHeight Height of the image rendered by the camera
+      protected: void UpdateLodBias(Ogre::Camera *_camera,
+                     unsigned int _imageHeight) const;
     };
     }
   }
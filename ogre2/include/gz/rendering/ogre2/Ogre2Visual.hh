@@ -55,6 +55,9 @@ namespace gz
       // Documentation inherited.
       public: virtual void SetVisibilityFlags(uint32_t _flags) override;
 
+      // Documentation inherited.
+      public: virtual void SetStatic(bool _static) override;
+
       // Documentation inherited.
       public: virtual gz::math::AxisAlignedBox BoundingBox()
                   const override;
@@ -90,6 +93,13 @@ namespace gz
       // Documentation inherited.
       protected: virtual bool DetachGeometry(GeometryPtr _geometry) override;
 
+      // Documentation inherited.
+      protected: virtual bool DetachChild(NodePtr _child) override;
+
+      /// \brief Remove this visual and its static descendants from the
+      /// static batches, e.g. when the subtree is hidden or removed
+      private: void RemoveTreeFromStaticBatches();
+
       /// \brief Initialize the visual
       protected: virtual void Init() override;
 
@@ -553,6 +553,8 @@ void Ogre2BoundingBoxCamera::Render()
     return;
   }
 
+  this->UpdateLodBias(this->dataPtr->ogreCamera, this->ImageHeight());
+
   // update the compositors
   this->scene->StartRendering(nullptr);
 
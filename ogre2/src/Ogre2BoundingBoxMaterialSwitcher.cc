@@ -16,6 +16,7 @@
 */
 #include "Ogre2BoundingBoxMaterialSwitcher.hh"
 
+#include "gz/rendering/ogre2/Ogre2InstancedVisual.hh"
 #include "gz/rendering/ogre2/Ogre2Scene.hh"
 #include "gz/rendering/ogre2/Ogre2Visual.hh"
 
@@ -87,7 +88,12 @@ VisualPtr Ogre2BoundingBoxMaterialSwitcher::TopLevelModelVisual(
 void Ogre2BoundingBoxMaterialSwitcher::cameraPreRenderScene(
     Ogre::Camera * /*_cam*/)
 {
+  // batches merge visuals, so render each visual on its own
+  this->scene->SetStaticBatchesActive(false);
+
   this->datablockMap.clear();
+  const unsigned int labelHandle =
+      this->scene->InternAttribute(this->labelKey, NodeAttributeType::INT);
   auto itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
       Ogre::ItemFactory::FACTORY_TYPE_NAME);
 
@@ -101,31 +107,20 @@ void Ogre2BoundingBoxMaterialSwitcher::cameraPreRenderScene(
 
     if (!userAny.isEmpty() && userAny.getType() == typeid(unsigned int))
     {
+      const unsigned int visualId = Ogre::any_cast<unsigned int>(userAny);
       VisualPtr visual;
       try
       {
-        visual = this->scene->VisualById(Ogre::any_cast<unsigned int>(userAny));
+        visual = this->scene->VisualById(visualId);
       }
       catch(Ogre::Exception &e)
       {
         gzerr << "Ogre Error:" << e.getFullDescription() << "\n";
       }
-      Ogre2VisualPtr ogreVisual = std::dynamic_pointer_cast<Ogre2Visual>(
-        visual);
-
-      // get class user data
-      Variant labelAny = ogreVisual->UserData(this->labelKey);
 
+      // get class user data. Items with no class are considered background
       int label = this->backgroundLabel;
-      try
-      {
-        label = std::get<int>(labelAny);
-      }
-      catch(std::bad_variant_access &e)
-      {
-        // items with no class are considered background
-        label = this->backgroundLabel;
-      }
+      this->scene->IntAttribute(labelHandle, visualId, label);
 
       // for full bbox, each pixel contains 1 channel for label
       // and 2 channels stores ogreId
@@ -142,6 +137,11 @@ void Ogre2BoundingBoxMaterialSwitcher::cameraPreRenderScene(
       auto itemName = visual->Name();
       std::string parentName = this->TopLevelModelVisual(visual)->Name();
 
+      // each instance of an instanced visual gets its own box
+      unsigned int instanceIndex = 0u;
+      if (Ogre2InstancedVisual::InstanceIndex(item, instanceIndex))
+        parentName += "::" + std::to_string(instanceIndex);
+
       this->ogreIdName[ogreId] = parentName;
 
       // Switch material for all sub items
@@ -175,4 +175,6 @@ void Ogre2BoundingBoxMaterialSwitcher::cameraPostRenderScene(
     Ogre::SubItem *subItem = it.first;
     subItem->setDatablock(it.second);
   }
+
+  this->scene->SetStaticBatchesActive(true);
 }
@@ -17,6 +17,7 @@
 
 #include "gz/rendering/ogre2/Ogre2Camera.hh"
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
+#include "gz/rendering/ogre2/Ogre2InstancedVisual.hh"
 #include "gz/rendering/ogre2/Ogre2RenderTarget.hh"
 #include "gz/rendering/ogre2/Ogre2Scene.hh"
 #include "gz/rendering/ogre2/Ogre2SelectionBuffer.hh"
@@ -153,6 +154,9 @@ void Ogre2Camera::SetMaterial(const MaterialPtr &_material)
 //////////////////////////////////////////////////
 void Ogre2Camera::Render()
 {
+  this->UpdateLodBias(this->ogreCamera, this->ImageHeight());
+  this->renderTexture->SetAllowPlaceholderTextures(
+      this->allowPlaceholderTextures);
   this->renderTexture->Render();
 }
 
@@ -290,8 +294,17 @@ Ogre2SelectionBuffer *Ogre2Camera::SelectionBuffer() const
 
 //////////////////////////////////////////////////
 VisualPtr Ogre2Camera::VisualAt(const math::Vector2i &_mousePos)
+{
+  unsigned int instanceIndex = 0u;
+  return this->VisualInstanceAt(_mousePos, instanceIndex);
+}
+
+//////////////////////////////////////////////////
+VisualPtr Ogre2Camera::VisualInstanceAt(const math::Vector2i &_mousePos,
+    unsigned int &_instanceIndex)
 {
   VisualPtr result;
+  _instanceIndex = 0u;
 
   if (!this->selectionBuffer)
   {
@@ -325,6 +338,9 @@ VisualPtr Ogre2Camera::VisualAt(const math::Vector2i &_mousePos)
       {
         result = this->scene->VisualById(Ogre::any_cast<unsigned int>(
               ogreItem->getUserObjectBindings().getUserAny()));
+
+        // items of instanced visuals also store their instance index
+        Ogre2InstancedVisual::InstanceIndex(ogreItem, _instanceIndex);
       }
       catch(Ogre::Exception &e)
       {
@@ -144,9 +144,6 @@ class gz::rendering::Ogre2DepthCameraPrivate
 
   /// \brief Name of sky box material
   public: const std::string kSkyboxMaterialName = "SkyBox";
-
-  /// \brief Name of shadow compositor node
-  public: const std::string kShadowNodeName = "PbsMaterialsShadowNode";
 };
 
 using namespace gz;
@@ -712,7 +709,7 @@ void Ogre2DepthCamera::CreateDepthTexture()
         Ogre::CompositorPassSceneDef *passScene =
             static_cast<Ogre::CompositorPassSceneDef *>(
             colorTargetDef->addPass(Ogre::PASS_SCENE));
-        passScene->mShadowNode = this->dataPtr->kShadowNodeName;
+        passScene->mShadowNode = this->scene->ShadowNodeName();
         passScene->setVisibilityMask(GZ_VISIBILITY_ALL);
         passScene->mIncludeOverlays = false;
         passScene->mFirstRQ = 0u;
@@ -751,9 +748,7 @@ void Ogre2DepthCamera::CreateDepthTexture()
             static_cast<Ogre::CompositorPassSceneDef *>(
             colorTargetDef->addPass(Ogre::PASS_SCENE));
         passScene->setVisibilityMask(GZ_VISIBILITY_ALL);
-        // todo(anyone) PbsMaterialsShadowNode is hardcoded.
-        // Although this may be just fine
-        passScene->mShadowNode = this->dataPtr->kShadowNodeName;
+        passScene->mShadowNode = this->scene->ShadowNodeName();
         passScene->mFirstRQ = 2u;
       }
     }
@@ -976,6 +971,8 @@ void Ogre2DepthCamera::Render()
   const bool bOldDepthClamp = this->ogreCamera->getNeedsDepthClamp();
   this->ogreCamera->_setNeedsDepthClamp(true);
 
+  this->UpdateLodBias(this->ogreCamera, this->ImageHeight());
+
   this->scene->StartRendering(this->ogreCamera);
 
   // update the compositors
@@ -1219,20 +1216,9 @@ void Ogre2DepthCamera::SetShadowsDirty()
 //////////////////////////////////////////////////
 void Ogre2DepthCamera::SetShadowsNodeDefDirty()
 {
-  if (!this->dataPtr->ogreCompositorWorkspace)
-    return;
-
-  auto engine = Ogre2RenderEngine::Instance();
-  auto ogreRoot = engine->OgreRoot();
-  Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
-
-  ogreCompMgr->removeWorkspace(this->dataPtr->ogreCompositorWorkspace);
-  this->dataPtr->ogreCompositorWorkspace = nullptr;
-  if (this->dataPtr->particleNoiseListener)
-  {
-    this->ogreCamera->removeListener(
-        this->dataPtr->particleNoiseListener.get());
-  }
+  Ogre2RenderTarget::SetShadowNode(this->dataPtr->ogreCompositorWorkspace,
+      this->dataPtr->ogreCompositorBaseNodeDef,
+      this->scene->ShadowNodeName());
 }
 
 //////////////////////////////////////////////////
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "Ogre2DiskCacheUtil.hh"
+
+namespace gz
+{
+namespace rendering
+{
+inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+
+//////////////////////////////////////////////////
+uint64_t Fnv1a(const void *_data, size_t _size, uint64_t _hash)
+{
+  const uint8_t *bytes = static_cast<const uint8_t *>(_data);
+  for (size_t i = 0u; i < _size; ++i)
+  {
+    _hash ^= bytes[i];
+    _hash *= 0x100000001b3ull;
+  }
+  return _hash;
+}
+
+//////////////////////////////////////////////////
+bool HashFile(const std::string &_path, uint64_t &_hash, uint64_t &_size)
+{
+  _size = 0u;
+  std::ifstream file(_path, std::ios::binary);
+  if (!file)
+    return false;
+
+  std::vector<char> chunk(1u << 16u);
+  while (file)
+  {
+    file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    const size_t count = static_cast<size_t>(file.gcount());
+    _hash = Fnv1a(chunk.data(), count, _hash);
+    _size += count;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::string CacheKeyString(uint64_t _key)
+{
+  std::ostringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0') << _key;
+  return key.str();
+}
+
+//////////////////////////////////////////////////
+std::string TempCacheSuffix()
+{
+  return ".tmp" + std::to_string(std::random_device()());
+}
+
+//////////////////////////////////////////////////
+bool CommitCacheFile(const std::string &_tmpFile, const std::string &_file,
+    std::string &_error)
+{
+  std::error_code ec;
+  std::filesystem::rename(_tmpFile, _file, ec);
+  if (!ec)
+    return true;
+
+  _error = ec.message();
+  std::filesystem::remove(_tmpFile, ec);
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool WriteCacheFile(const std::string &_file, const std::string &_kind,
+    const std::function<void(std::ostream &)> &_write)
+{
+  const std::string tmpFile = _file + TempCacheSuffix();
+  {
+    std::ofstream out(tmpFile, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+      gzwarn << "Unable to write " << _kind << " cache file [" << tmpFile
+             << "]" << std::endl;
+      return false;
+    }
+
+    _write(out);
+
+    if (!out)
+    {
+      gzwarn << "Unable to write " << _kind << " cache file [" << tmpFile
+             << "]" << std::endl;
+      out.close();
+      std::error_code ec;
+      std::filesystem::remove(tmpFile, ec);
+      return false;
+    }
+  }
+
+  std::string error;
+  if (!CommitCacheFile(tmpFile, _file, error))
+  {
+    gzwarn << "Unable to write " << _kind << " cache file [" << _file
+           << "]: " << error << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+}
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2DISKCACHEUTIL_HH_
+#define GZ_RENDERING_OGRE2_OGRE2DISKCACHEUTIL_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+
+#include "gz/rendering/config.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief 64 bit FNV-1a offset basis, the hash of no bytes
+    const uint64_t kFnvOffset = 0xcbf29ce484222325ull;
+
+    /// \brief Hash bytes with 64 bit FNV-1a
+    /// \param[in] _data Bytes to hash
+    /// \param[in] _size Number of bytes
+    /// \param[in] _hash Hash of the preceding bytes
+    /// \return Updated hash
+    uint64_t Fnv1a(const void *_data, size_t _size,
+        uint64_t _hash = kFnvOffset);
+
+    /// \brief Hash the content of a file with 64 bit FNV-1a
+    /// \param[in] _path Path of the file
+    /// \param[in,out] _hash Hash of the preceding bytes, updated with the
+    /// content of the file
+    /// \param[out] _size Size of the file in bytes
+    /// \return False if the file could not be opened
+    bool HashFile(const std::string &_path, uint64_t &_hash,
+        uint64_t &_size);
+
+    /// \brief Format a cache key as 16 hexadecimal digits, for use in the
+    /// name of cache files
+    /// \param[in] _key Cache key
+    /// \return Key as a string
+    std::string CacheKeyString(uint64_t _key);
+
+    /// \brief Get a suffix that makes a temporary file name unique among
+    /// the processes writing to the same cache directory
+    /// \return Suffix to append to the final file name
+    std::string TempCacheSuffix();
+
+    /// \brief Rename a temporary cache file to its final name, replacing
+    /// any previous file. The temporary file is removed on failure.
+    /// \param[in] _tmpFile Path of the temporary file
+    /// \param[in] _file Final path of the file
+    /// \param[out] _error Reason of the failure
+    /// \return True if the file was renamed
+    bool CommitCacheFile(const std::string &_tmpFile,
+        const std::string &_file, std::string &_error);
+
+    /// \brief Write a cache file. Other processes may write the same file
+    /// at the same time, so it is written to a temporary name and renamed,
+    /// and readers never see a partial file.
+    /// \param[in] _file Path of the cache file
+    /// \param[in] _kind Kind of cache, used in warning messages, e.g. "mesh"
+    /// \param[in] _write Function writing the content of the file
+    /// \return True if the file was written
+    bool WriteCacheFile(const std::string &_file, const std::string &_kind,
+        const std::function<void(std::ostream &)> &_write);
+    }
+  }
+}
+#endif
@@ -289,6 +289,8 @@ void Ogre2LaserRetroMaterialSwitcher::passPreExecute(
     hlmsManager->getBlendblock(Ogre::HlmsBlendblock());
 
   const std::string laserRetroKey = "laser_retro";
+  const unsigned int laserRetroHandle =
+      this->scene->InternAttribute(laserRetroKey, NodeAttributeType::FLOAT);
 
   auto itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
       Ogre::ItemFactory::FACTORY_TYPE_NAME);
@@ -299,50 +301,13 @@ void Ogre2LaserRetroMaterialSwitcher::passPreExecute(
 
     float retroValue = 0.0f;
 
-    // get visual
+    // get visual id
     Ogre::Any userAny = item->getUserObjectBindings().getUserAny();
     if (!userAny.isEmpty() && userAny.getType() == typeid(unsigned int))
     {
-      VisualPtr result;
-      try
-      {
-        result = this->scene->VisualById(Ogre::any_cast<unsigned int>(userAny));
-      }
-      catch(Ogre::Exception &e)
-      {
-        gzerr << "Ogre Error:" << e.getFullDescription() << "\n";
-      }
-      Ogre2VisualPtr ogreVisual =
-          std::dynamic_pointer_cast<Ogre2Visual>(result);
-
-      if (ogreVisual->HasUserData(laserRetroKey))
-      {
-        // get laser_retro
-        Variant tempLaserRetro = ogreVisual->UserData(laserRetroKey);
-
-        try
-        {
-          retroValue = std::get<float>(tempLaserRetro);
-        }
-        catch(...)
-        {
-          try
-          {
-            retroValue = static_cast<float>(std::get<double>(tempLaserRetro));
-          }
-          catch(...)
-          {
-            try
-            {
-              retroValue = static_cast<float>(std::get<int>(tempLaserRetro));
-            }
-            catch(std::bad_variant_access &e)
-            {
-              gzerr << "Error casting user data: " << e.what() << "\n";
-            }
-          }
-        }
-      }
+      // get laser_retro
+      this->scene->FloatAttribute(laserRetroHandle,
+          Ogre::any_cast<unsigned int>(userAny), retroValue);
 
       // only accept positive laser retro value
       retroValue = std::max(retroValue, 0.0f);
@@ -436,34 +401,8 @@ void Ogre2LaserRetroMaterialSwitcher::passPreExecute(
       // get visual
       VisualPtr visual = heightmap->Parent();
 
-      if (visual->HasUserData(laserRetroKey))
-      {
-        // get laser_retro
-        Variant tempLaserRetro = visual->UserData(laserRetroKey);
-
-        try
-        {
-          retroValue = std::get<float>(tempLaserRetro);
-        }
-        catch (...)
-        {
-          try
-          {
-            retroValue = static_cast<float>(std::get<double>(tempLaserRetro));
-          }
-          catch (...)
-          {
-            try
-            {
-              retroValue = static_cast<float>(std::get<int>(tempLaserRetro));
-            }
-            catch (std::bad_variant_access &e)
-            {
-              gzerr << "Error casting user data: " << e.what() << "\n";
-            }
-          }
-        }
-      }
+      // get laser_retro
+      this->scene->FloatAttribute(laserRetroHandle, visual->Id(), retroValue);
 
       // only accept positive laser retro value
       retroValue = std::max(retroValue, 0.0f);
@@ -479,7 +418,7 @@ void Ogre2LaserRetroMaterialSwitcher::passPreExecute(
       // like we do with Items (it should be impossible?)
       const Ogre::Vector4 customParameter =
         Ogre::Vector4(color, color, color, 1.0);
-      heightmap->Terra()->SetSolidColor(1u, customParameter);
+      heightmap->SetSolidColor(1u, customParameter);
     }
   }
 
@@ -542,7 +481,7 @@ void Ogre2LaserRetroMaterialSwitcher::passPosExecute(
   {
     auto heightmap = h.lock();
     if (heightmap)
-      heightmap->Terra()->UnsetSolidColors();
+      heightmap->UnsetSolidColors();
   }
 
   engine->SetGzOgreRenderingMode(GORM_NORMAL);
@@ -1210,10 +1149,17 @@ void Ogre2GpuRays::UpdateRenderTarget1stPass()
   this->dataPtr->mainPassSceneDef->setVisibilityMask(
     this->VisibilityMask() & ~Ogre2ParticleEmitter::kParticleVisibilityFlags);
 
+  // all the cube faces share one position, so heightmaps are updated
+  // once for all of them
+  if (!this->dataPtr->cubeFaceIdx.empty())
+  {
+    this->scene->UpdateAllHeightmaps(
+        this->dataPtr->cubeCam[*this->dataPtr->cubeFaceIdx.begin()], true);
+  }
+
   // update the compositors
   for (auto i : this->dataPtr->cubeFaceIdx)
   {
-    this->scene->UpdateAllHeightmaps(this->dataPtr->cubeCam[i]);
     this->dataPtr->ogreCompositorWorkspace1st[i]->setEnabled(true);
 
     this->dataPtr->ogreCompositorWorkspace1st[i]->_validateFinalTarget();
@@ -1245,7 +1191,11 @@ void Ogre2GpuRays::UpdateRenderTarget2ndPass()
 //////////////////////////////////////////////////
 void Ogre2GpuRays::Render()
 {
-  this->scene->StartRendering(this->dataPtr->ogreCamera);
+  // heightmaps are updated for the cube cameras in the 1st pass
+  this->scene->StartRendering(nullptr);
+
+  for (auto *cubeCam : this->dataPtr->cubeCam)
+    this->UpdateLodBias(cubeCam, this->dataPtr->h1st);
 
   auto engine = Ogre2RenderEngine::Instance();
 
@@ -149,7 +149,8 @@ namespace Ogre
   void Ogre2GzHlmsPbs::setupRootLayout(RootLayout &_rootLayout,
                                        const HlmsPropertyVec &_properties) const
   {
-    if (this->getProperty(_properties, "gz_render_solid_color") != 0)
+    if (this->getProperty(_properties, "gz_render_solid_color") != 0 ||
+        this->getProperty(_properties, "gz_instance_color") != 0)
     {
       // Account for the extra buffer bound at kPerObjectDataBufferSlot
       // It should be the last buffer to be set, so kPerObjectDataBufferSlot + 1
@@ -200,13 +201,11 @@ namespace Ogre
                                 _texUnit);
     }
 
-    if (_casterPass ||
-        (this->gzOgreRenderingMode != GORM_SOLID_COLOR &&
-         this->gzOgreRenderingMode != GORM_SOLID_THERMAL_COLOR_TEXTURED))
-    {
+    if (_casterPass)
       return;
-    }
 
+    // outside of the solid color modes the buffer only exists once a
+    // tinted instance was drawn, otherwise this does nothing
     this->BindObjectDataBuffer(_commandBuffer, kPerObjectDataBufferSlot);
   }
 
@@ -248,6 +247,13 @@ namespace Ogre
         dataPtr[3] = customParam.w;
       }
     }
+    else if (!_casterPass &&
+             _queuedRenderable.renderable->hasCustomParameter(
+               kInstanceColorCustomParameter))
+    {
+      this->WriteInstanceColor(instanceIdx, _queuedRenderable,
+                               _commandBuffer);
+    }
 
     return instanceIdx;
   }
@@ -307,10 +313,44 @@ namespace Ogre
         dataPtr[3] = customParam.w;
       }
     }
+    else if (!_casterPass &&
+             _queuedRenderable.renderable->hasCustomParameter(
+               kInstanceColorCustomParameter))
+    {
+      this->WriteInstanceColor(instanceIdx, _queuedRenderable,
+                               _commandBuffer);
+    }
 
     return instanceIdx;
   }
 
+  /////////////////////////////////////////////////
+  void Ogre2GzHlmsPbs::WriteInstanceColor(
+    uint32 _instanceIdx, const QueuedRenderable &_queuedRenderable,
+    CommandBuffer *_commandBuffer)
+  {
+    const Vector4 &color = _queuedRenderable.renderable->getCustomParameter(
+      kInstanceColorCustomParameter);
+    float *dataPtr = this->MapObjectDataBufferFor(
+      _instanceIdx, _commandBuffer, this->mVaoManager, this->mConstBuffers,
+      this->mCurrentConstBuffer, this->mStartMappedConstBuffer,
+      kPerObjectDataBufferSlot);
+    dataPtr[0] = color.x;
+    dataPtr[1] = color.y;
+    dataPtr[2] = color.z;
+    dataPtr[3] = color.w;
+  }
+
+  /////////////////////////////////////////////////
+  void Ogre2GzHlmsPbs::calculateHashForPreCreate(
+    Renderable *_renderable, PiecesMap *_inOutPieces)
+  {
+    HlmsPbs::calculateHashForPreCreate(_renderable, _inOutPieces);
+
+    if (_renderable->hasCustomParameter(kInstanceColorCustomParameter))
+      this->setProperty("gz_instance_color", 1);
+  }
+
   /////////////////////////////////////////////////
   void Ogre2GzHlmsPbs::preCommandBufferExecution(CommandBuffer *_commandBuffer)
   {
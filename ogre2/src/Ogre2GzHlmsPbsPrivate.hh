@@ -180,6 +180,7 @@ namespace Ogre
 
     /// \brief Override HlmsListener::hlmsTypeChanged so we can
     /// bind buffers which carry per-object data when in GORM_SOLID_COLOR
+    /// or when instances of instanced visuals are tinted
     /// \param[in] _casterPass true if this is a caster pass
     /// \param[in] _commandBuffer command buffer so we can add commands
     /// \param[in] _datablock material of the object that caused
@@ -204,6 +205,22 @@ namespace Ogre
       bool _casterPass, uint32 _lastCacheHash,
       CommandBuffer *_commandBuffer ) override;
 
+    /// \brief Override to enable the instance tint on renderables that
+    /// have kInstanceColorCustomParameter
+    /// \param[in] _renderable see base class
+    /// \param[in,out] _inOutPieces see base class
+    protected: virtual void calculateHashForPreCreate(
+      Renderable *_renderable, PiecesMap *_inOutPieces) override;
+
+    /// \brief Write the instance tint of a renderable to the per-object
+    /// data buffer
+    /// \param[in] _instanceIdx Draw id of the renderable
+    /// \param[in] _queuedRenderable Renderable being drawn
+    /// \param[in] _commandBuffer Command buffer to bind the buffer with
+    private: void WriteInstanceColor(
+      uint32 _instanceIdx, const QueuedRenderable &_queuedRenderable,
+      CommandBuffer *_commandBuffer);
+
     // Documentation inherited
     public: virtual void preCommandBufferExecution(
         CommandBuffer *_commandBuffer) override;
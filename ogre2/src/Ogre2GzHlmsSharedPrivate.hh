@@ -41,6 +41,11 @@ namespace gz
     typedef gz::rendering::GzOgreRenderingMode GzOgreRenderingMode;
     typedef Ogre::vector<Ogre::ConstBufferPacked*>::type ConstBufferPackedVec;
 
+    /// \brief Index of the renderable custom parameter holding the tint
+    /// color of an instance of an instanced visual. Renderables must have it
+    /// before their datablock is set, since it changes their shader.
+    static const size_t kInstanceColorCustomParameter = 3u;
+
     /// \brief Implements code shared across all or most of our Hlms
     /// customizations
     /// \internal
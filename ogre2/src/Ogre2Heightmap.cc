@@ -15,10 +15,22 @@
  *
 */
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
 #include <gz/common/Util.hh>
+#include <gz/math/Helpers.hh>
 
 #include "gz/rendering/ogre2/Ogre2Heightmap.hh"
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
@@ -26,6 +38,8 @@
 #include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
 #include "gz/rendering/ogre2/Ogre2Scene.hh"
 
+#include "Ogre2HeightmapCache.hh"
+#include "Ogre2HeightmapRayCaster.hh"
 #include "Terra/Terra.h"
 
 #ifdef _MSC_VER
@@ -35,6 +49,7 @@
 #include <OgreHlms.h>
 #include <OgreHlmsManager.h>
 #include <OgreImage2.h>
+#include <OgreManualObject2.h>
 #include <OgreRoot.h>
 #include <OgreSceneManager.h>
 #include "Terra/Hlms/OgreHlmsTerra.h"
@@ -43,9 +58,191 @@
   #pragma warning(pop)
 #endif
 
+namespace
+{
+/// \brief Number of frames a tile stays loaded after it was last in range
+/// of a camera
+const uint64_t kTileUnloadFrames = 60u;
+
+/// \brief Tiles within this factor of the load distance have their
+/// heights prepared in the background
+const double kTilePrefetchFactor = 1.5;
+
+/// \brief Max number of tiles having their heights prepared in the
+/// background at the same time
+const unsigned int kMaxPendingTiles = 2u;
+
+/// \brief Terra shadows are recomputed right away when the light direction
+/// changes by more than this angle, in radians
+const double kShadowRefreshAngle = GZ_DTOR(2.0);
+
+/// \brief Smaller light direction changes are applied after this many
+/// frames, one Terra at a time
+const uint64_t kShadowRefreshFrames = 30u;
+
+/// \brief Get the detail map offset of a tile
+/// \param[in] _offset Offset of the tile from the heightmap corner, in
+/// meters
+/// \param[in] _textureSize Size of the texture, in meters
+/// \return Offset in texture coordinates, in range [0, 1)
+float DetailOffset(double _offset, double _textureSize)
+{
+  if (_textureSize <= 0.0)
+    return 0.0f;
+  const double offset = _offset / _textureSize;
+  return static_cast<float>(offset - std::floor(offset));
+}
+
+/// \brief Copy the heights of a tile out of the heightmap. Can be called
+/// from any thread.
+/// \param[in] _heights Normalized heights of the whole heightmap
+/// \param[in] _dataSize Number of samples along one side of the heightmap
+/// \param[in] _firstX Column of the first sample of the tile
+/// \param[in] _firstY Row of the first sample of the tile
+/// \param[in] _samples Number of samples along one side of the tile.
+/// Samples past the heightmap edge repeat the edge.
+/// \return Heights of the tile
+std::vector<float> TileHeights(const std::vector<float> &_heights,
+    unsigned int _dataSize, unsigned int _firstX, unsigned int _firstY,
+    unsigned int _samples)
+{
+  std::vector<float> heights;
+  heights.reserve(_samples * _samples);
+  for (unsigned int y = 0; y < _samples; ++y)
+  {
+    const size_t row = std::min(_firstY + y, _dataSize - 1u);
+    for (unsigned int x = 0; x < _samples; ++x)
+    {
+      const size_t column = std::min(_firstX + x, _dataSize - 1u);
+      heights.push_back(_heights[row * _dataSize + column]);
+    }
+  }
+  return heights;
+}
+
+/// \brief Get the distance from a position to the bounds of a Terra
+/// \param[in] _terra Loaded Terra
+/// \param[in] _position Position in world coordinates
+/// \return Distance, 0 if the position is within the bounds
+Ogre::Real TerraDistance(const Ogre::Terra *_terra,
+    const Ogre::Vector3 &_position)
+{
+  // Terra bounds are always kept in Y-up coordinates
+  const Ogre::Vector3 position = _terra->isZUp() ?
+      Ogre::Vector3(_position.x, _position.z, -_position.y) : _position;
+  const Ogre::Vector3 &origin = _terra->getTerrainOriginRaw();
+  const Ogre::Vector3 extent(_terra->getXZDimensions().x,
+      _terra->getHeight(), _terra->getXZDimensions().y);
+
+  Ogre::Vector3 delta;
+  for (size_t i = 0u; i < 3u; ++i)
+  {
+    delta[i] = std::max({origin[i] - position[i], Ogre::Real(0),
+        position[i] - origin[i] - extent[i]});
+  }
+  return delta.length();
+}
+
+/// \brief Square part of a tiled heightmap, loaded as its own Terra
+struct HeightmapTile
+{
+  /// \brief Column of the first sample of the tile
+  unsigned int firstX{0u};
+
+  /// \brief Row of the first sample of the tile
+  unsigned int firstY{0u};
+
+  /// \brief Center of the tile, in Terra coordinates
+  gz::math::Vector3d center;
+
+  /// \brief Size of the tile
+  gz::math::Vector3d size;
+
+  /// \brief Offset of the tile from the heightmap corner, in meters
+  gz::math::Vector2d offset;
+
+  /// \brief Min corner of the tile in the world XY plane
+  gz::math::Vector2d worldMin;
+
+  /// \brief Max corner of the tile in the world XY plane
+  gz::math::Vector2d worldMax;
+
+  /// \brief Terra of the tile, null while the tile is unloaded
+  std::unique_ptr<Ogre::Terra> terra{nullptr};
+
+  /// \brief Material of the tile, created the first time it is loaded
+  Ogre::HlmsDatablock *datablock{nullptr};
+
+  /// \brief Skirt min height auto-calculated by Terra
+  float autoSkirtValue{-1};
+
+  /// \brief Light direction the Terra shadows were computed for, zero
+  /// while the tile is unloaded
+  Ogre::Vector3 shadowLightDir{Ogre::Vector3::ZERO};
+
+  /// \brief Heights being prepared by a worker thread
+  std::future<std::vector<float>> pending;
+
+  /// \brief Last frame the tile was in range of a camera
+  uint64_t lastUsedFrame{0u};
+};
+}
+
 //////////////////////////////////////////////////
 class gz::rendering::Ogre2HeightmapPrivate
 {
+  /// \brief Create a Terra and load heights into it
+  /// \param[in] _heights Normalized heights, _samples x _samples
+  /// \param[in] _samples Number of samples along one side
+  /// \param[in] _center Center, in Terra coordinates
+  /// \param[in] _size Size of the Terra
+  /// \param[in] _name Name of the height texture
+  /// \return The Terra, using the default Terra material
+  public: std::unique_ptr<Ogre::Terra> CreateTerra(
+              std::vector<float> &_heights, unsigned int _samples,
+              const math::Vector3d &_center, const math::Vector3d &_size,
+              const std::string &_name);
+
+  /// \brief Create the Terra material of the heightmap textures
+  /// \param[in] _name Name of the material
+  /// \param[in] _desc Heightmap descriptor holding the textures
+  /// \param[in] _size Size of the terrain using the material
+  /// \param[in] _offset Offset of the terrain from the heightmap corner,
+  /// in meters, so the textures of neighbouring tiles line up
+  /// \param[in] _allowBase True to allow using the first texture as the
+  /// base diffuse map if it covers the terrain exactly
+  /// \return The material
+  public: Ogre::HlmsDatablock *CreateDatablock(const std::string &_name,
+              const HeightmapDescriptor &_desc, const math::Vector3d &_size,
+              const math::Vector2d &_offset, bool _allowBase);
+
+  /// \brief Load the tiles in range of a camera, and prepare the heights
+  /// of the tiles about to get in range
+  /// \param[in] _camera Camera about to render
+  /// \param[in] _desc Heightmap descriptor
+  public: void UpdateTiles(const Ogre::Camera *_camera,
+              const HeightmapDescriptor &_desc);
+
+  /// \brief Load the Terra of a tile if it is not loaded
+  /// \param[in] _tile Tile to load
+  /// \param[in] _desc Heightmap descriptor
+  public: void LoadTile(HeightmapTile &_tile,
+              const HeightmapDescriptor &_desc);
+
+  /// \brief Call a function on each loaded Terra
+  /// \param[in] _func Function taking the Terra, its auto-calculated
+  /// skirt min height and the light direction of its shadows
+  public: template<typename F> void ForEachTerra(F _func)
+  {
+    if (this->terra)
+      _func(this->terra.get(), this->autoSkirtValue, this->terraShadowDir);
+    for (auto &tile : this->tiles)
+    {
+      if (tile.terra)
+        _func(tile.terra.get(), tile.autoSkirtValue, tile.shadowLightDir);
+    }
+  }
+
   /// \brief Skirt min height. Leave it at -1 for automatic.
   /// Leave it at 0 for maximum skirt size (high performance hit)
   public: float skirtMinHeight{-1};
@@ -60,204 +257,104 @@ class gz::rendering::Ogre2HeightmapPrivate
   /// \brief Size of the heightmap data.
   public: unsigned int dataSize{0u};
 
-  /// \brief Pointer to ogre terra object
-  public: std::unique_ptr<Ogre::Terra> terra{nullptr};
-};
-
-using namespace gz;
-using namespace rendering;
-
-//////////////////////////////////////////////////
-Ogre2Heightmap::Ogre2Heightmap(const HeightmapDescriptor &_desc)
-    : BaseHeightmap(_desc), dataPtr(std::make_unique<Ogre2HeightmapPrivate>())
-{
-}
-
-//////////////////////////////////////////////////
-Ogre2Heightmap::~Ogre2Heightmap()
-{
-  this->DestroyImpl();
-}
-
-//////////////////////////////////////////////////
-void Ogre2Heightmap::DestroyImpl()
-{
-  this->dataPtr->terra.reset();
-}
-
-//////////////////////////////////////////////////
-void Ogre2Heightmap::Init()
-{
-  Ogre2Object::Init();
-
-  if (this->descriptor.Data() == nullptr)
-  {
-    gzerr << "Failed to initialize: null heightmap data." << std::endl;
-    return;
-  }
+  /// \brief Scene manager the Terras are created in
+  public: Ogre::SceneManager *sceneManager{nullptr};
 
-  if (this->descriptor.Name().empty())
-    this->descriptor.SetName(this->Name());
+  /// \brief Pointer to ogre terra object. Null if the heightmap is tiled.
+  public: std::unique_ptr<Ogre::Terra> terra{nullptr};
 
-  // Add paths
-  for (auto i = 0u; i < this->descriptor.TextureCount(); ++i)
-  {
-    auto texture = this->descriptor.TextureByIndex(i);
-    Ogre2RenderEngine::Instance()->AddResourcePath(texture->Diffuse());
-    Ogre2RenderEngine::Instance()->AddResourcePath(texture->Normal());
-  }
+  /// \brief Number of samples along one side of a tile, 0 if the
+  /// heightmap is not tiled
+  public: unsigned int tileSize{0u};
 
-  // \todo These parameters shouldn't be hardcoded, and instead parametrized so
-  // that they can be made consistent across different libraries (like
-  // gz-physics)
-  bool flipY = false;
-  // sampling size along image width and height
-  const bool needsOgre1Compat =
-      math::isPowerOfTwo(this->descriptor.Data()->Width() - 1u);
-  const unsigned int srcWidth =
-    needsOgre1Compat
-      ? ((this->descriptor.Data()->Width() * this->descriptor.Sampling()) -
-         this->descriptor.Sampling() + 1)
-      : (this->descriptor.Data()->Width() * this->descriptor.Sampling());
+  /// \brief Distance from the camera within which tiles are loaded
+  public: double tileLoadDistance{0.0};
 
-  if (needsOgre1Compat)
-  {
-    gzwarn << "Heightmap final sampling should be 2^n"
-           << std::endl << " which differs from ogre1's 2^n+1"
-           << std::endl << "The last row and column will be cropped"
-           << std::endl << "size = (width * sampling) - sampling + 1"
-           << std::endl << "[" << srcWidth << "] = (["
-           << this->descriptor.Data()->Width() << "] * ["
-           << this->descriptor.Sampling() << "]) - ["
-           << this->descriptor.Sampling() << "] + 1"
-        << std::endl;
-  }
-  else if (!math::isPowerOfTwo(srcWidth))
-  {
-    gzerr << "Heightmap final sampling must satisfy 2^n."
-           << std::endl << "size = width * sampling"
-           << std::endl << "[" << srcWidth << "] = ["
-           << this->descriptor.Data()->Width() << "] * ["
-           << this->descriptor.Sampling() << "]"
-        << std::endl;
-    return;
-  }
+  /// \brief Prefix of the tile material names, unique per heightmap
+  public: std::string tileMaterialPrefix;
 
-  const unsigned int newWidth =
-    math::isPowerOfTwo(srcWidth) ? srcWidth : (srcWidth - 1u);
+  /// \brief Tiles of a tiled heightmap, row by row
+  public: std::vector<HeightmapTile> tiles;
 
-  math::Vector3d scale;
-  scale.X(this->descriptor.Size().X() / newWidth);
-  scale.Y(this->descriptor.Size().Y() / newWidth);
-  scale.Z(1.0);
+  /// \brief Tile closest to the last camera, used for Terra shadows
+  public: Ogre::Terra *activeTerra{nullptr};
 
-  // Construct the heightmap lookup table
-  std::vector<float> lookup;
-  this->descriptor.Data()->FillHeightMap(this->descriptor.Sampling(),
-      srcWidth, this->descriptor.Size(), scale, flipY, lookup);
-  this->dataPtr->heights.reserve(newWidth * newWidth);
-
-  // Terra is optimized to work with UNORM heightmaps, therefore it assumes
-  // lowest height is 0.
-  // So we move the heightmap so that its min elevation = 0 before feeding to
-  // ogre. It is later translated back by the setOrigin call.
-  //
-  // Obtain min and max elevation and bring everything to range [0; 1]
-  // Terra should support non-normalized ranges but there are a couple
-  // bugs preventing that, so it's just easier to normalize the data
-  double minElevation = this->descriptor.Data()->MinElevation();
-  double maxElevation = this->descriptor.Data()->MaxElevation();
+  /// \brief Empty object attached to the visual in place of the tiles,
+  /// the tiles are attached to its scene node
+  public: Ogre::ManualObject *anchor{nullptr};
 
-  for (unsigned int y = 0; y < newWidth; ++y)
-  {
-    for (unsigned int x = 0; x < newWidth; ++x)
-    {
-      const size_t index = y * srcWidth + x;
-      float heightVal = lookup[index];
+  /// \brief Frame counter used to unload tiles out of range and to
+  /// throttle shadow updates
+  public: uint64_t frame{0u};
 
-      // Sanity check in case we get NaNs from gz-common, this prevents a crash
-      // in Ogre
-      if (!std::isfinite(heightVal))
-        heightVal = minElevation;
+  /// \brief Light direction the Terra shadows converge to. It follows
+  /// the directional light when it moves enough or after a while.
+  public: Ogre::Vector3 shadowLightDir{Ogre::Vector3::ZERO};
 
-      if (heightVal < minElevation || heightVal > maxElevation)
-      {
-        gzerr << "Internal error: height [" << heightVal
-               << "] is out of bounds [" << minElevation << " / "
-               << maxElevation << "]" << std::endl;
-      }
-      this->dataPtr->heights.push_back(heightVal);
-    }
-  }
+  /// \brief Frame shadowLightDir last changed
+  public: uint64_t shadowLightFrame{0u};
 
-  // min and max elevations collected. Now normalize
-  const float heightDiff = maxElevation - minElevation;
-  const float invHeightDiff =
-      fabsf( heightDiff ) < 1e-6f ? 1.0f : (1.0f / heightDiff);
-  for (float &heightVal : this->dataPtr->heights)
-  {
-    heightVal = (heightVal - minElevation) * invHeightDiff;
-    assert( heightVal >= 0 );
-  }
+  /// \brief Light direction the shadows of terra were computed for
+  public: Ogre::Vector3 terraShadowDir{Ogre::Vector3::ZERO};
 
-  this->dataPtr->dataSize = newWidth;
+  /// \brief World position of the first height sample at zero height
+  public: math::Vector3d gridOrigin;
 
-  if (this->dataPtr->heights.empty())
-  {
-    gzerr << "Failed to load terrain. Heightmap data is empty" << std::endl;
-    return;
-  }
+  /// \brief Distance between samples along X and Y, and height scale
+  public: math::Vector3d gridScale{1, 1, 1};
 
-  // Create terrain group, which holds all the individual terrain instances.
-  // Param 1: Pointer to the scene manager
-  // Param 2: Alignment plane
-  // Param 3: Number of vertices along one edge of the terrain (2^n+1).
-  //          Terrains must be square, with each side a power of 2 in size
-  // Param 4: World size of each terrain instance, in meters.
+  /// \brief Intersects rays with the heights, created on first use
+  public: std::unique_ptr<Ogre2HeightmapRayCaster> rayCaster;
+};
 
-  auto ogreScene = std::dynamic_pointer_cast<Ogre2Scene>(this->Scene());
+using namespace gz;
+using namespace rendering;
 
+//////////////////////////////////////////////////
+std::unique_ptr<Ogre::Terra> Ogre2HeightmapPrivate::CreateTerra(
+    std::vector<float> &_heights, unsigned int _samples,
+    const math::Vector3d &_center, const math::Vector3d &_size,
+    const std::string &_name)
+{
   Ogre::Image2 image;
-  image.loadDynamicImage(this->dataPtr->heights.data(), newWidth, newWidth,
+  image.loadDynamicImage(_heights.data(), _samples, _samples,
                          1u, Ogre::TextureTypes::Type2D,
                          Ogre::PFG_R32_FLOAT, false);
 
-  const math::Vector3d size = this->descriptor.Size();
-
-  // The position's Y sign ends up flipped
-  math::Vector3d center(
-      this->descriptor.Position().X(),
-      -this->descriptor.Position().Y(),
-      this->descriptor.Position().Z() + size.Z() * 0.5 + minElevation);
-
   Ogre::Root *ogreRoot = Ogre2RenderEngine::Instance()->OgreRoot();
-  Ogre::SceneManager *ogreSceneManager = ogreScene->OgreSceneManager();
   Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
 
   // TODO(anyone): Gazebo doesn't support SCENE_STATIC scene nodes
-  this->dataPtr->terra =
+  auto newTerra =
       std::make_unique<Ogre::Terra>(
         Ogre::Id::generateNewId<Ogre::MovableObject>(),
-        &ogreSceneManager->_getEntityMemoryManager(
+        &this->sceneManager->_getEntityMemoryManager(
           Ogre::/*SCENE_STATIC*/SCENE_DYNAMIC),
-        ogreSceneManager, 11u, ogreCompMgr, nullptr, true );
+        this->sceneManager, 11u, ogreCompMgr, nullptr, true );
 
   // Does not cast shadows because it uses a raymarching implementation
   // instead of shadow maps. It does receive shadows from shadow maps though
-  this->dataPtr->terra->setCastShadows(false);
-  this->dataPtr->terra->load(
+  newTerra->setCastShadows(false);
+  newTerra->load(
         image,
-        Ogre2Conversions::Convert(center),
-        Ogre2Conversions::Convert(size),
+        Ogre2Conversions::Convert(_center),
+        Ogre2Conversions::Convert(_size),
         false,
         false,
-        this->descriptor.Name());
-  this->dataPtr->autoSkirtValue =
-      this->dataPtr->terra->getCustomSkirtMinHeight();
-  this->dataPtr->terra->setDatablock(
+        _name);
+  newTerra->setDatablock(
         ogreRoot->getHlmsManager()->
         getHlms(Ogre::HLMS_USER3)->getDefaultDatablock());
+  return newTerra;
+}
 
+//////////////////////////////////////////////////
+Ogre::HlmsDatablock *Ogre2HeightmapPrivate::CreateDatablock(
+    const std::string &_name, const HeightmapDescriptor &_desc,
+    const math::Vector3d &_size, const math::Vector2d &_offset,
+    bool _allowBase)
+{
+  Ogre::Root *ogreRoot = Ogre2RenderEngine::Instance()->OgreRoot();
   Ogre::Hlms *hlmsTerra =
           ogreRoot->getHlmsManager()->getHlms(Ogre::HLMS_USER3);
 
@@ -265,10 +362,8 @@ void Ogre2Heightmap::Init()
              "HlmsTerra incorrectly setup, memory corrupted, or "
              "HlmsTerra::getType changed while this code is out of sync");
 
-  Ogre::String datablockName = "GZ Terra " + this->name;
-
   Ogre::HlmsDatablock *datablockBase = hlmsTerra->createDatablock(
-              datablockName, datablockName, Ogre::HlmsMacroblock(),
+              _name, _name, Ogre::HlmsMacroblock(),
               Ogre::HlmsBlendblock(), Ogre::HlmsParamVec(), false);
 
   GZ_ASSERT(dynamic_cast<Ogre::HlmsTerraDatablock *>(datablockBase) != nullptr,
@@ -282,17 +377,17 @@ void Ogre2Heightmap::Init()
   samplerblock.setFiltering(Ogre::TFO_ANISOTROPIC);
   samplerblock.mMaxAnisotropy = 8u;
 
-  size_t numTextures = static_cast<size_t>(this->descriptor.TextureCount());
+  size_t numTextures = static_cast<size_t>(_desc.TextureCount());
 
   if (numTextures >= 1u)
   {
     bool bCanUseFirstAsBase = false;
 
     using namespace Ogre;
-    const HeightmapTexture *texture0 = this->descriptor.TextureByIndex(0);
-    if (texture0->Normal().empty() &&
-        abs(size.X() - texture0->Size()) < 1e-6 &&
-        abs(size.Y() - texture0->Size()) < 1e-6 )
+    const HeightmapTexture *texture0 = _desc.TextureByIndex(0);
+    if (_allowBase && texture0->Normal().empty() &&
+        abs(_size.X() - texture0->Size()) < 1e-6 &&
+        abs(_size.Y() - texture0->Size()) < 1e-6 )
     {
       bCanUseFirstAsBase = true;
     }
@@ -322,17 +417,21 @@ void Ogre2Heightmap::Init()
                             texture0->Normal(), &samplerblock);
 
       const float sizeX =
-              static_cast<float>(size.X() / texture0->Size());
+              static_cast<float>(_size.X() / texture0->Size());
       const float sizeY =
-              static_cast<float>(size.Y() / texture0->Size());
+              static_cast<float>(_size.Y() / texture0->Size());
       if (!texture0->Diffuse().empty() || !texture0->Normal().empty())
-        datablock->setDetailMapOffsetScale(0, Vector4(0, 0, sizeX, sizeY));
+      {
+        datablock->setDetailMapOffsetScale(0, Vector4(
+            DetailOffset(_offset.X(), texture0->Size()),
+            DetailOffset(_offset.Y(), texture0->Size()), sizeX, sizeY));
+      }
     }
 
     for (size_t i = 1u; i < numTextures; ++i)
     {
       const size_t idxOffset = bCanUseFirstAsBase ? 1 : 0;
-      const HeightmapTexture *texture = this->descriptor.TextureByIndex(i);
+      const HeightmapTexture *texture = _desc.TextureByIndex(i);
 
       datablock->setTexture(static_cast<TerraTextureTypes>(
                             TERRA_DETAIL0 + i - idxOffset),
@@ -343,19 +442,21 @@ void Ogre2Heightmap::Init()
                             texture->Normal(), &samplerblock);
 
       const float sizeX =
-              static_cast<float>(size.X() / texture->Size());
+              static_cast<float>(_size.X() / texture->Size());
       const float sizeY =
-              static_cast<float>(size.Y() / texture->Size());
+              static_cast<float>(_size.Y() / texture->Size());
       if (!texture->Diffuse().empty() || !texture->Normal().empty())
       {
           datablock->setDetailMapOffsetScale(
                       static_cast<uint8_t>(i - idxOffset),
-                      Vector4(0, 0, sizeX, sizeY));
+                      Vector4(DetailOffset(_offset.X(), texture->Size()),
+                              DetailOffset(_offset.Y(), texture->Size()),
+                              sizeX, sizeY));
       }
     }
 
 
-    size_t numBlends = static_cast<size_t>(this->descriptor.BlendCount());
+    size_t numBlends = static_cast<size_t>(_desc.BlendCount());
     if ((numBlends > 3u && !bCanUseFirstAsBase) ||
         (numBlends > 4u && bCanUseFirstAsBase))
     {
@@ -372,7 +473,7 @@ void Ogre2Heightmap::Init()
     for (size_t i = 0; i < numBlends; ++i)
     {
       const size_t idxOffset = bCanUseFirstAsBase ? 0u : 1u;
-      const HeightmapBlend *blend = this->descriptor.BlendByIndex(i);
+      const HeightmapBlend *blend = _desc.BlendByIndex(i);
       minBlendHeights[i + idxOffset] =
               static_cast<Ogre::Real>(blend->MinHeight());
       maxBlendHeights[i + idxOffset] =
@@ -382,12 +483,387 @@ void Ogre2Heightmap::Init()
     datablock->setGzWeightsHeights(minBlendHeights, maxBlendHeights);
   }
 
-  this->dataPtr->terra->setDatablock(datablock);
+  return datablock;
+}
+
+//////////////////////////////////////////////////
+void Ogre2HeightmapPrivate::UpdateTiles(const Ogre::Camera *_camera,
+    const HeightmapDescriptor &_desc)
+{
+  this->activeTerra = nullptr;
+
+  // Tiles can only be shown once the heightmap is attached to a visual
+  if (!this->anchor || !this->anchor->getParentSceneNode())
+    return;
+
+  const Ogre::Vector3 cameraPos = _camera->getDerivedPosition();
+  const math::Vector2d camera(cameraPos.x, cameraPos.y);
+
+  // Limit the worker threads preparing heights, a fast camera would
+  // otherwise start one per tile it gets close to
+  unsigned int pendingCount = 0u;
+  for (const auto &tile : this->tiles)
+  {
+    if (tile.pending.valid() && tile.pending.wait_for(
+        std::chrono::seconds(0)) != std::future_status::ready)
+    {
+      ++pendingCount;
+    }
+  }
+
+  double activeDistance = std::numeric_limits<double>::max();
+  for (auto &tile : this->tiles)
+  {
+    const double dx = std::max({tile.worldMin.X() - camera.X(), 0.0,
+        camera.X() - tile.worldMax.X()});
+    const double dy = std::max({tile.worldMin.Y() - camera.Y(), 0.0,
+        camera.Y() - tile.worldMax.Y()});
+    const double distance = std::sqrt(dx * dx + dy * dy);
+
+    if (distance <= this->tileLoadDistance)
+    {
+      tile.lastUsedFrame = this->frame;
+      this->LoadTile(tile, _desc);
+
+      const double centerDistance =
+          camera.Distance((tile.worldMin + tile.worldMax) * 0.5);
+      if (tile.terra && centerDistance < activeDistance)
+      {
+        activeDistance = centerDistance;
+        this->activeTerra = tile.terra.get();
+      }
+    }
+    else if (distance <= this->tileLoadDistance * kTilePrefetchFactor)
+    {
+      // Keep the tile loaded if it is, otherwise prepare its heights so
+      // loading it later only has to create the Terra
+      tile.lastUsedFrame = this->frame;
+      if (!tile.terra && !tile.pending.valid() &&
+          pendingCount < kMaxPendingTiles)
+      {
+        tile.pending = std::async(std::launch::async, TileHeights,
+            std::cref(this->heights), this->dataSize, tile.firstX,
+            tile.firstY, this->tileSize + 1u);
+        ++pendingCount;
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2HeightmapPrivate::LoadTile(HeightmapTile &_tile,
+    const HeightmapDescriptor &_desc)
+{
+  if (_tile.terra)
+    return;
+
+  std::vector<float> tileHeights = _tile.pending.valid() ?
+      _tile.pending.get() :
+      TileHeights(this->heights, this->dataSize, _tile.firstX, _tile.firstY,
+          this->tileSize + 1u);
+
+  const std::string tileSuffix = "_tile_" +
+      std::to_string(_tile.firstX / this->tileSize) + "_" +
+      std::to_string(_tile.firstY / this->tileSize);
+
+  _tile.terra = this->CreateTerra(tileHeights, this->tileSize + 1u,
+      _tile.center, _tile.size, _desc.Name() + tileSuffix);
+  _tile.autoSkirtValue = _tile.terra->getCustomSkirtMinHeight();
+
+  if (!_tile.datablock)
+  {
+    _tile.datablock = this->CreateDatablock(
+        this->tileMaterialPrefix + tileSuffix, _desc, _tile.size,
+        _tile.offset, false);
+  }
+  _tile.terra->setDatablock(_tile.datablock);
+
+  // Tiles are rendered as part of the visual the heightmap is attached to
+  _tile.terra->getUserObjectBindings().setUserAny(
+      this->anchor->getUserObjectBindings().getUserAny());
+  _tile.terra->setVisibilityFlags(this->anchor->getVisibilityFlags());
+  this->anchor->getParentSceneNode()->attachObject(_tile.terra.get());
+}
+
+//////////////////////////////////////////////////
+Ogre2Heightmap::Ogre2Heightmap(const HeightmapDescriptor &_desc)
+    : BaseHeightmap(_desc), dataPtr(std::make_unique<Ogre2HeightmapPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+Ogre2Heightmap::~Ogre2Heightmap()
+{
+  this->DestroyImpl();
+}
+
+//////////////////////////////////////////////////
+void Ogre2Heightmap::DestroyImpl()
+{
+  this->dataPtr->rayCaster.reset();
+  this->dataPtr->activeTerra = nullptr;
+  for (auto &tile : this->dataPtr->tiles)
+  {
+    tile.terra.reset();
+    if (tile.datablock)
+    {
+      tile.datablock->getCreator()->destroyDatablock(
+          tile.datablock->getName());
+      tile.datablock = nullptr;
+    }
+  }
+  this->dataPtr->tiles.clear();
+  this->dataPtr->terra.reset();
+  if (this->dataPtr->anchor)
+  {
+    this->dataPtr->anchor->_getManager()->destroyManualObject(
+        this->dataPtr->anchor);
+    this->dataPtr->anchor = nullptr;
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2Heightmap::Init()
+{
+  Ogre2Object::Init();
+
+  if (this->descriptor.Data() == nullptr)
+  {
+    gzerr << "Failed to initialize: null heightmap data." << std::endl;
+    return;
+  }
+
+  if (this->descriptor.Name().empty())
+    this->descriptor.SetName(this->Name());
+
+  // Add paths
+  for (auto i = 0u; i < this->descriptor.TextureCount(); ++i)
+  {
+    auto texture = this->descriptor.TextureByIndex(i);
+    Ogre2RenderEngine::Instance()->AddResourcePath(texture->Diffuse());
+    Ogre2RenderEngine::Instance()->AddResourcePath(texture->Normal());
+  }
+
+  // \todo These parameters shouldn't be hardcoded, and instead parametrized so
+  // that they can be made consistent across different libraries (like
+  // gz-physics)
+  bool flipY = false;
+  // sampling size along image width and height
+  const bool needsOgre1Compat =
+      math::isPowerOfTwo(this->descriptor.Data()->Width() - 1u);
+  const unsigned int srcWidth =
+    needsOgre1Compat
+      ? ((this->descriptor.Data()->Width() * this->descriptor.Sampling()) -
+         this->descriptor.Sampling() + 1)
+      : (this->descriptor.Data()->Width() * this->descriptor.Sampling());
+
+  if (needsOgre1Compat)
+  {
+    gzwarn << "Heightmap final sampling should be 2^n"
+           << std::endl << " which differs from ogre1's 2^n+1"
+           << std::endl << "The last row and column will be cropped"
+           << std::endl << "size = (width * sampling) - sampling + 1"
+           << std::endl << "[" << srcWidth << "] = (["
+           << this->descriptor.Data()->Width() << "] * ["
+           << this->descriptor.Sampling() << "]) - ["
+           << this->descriptor.Sampling() << "] + 1"
+        << std::endl;
+  }
+  else if (!math::isPowerOfTwo(srcWidth))
+  {
+    gzerr << "Heightmap final sampling must satisfy 2^n."
+           << std::endl << "size = width * sampling"
+           << std::endl << "[" << srcWidth << "] = ["
+           << this->descriptor.Data()->Width() << "] * ["
+           << this->descriptor.Sampling() << "]"
+        << std::endl;
+    return;
+  }
+
+  const unsigned int newWidth =
+    math::isPowerOfTwo(srcWidth) ? srcWidth : (srcWidth - 1u);
+
+  math::Vector3d scale;
+  scale.X(this->descriptor.Size().X() / newWidth);
+  scale.Y(this->descriptor.Size().Y() / newWidth);
+  scale.Z(1.0);
+
+  double minElevation = this->descriptor.Data()->MinElevation();
+  double maxElevation = this->descriptor.Data()->MaxElevation();
 
   gzmsg << "Loading heightmap: " << this->descriptor.Name() << std::endl;
   auto time = std::chrono::steady_clock::now();
 
-  gzmsg << "Heightmap loaded. Process took "
+  // Heightmaps loaded from files can skip sampling by reading the heights
+  // of a previous load from the heightmap cache
+  std::unique_ptr<Ogre2HeightmapCache> cache;
+  const std::string cacheDir =
+      Ogre2RenderEngine::Instance()->HeightmapCachePath();
+  const std::string sourceFile = this->descriptor.Data()->Filename();
+  if (!cacheDir.empty() && !sourceFile.empty() && common::isFile(sourceFile))
+  {
+    std::ostringstream variant;
+    variant << std::setprecision(17)
+            << this->descriptor.Data()->Width() << " "
+            << this->descriptor.Data()->Height() << " "
+            << this->descriptor.Sampling() << " " << srcWidth << " "
+            << newWidth << " " << flipY << " " << this->descriptor.Size()
+            << " " << minElevation << " " << maxElevation;
+    cache = std::make_unique<Ogre2HeightmapCache>(
+        cacheDir, sourceFile, variant.str());
+  }
+
+  const bool loadedFromCache =
+      cache && cache->Read(newWidth, this->dataPtr->heights);
+  if (!loadedFromCache)
+  {
+    // Construct the heightmap lookup table
+    std::vector<float> lookup;
+    this->descriptor.Data()->FillHeightMap(this->descriptor.Sampling(),
+        srcWidth, this->descriptor.Size(), scale, flipY, lookup);
+    this->dataPtr->heights.reserve(newWidth * newWidth);
+
+    // Terra is optimized to work with UNORM heightmaps, therefore it assumes
+    // lowest height is 0.
+    // So we move the heightmap so that its min elevation = 0 before feeding
+    // to ogre. It is later translated back by the setOrigin call.
+    //
+    // Obtain min and max elevation and bring everything to range [0; 1]
+    // Terra should support non-normalized ranges but there are a couple
+    // bugs preventing that, so it's just easier to normalize the data
+    for (unsigned int y = 0; y < newWidth; ++y)
+    {
+      for (unsigned int x = 0; x < newWidth; ++x)
+      {
+        const size_t index = y * srcWidth + x;
+        float heightVal = lookup[index];
+
+        // Sanity check in case we get NaNs from gz-common, this prevents a
+        // crash in Ogre
+        if (!std::isfinite(heightVal))
+          heightVal = minElevation;
+
+        if (heightVal < minElevation || heightVal > maxElevation)
+        {
+          gzerr << "Internal error: height [" << heightVal
+                 << "] is out of bounds [" << minElevation << " / "
+                 << maxElevation << "]" << std::endl;
+        }
+        this->dataPtr->heights.push_back(heightVal);
+      }
+    }
+
+    // min and max elevations collected. Now normalize
+    const float heightDiff = maxElevation - minElevation;
+    const float invHeightDiff =
+        fabsf( heightDiff ) < 1e-6f ? 1.0f : (1.0f / heightDiff);
+    for (float &heightVal : this->dataPtr->heights)
+    {
+      heightVal = (heightVal - minElevation) * invHeightDiff;
+      assert( heightVal >= 0 );
+    }
+
+    if (cache)
+      cache->Write(newWidth, this->dataPtr->heights);
+  }
+
+  this->dataPtr->dataSize = newWidth;
+
+  if (this->dataPtr->heights.empty())
+  {
+    gzerr << "Failed to load terrain. Heightmap data is empty" << std::endl;
+    return;
+  }
+
+  auto ogreScene = std::dynamic_pointer_cast<Ogre2Scene>(this->Scene());
+  this->dataPtr->sceneManager = ogreScene->OgreSceneManager();
+
+  const math::Vector3d size = this->descriptor.Size();
+
+  // The position's Y sign ends up flipped
+  math::Vector3d center(
+      this->descriptor.Position().X(),
+      -this->descriptor.Position().Y(),
+      this->descriptor.Position().Z() + size.Z() * 0.5 + minElevation);
+
+  // Where Terra places the samples in the world, used by ray queries.
+  // Rows go towards -Y since the Y sign ends up flipped.
+  this->dataPtr->gridOrigin.Set(
+      this->descriptor.Position().X() - size.X() * 0.5,
+      this->descriptor.Position().Y() + size.Y() * 0.5,
+      this->descriptor.Position().Z() + minElevation);
+  this->dataPtr->gridScale.Set(size.X() / newWidth, size.Y() / newWidth,
+      std::max(size.Z(), 1e-9));
+
+  unsigned int tileSize = this->descriptor.TileSize();
+  if (tileSize > 0u && !math::isPowerOfTwo(tileSize))
+  {
+    gzwarn << "Heightmap tile size [" << tileSize << "] must satisfy 2^n. "
+           << "Loading heightmap [" << this->descriptor.Name()
+           << "] as a single terrain." << std::endl;
+    tileSize = 0u;
+  }
+
+  if (tileSize > 0u && tileSize < newWidth)
+  {
+    // Split the heightmap into tiles, each loaded as its own Terra when a
+    // camera gets within the load distance. Neighbouring tiles share their
+    // edge samples so there are no cracks between them.
+    this->dataPtr->tileSize = tileSize;
+    this->dataPtr->tileLoadDistance = this->descriptor.TileLoadDistance();
+    this->dataPtr->tileMaterialPrefix = "GZ Terra " + this->name;
+
+    const math::Vector2d spacing(size.X() / newWidth, size.Y() / newWidth);
+    const math::Vector3d tileDims(spacing.X() * (tileSize + 1u),
+        spacing.Y() * (tileSize + 1u), size.Z());
+    const math::Vector2d corner(center.X() - size.X() * 0.5,
+        center.Y() - size.Y() * 0.5);
+
+    const unsigned int tileCount = newWidth / tileSize;
+    this->dataPtr->tiles.resize(tileCount * tileCount);
+    for (unsigned int y = 0; y < tileCount; ++y)
+    {
+      for (unsigned int x = 0; x < tileCount; ++x)
+      {
+        HeightmapTile &tile = this->dataPtr->tiles[y * tileCount + x];
+        tile.firstX = x * tileSize;
+        tile.firstY = y * tileSize;
+        tile.size = tileDims;
+        tile.offset.Set(tile.firstX * spacing.X(), tile.firstY * spacing.Y());
+        tile.center.Set(
+            corner.X() + tile.offset.X() + tileDims.X() * 0.5,
+            corner.Y() + tile.offset.Y() + tileDims.Y() * 0.5,
+            center.Z());
+
+        // Terra coordinates have the Y axis flipped
+        tile.worldMin.Set(tile.center.X() - tileDims.X() * 0.5,
+            -tile.center.Y() - tileDims.Y() * 0.5);
+        tile.worldMax.Set(tile.center.X() + tileDims.X() * 0.5,
+            -tile.center.Y() + tileDims.Y() * 0.5);
+      }
+    }
+
+    this->dataPtr->anchor = this->dataPtr->sceneManager->createManualObject();
+
+    gzmsg << "Heightmap [" << this->descriptor.Name() << "] split into "
+          << tileCount << "x" << tileCount << " tiles of " << tileSize
+          << "x" << tileSize << " samples" << std::endl;
+  }
+  else
+  {
+    this->dataPtr->terra = this->dataPtr->CreateTerra(
+        this->dataPtr->heights, newWidth, center, size,
+        this->descriptor.Name());
+    this->dataPtr->autoSkirtValue =
+        this->dataPtr->terra->getCustomSkirtMinHeight();
+    this->dataPtr->terra->setDatablock(this->dataPtr->CreateDatablock(
+        "GZ Terra " + this->name, this->descriptor, size,
+        math::Vector2d::Zero, true));
+  }
+
+  gzmsg << "Heightmap " << (loadedFromCache ? "loaded from cache [" +
+             cache->CacheFile() + "]" : std::string("loaded"))
+        << ". Process took "
         <<  std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::steady_clock::now() - time).count()
         << " ms." << std::endl;
@@ -396,21 +872,36 @@ void Ogre2Heightmap::Init()
 //////////////////////////////////////////////////
 void Ogre2Heightmap::PreRender()
 {
+  ++this->dataPtr->frame;
+
+  // Unload the tiles no camera got close to for a while
+  for (auto &tile : this->dataPtr->tiles)
+  {
+    if (this->dataPtr->frame - tile.lastUsedFrame <= kTileUnloadFrames)
+      continue;
+
+    if (tile.terra)
+    {
+      if (this->dataPtr->activeTerra == tile.terra.get())
+        this->dataPtr->activeTerra = nullptr;
+      tile.terra.reset();
+      tile.shadowLightDir = Ogre::Vector3::ZERO;
+    }
+
+    if (tile.pending.valid() && tile.pending.wait_for(
+        std::chrono::seconds(0)) == std::future_status::ready)
+    {
+      tile.pending = std::future<std::vector<float>>();
+    }
+  }
 }
 
 ///////////////////////////////////////////////////
-void Ogre2Heightmap::UpdateForRender(Ogre::Camera *_activeCamera)
+void Ogre2Heightmap::UpdateForRender(Ogre::Camera *_activeCamera,
+    bool _allDirections)
 {
-  if (this->dataPtr->skirtMinHeight >= 0)
-  {
-    this->dataPtr->terra->setCustomSkirtMinHeight(
-          this->dataPtr->skirtMinHeight);
-  }
-  else
-  {
-    this->dataPtr->terra->setCustomSkirtMinHeight(
-          this->dataPtr->autoSkirtValue);
-  }
+  if (!this->dataPtr->tiles.empty())
+    this->dataPtr->UpdateTiles(_activeCamera, this->descriptor);
 
   // Get the first directional light
   Ogre2DirectionalLightPtr directionalLight;
@@ -425,21 +916,70 @@ void Ogre2Heightmap::UpdateForRender(Ogre::Camera *_activeCamera)
     }
   }
 
-  this->dataPtr->terra->setCamera(_activeCamera);
-  if (directionalLight)
+  const Ogre::Vector3 lightDir = directionalLight ?
+      Ogre2Conversions::Convert(directionalLight->Direction())
+          .normalisedCopy() :
+      Ogre::Vector3::NEGATIVE_UNIT_Y;
+
+  // Terra ray marches its shadows every time it is updated with a new light
+  // direction. A large change is applied to all Terras right away, while
+  // a slowly moving sun only refreshes the shadows every
+  // kShadowRefreshFrames frames and one Terra per update, so the cost is
+  // spread over frames. A static sun never recomputes them.
+  auto &shadowDir = this->dataPtr->shadowLightDir;
+  const bool refreshAll = shadowDir == Ogre::Vector3::ZERO ||
+      shadowDir.dotProduct(lightDir) <
+      static_cast<Ogre::Real>(std::cos(kShadowRefreshAngle));
+  if (refreshAll ||
+      (shadowDir.dotProduct(lightDir) < 1.0f - 1e-6f &&
+       this->dataPtr->frame - this->dataPtr->shadowLightFrame >=
+       kShadowRefreshFrames))
   {
-    this->dataPtr->terra->update(
-          Ogre2Conversions::Convert(directionalLight->Direction()));
-  }
-  else
-  {
-    this->dataPtr->terra->update(Ogre::Vector3::NEGATIVE_UNIT_Y);
+    shadowDir = lightDir;
+    this->dataPtr->shadowLightFrame = this->dataPtr->frame;
   }
+  bool sliceUsed = false;
+
+  const Ogre::Vector3 cameraPos = _activeCamera->getDerivedPosition();
+  const Ogre::Real farClip = _activeCamera->getFarClipDistance();
+  const float skirtMinHeight = this->dataPtr->skirtMinHeight;
+  this->dataPtr->ForEachTerra(
+      [&](Ogre::Terra *_terra, float _autoSkirtValue,
+          Ogre::Vector3 &_terraShadowDir)
+      {
+        // A Terra beyond the far clip plane can't be seen by this camera,
+        // so there is no point in selecting its LOD cells
+        if (farClip > 0 && TerraDistance(_terra, cameraPos) > farClip)
+          return;
+
+        _terra->setCustomSkirtMinHeight(
+            skirtMinHeight >= 0 ? skirtMinHeight : _autoSkirtValue);
+        _terra->setFrustumCulling(!_allDirections);
+        _terra->setCamera(_activeCamera);
+
+        // Terras without shadows get them right away, the others catch up
+        // with shadowDir all at once or one per update
+        if (_terraShadowDir != shadowDir)
+        {
+          if (refreshAll || _terraShadowDir == Ogre::Vector3::ZERO)
+          {
+            _terraShadowDir = shadowDir;
+          }
+          else if (!sliceUsed)
+          {
+            _terraShadowDir = shadowDir;
+            sliceUsed = true;
+          }
+        }
+        _terra->update(_terraShadowDir);
+      });
 }
 
 //////////////////////////////////////////////////
 Ogre::MovableObject *Ogre2Heightmap::OgreObject() const
 {
+  if (this->dataPtr->anchor)
+    return this->dataPtr->anchor;
   return this->dataPtr->terra.get();
 }
 
@@ -458,5 +998,55 @@ MaterialPtr Ogre2Heightmap::Material() const
 //////////////////////////////////////////////////
 Ogre::Terra* Ogre2Heightmap::Terra()
 {
+  if (!this->dataPtr->tiles.empty())
+    return this->dataPtr->activeTerra;
   return this->dataPtr->terra.get();
 }
+
+//////////////////////////////////////////////////
+void Ogre2Heightmap::SetSolidColor(size_t _idx,
+    const Ogre::Vector4 &_solidColor)
+{
+  this->dataPtr->ForEachTerra(
+      [&](Ogre::Terra *_terra, float, Ogre::Vector3 &)
+      {
+        _terra->SetSolidColor(_idx, _solidColor);
+      });
+}
+
+//////////////////////////////////////////////////
+void Ogre2Heightmap::UnsetSolidColors()
+{
+  this->dataPtr->ForEachTerra(
+      [](Ogre::Terra *_terra, float, Ogre::Vector3 &)
+      {
+        _terra->UnsetSolidColors();
+      });
+}
+
+//////////////////////////////////////////////////
+bool Ogre2Heightmap::Intersect(const math::Vector3d &_origin,
+    const math::Vector3d &_direction, double &_t)
+{
+  if (this->dataPtr->heights.empty())
+    return false;
+
+  if (!this->dataPtr->rayCaster)
+  {
+    this->dataPtr->rayCaster = std::make_unique<Ogre2HeightmapRayCaster>(
+        this->dataPtr->heights, this->dataPtr->dataSize);
+  }
+
+  // Grid space keeps the ray parameter, so _t applies to the world ray
+  const math::Vector3d &origin = this->dataPtr->gridOrigin;
+  const math::Vector3d &scale = this->dataPtr->gridScale;
+  const math::Vector3d gridOrigin(
+      (_origin.X() - origin.X()) / scale.X(),
+      (origin.Y() - _origin.Y()) / scale.Y(),
+      (_origin.Z() - origin.Z()) / scale.Z());
+  const math::Vector3d gridDirection(
+      _direction.X() / scale.X(),
+      -_direction.Y() / scale.Y(),
+      _direction.Z() / scale.Z());
+  return this->dataPtr->rayCaster->Intersect(gridOrigin, gridDirection, _t);
+}
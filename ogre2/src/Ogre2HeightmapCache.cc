@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <fstream>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+
+#include "Ogre2DiskCacheUtil.hh"
+#include "Ogre2HeightmapCache.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+/// \brief Identifies a heightmap cache file ("GZHM")
+const uint32_t kMagic = 0x4d485a47u;
+
+/// \brief Version of the cache file layout. Increase it whenever the file
+/// layout or the way Ogre2Heightmap samples and normalizes heights changes.
+const uint32_t kVersion = 1u;
+
+/// \brief Header at the start of a cache file, followed by the heights
+struct FileHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t sourceSize;
+  uint64_t sourceHash;
+  uint32_t width;
+  uint32_t reserved;
+};
+}
+
+//////////////////////////////////////////////////
+Ogre2HeightmapCache::Ogre2HeightmapCache(const std::string &_cacheDir,
+    const std::string &_sourcePath, const std::string &_variant)
+{
+  uint64_t hash = kFnvOffset;
+  if (!HashFile(_sourcePath, hash, this->sourceSize))
+    return;
+  this->sourceHash = hash;
+
+  // entries are keyed by content, not by path
+  uint64_t key = Fnv1a(&this->sourceHash, sizeof(this->sourceHash));
+  key = Fnv1a(&this->sourceSize, sizeof(this->sourceSize), key);
+  key = Fnv1a(_variant.data(), _variant.size(), key);
+  this->cacheFile = common::joinPaths(_cacheDir,
+      CacheKeyString(key) + ".gzhm");
+}
+
+//////////////////////////////////////////////////
+std::string Ogre2HeightmapCache::CacheFile() const
+{
+  return this->cacheFile;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2HeightmapCache::Read(unsigned int _width,
+    std::vector<float> &_heights) const
+{
+  if (this->cacheFile.empty() || _width == 0u ||
+      !common::isFile(this->cacheFile))
+  {
+    return false;
+  }
+
+  std::ifstream file(this->cacheFile, std::ios::binary);
+  FileHeader header;
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+    return false;
+
+  // the file may be truncated, from another version or, in the unlikely
+  // case of a key collision, of another heightmap
+  if (header.magic != kMagic || header.version != kVersion ||
+      header.sourceSize != this->sourceSize ||
+      header.sourceHash != this->sourceHash ||
+      header.width != _width)
+  {
+    return false;
+  }
+
+  std::vector<float> heights(static_cast<size_t>(_width) * _width);
+  if (!file.read(reinterpret_cast<char *>(heights.data()),
+        static_cast<std::streamsize>(heights.size() * sizeof(float))))
+  {
+    return false;
+  }
+
+  _heights = std::move(heights);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2HeightmapCache::Write(unsigned int _width,
+    const std::vector<float> &_heights) const
+{
+  if (this->cacheFile.empty())
+    return false;
+
+  if (_width == 0u || _heights.size() != static_cast<size_t>(_width) * _width)
+  {
+    gzerr << "Invalid heights for cache file [" << this->cacheFile << "]"
+          << std::endl;
+    return false;
+  }
+
+  const std::string dir = common::parentPath(this->cacheFile);
+  if (!common::isDirectory(dir) && !common::createDirectories(dir))
+  {
+    gzwarn << "Unable to create heightmap cache directory [" << dir << "]"
+           << std::endl;
+    return false;
+  }
+
+  FileHeader header{};
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.sourceSize = this->sourceSize;
+  header.sourceHash = this->sourceHash;
+  header.width = _width;
+
+  return WriteCacheFile(this->cacheFile, "heightmap",
+      [&](std::ostream &_out)
+  {
+    _out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    _out.write(reinterpret_cast<const char *>(_heights.data()),
+        static_cast<std::streamsize>(_heights.size() * sizeof(float)));
+  });
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2HEIGHTMAPCACHE_HH_
+#define GZ_RENDERING_OGRE2_OGRE2HEIGHTMAPCACHE_HH_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Export.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Entry of the on-disk cache of processed heightmaps.
+    ///
+    /// An entry stores the sampled and normalized heights that
+    /// Ogre2Heightmap feeds to Terra, so that loading the same heightmap
+    /// again skips sampling the source data. It is keyed by the content
+    /// hash of the source file and a variant string describing how it is
+    /// sampled, so an edited file or a change of sampling, size or
+    /// elevation range gets a new entry.
+    class GZ_RENDERING_OGRE2_VISIBLE Ogre2HeightmapCache
+    {
+      /// \brief Constructor. Hashes the source file, which is much cheaper
+      /// than sampling it.
+      /// \param[in] _cacheDir Directory containing the cache files
+      /// \param[in] _sourcePath Path of the heightmap image or DEM file
+      /// \param[in] _variant Descriptor values that change the heights,
+      /// e.g. sampling and size
+      public: Ogre2HeightmapCache(const std::string &_cacheDir,
+                  const std::string &_sourcePath,
+                  const std::string &_variant);
+
+      /// \brief Read the heights of the cache file
+      /// \param[in] _width Expected number of samples along each side
+      /// \param[out] _heights Normalized heights, row by row
+      /// \return False if there is no valid cache file for the source
+      public: bool Read(unsigned int _width,
+                  std::vector<float> &_heights) const;
+
+      /// \brief Write the cache file. The file is written to a temporary
+      /// name and renamed, so concurrent readers never see a partial file.
+      /// \param[in] _width Number of samples along each side
+      /// \param[in] _heights Normalized heights, row by row
+      /// \return True if the file was written
+      public: bool Write(unsigned int _width,
+                  const std::vector<float> &_heights) const;
+
+      /// \brief Get the path of the cache file
+      /// \return Path of the cache file, empty if the source could not be
+      /// read
+      public: std::string CacheFile() const;
+
+      /// \brief Path of the cache file
+      private: std::string cacheFile;
+
+      /// \brief Size of the source file in bytes
+      private: uint64_t sourceSize = 0u;
+
+      /// \brief Content hash of the source file
+      private: uint64_t sourceHash = 0u;
+    };
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gz/common/Filesystem.hh>
+
+#include "Ogre2HeightmapCache.hh"
+#include "Ogre2TestDirectory.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/////////////////////////////////////////////////
+TEST(Ogre2HeightmapCache, RoundTrip)
+{
+  Ogre2TestDirectory dir("ogre2_heightmap_cache");
+  ASSERT_TRUE(dir.Valid());
+
+  const std::string source = dir.WriteFile("source.png", "source heightmap");
+  const std::string cacheDir = dir.Path("cache");
+
+  const unsigned int width = 4u;
+  std::vector<float> heights(width * width);
+  for (size_t i = 0u; i < heights.size(); ++i)
+    heights[i] = static_cast<float>(i) / heights.size();
+
+  std::string cacheFile;
+  {
+    Ogre2HeightmapCache cache(cacheDir, source, "sampling 1");
+    cacheFile = cache.CacheFile();
+    EXPECT_FALSE(cacheFile.empty());
+
+    std::vector<float> read;
+    EXPECT_FALSE(cache.Read(width, read));
+    EXPECT_TRUE(read.empty());
+
+    // the number of heights must match the width
+    EXPECT_FALSE(cache.Write(width + 1u, heights));
+    EXPECT_FALSE(common::isFile(cacheFile));
+
+    EXPECT_TRUE(cache.Write(width, heights));
+    EXPECT_TRUE(common::isFile(cacheFile));
+  }
+
+  {
+    Ogre2HeightmapCache cache(cacheDir, source, "sampling 1");
+    EXPECT_EQ(cacheFile, cache.CacheFile());
+    std::vector<float> read;
+    ASSERT_TRUE(cache.Read(width, read));
+    EXPECT_EQ(heights, read);
+
+    // another width is rejected
+    std::vector<float> other;
+    EXPECT_FALSE(cache.Read(width * 2u, other));
+    EXPECT_TRUE(other.empty());
+  }
+
+  // another variant uses another entry
+  {
+    Ogre2HeightmapCache cache(cacheDir, source, "sampling 2");
+    EXPECT_NE(cacheFile, cache.CacheFile());
+    std::vector<float> read;
+    EXPECT_FALSE(cache.Read(width, read));
+  }
+
+  // a file of another version is rejected. The version follows the 4 byte
+  // magic number.
+  {
+    std::fstream file(cacheFile,
+        std::ios::binary | std::ios::in | std::ios::out);
+    ASSERT_TRUE(file.is_open());
+    file.seekp(4);
+    const uint32_t version = 0xffffu;
+    file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+  }
+  {
+    Ogre2HeightmapCache cache(cacheDir, source, "sampling 1");
+    std::vector<float> read;
+    EXPECT_FALSE(cache.Read(width, read));
+    EXPECT_TRUE(cache.Write(width, heights));
+    EXPECT_TRUE(cache.Read(width, read));
+  }
+
+  // a file of another source is rejected, e.g. on a key collision. Copy
+  // the entry of the source to the entry of an edited source.
+  const std::string edited =
+      dir.WriteFile("edited.png", "edited heightmap");
+  {
+    Ogre2HeightmapCache cache(cacheDir, edited, "sampling 1");
+    EXPECT_NE(cacheFile, cache.CacheFile());
+    ASSERT_TRUE(common::copyFile(cacheFile, cache.CacheFile()));
+    std::vector<float> read;
+    EXPECT_FALSE(cache.Read(width, read));
+  }
+
+  // a source that can't be read is never cached
+  {
+    Ogre2HeightmapCache cache(cacheDir, dir.Path("missing"), "sampling 1");
+    EXPECT_TRUE(cache.CacheFile().empty());
+    std::vector<float> read;
+    EXPECT_FALSE(cache.Write(width, heights));
+    EXPECT_FALSE(cache.Read(width, read));
+  }
+}
@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "Ogre2HeightmapRayCaster.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+/// \brief Node of the hierarchy waiting to be visited
+struct Node
+{
+  /// \brief Level of the node
+  unsigned int level;
+
+  /// \brief Column of the node in its level
+  unsigned int x;
+
+  /// \brief Row of the node in its level
+  unsigned int y;
+
+  /// \brief Ray parameter where the ray enters the node bounds
+  double tEnter;
+};
+
+/// \brief Intersect a ray with an axis aligned box
+/// \param[in] _origin Origin of the ray
+/// \param[in] _direction Direction of the ray
+/// \param[in] _min Min corner of the box
+/// \param[in] _max Max corner of the box
+/// \param[out] _tEnter Ray parameter where the ray enters the box, clamped
+/// to 0 if the origin is inside
+/// \return True if the box is hit in front of the origin
+bool IntersectBox(const math::Vector3d &_origin,
+    const math::Vector3d &_direction, const math::Vector3d &_min,
+    const math::Vector3d &_max, double &_tEnter)
+{
+  double tMin = 0.0;
+  double tMax = std::numeric_limits<double>::max();
+  for (unsigned int i = 0u; i < 3u; ++i)
+  {
+    if (std::abs(_direction[i]) < 1e-12)
+    {
+      if (_origin[i] < _min[i] || _origin[i] > _max[i])
+        return false;
+      continue;
+    }
+
+    const double inv = 1.0 / _direction[i];
+    double t0 = (_min[i] - _origin[i]) * inv;
+    double t1 = (_max[i] - _origin[i]) * inv;
+    if (t0 > t1)
+      std::swap(t0, t1);
+    tMin = std::max(tMin, t0);
+    tMax = std::min(tMax, t1);
+    if (tMin > tMax)
+      return false;
+  }
+  _tEnter = tMin;
+  return true;
+}
+
+/// \brief Intersect a ray with a triangle, from both sides
+/// \param[in] _origin Origin of the ray
+/// \param[in] _direction Direction of the ray
+/// \param[in] _a First vertex
+/// \param[in] _b Second vertex
+/// \param[in] _c Third vertex
+/// \param[out] _t Ray parameter of the intersection
+/// \return True if the triangle is hit in front of the origin
+bool IntersectTriangle(const math::Vector3d &_origin,
+    const math::Vector3d &_direction, const math::Vector3d &_a,
+    const math::Vector3d &_b, const math::Vector3d &_c, double &_t)
+{
+  const math::Vector3d edge1 = _b - _a;
+  const math::Vector3d edge2 = _c - _a;
+  const math::Vector3d p = _direction.Cross(edge2);
+  const double det = edge1.Dot(p);
+  if (std::abs(det) < 1e-12)
+    return false;
+
+  const double invDet = 1.0 / det;
+  const math::Vector3d s = _origin - _a;
+  const double u = s.Dot(p) * invDet;
+  if (u < 0.0 || u > 1.0)
+    return false;
+
+  const math::Vector3d q = s.Cross(edge1);
+  const double v = _direction.Dot(q) * invDet;
+  if (v < 0.0 || u + v > 1.0)
+    return false;
+
+  _t = edge2.Dot(q) * invDet;
+  return _t >= 0.0;
+}
+}
+
+//////////////////////////////////////////////////
+Ogre2HeightmapRayCaster::Ogre2HeightmapRayCaster(
+    const std::vector<float> &_heights, unsigned int _size)
+  : heights(_heights), size(_size)
+{
+  if (this->size < 2u || this->heights.size() <
+      static_cast<size_t>(this->size) * this->size)
+  {
+    this->size = 0u;
+    return;
+  }
+
+  // level 0 holds the height range of each cell
+  Level cells;
+  cells.size = this->size - 1u;
+  cells.ranges.resize(static_cast<size_t>(cells.size) * cells.size);
+  for (unsigned int y = 0u; y < cells.size; ++y)
+  {
+    for (unsigned int x = 0u; x < cells.size; ++x)
+    {
+      const size_t i = static_cast<size_t>(y) * this->size + x;
+      const float h00 = this->heights[i];
+      const float h10 = this->heights[i + 1u];
+      const float h01 = this->heights[i + this->size];
+      const float h11 = this->heights[i + this->size + 1u];
+      Range &range = cells.ranges[static_cast<size_t>(y) * cells.size + x];
+      range.min = std::min({h00, h10, h01, h11});
+      range.max = std::max({h00, h10, h01, h11});
+    }
+  }
+  this->levels.push_back(std::move(cells));
+
+  // each following level merges 2x2 nodes of the previous one
+  while (this->levels.back().size > 1u)
+  {
+    const Level &prev = this->levels.back();
+    Level level;
+    level.size = (prev.size + 1u) / 2u;
+    level.ranges.resize(static_cast<size_t>(level.size) * level.size);
+    for (unsigned int y = 0u; y < level.size; ++y)
+    {
+      for (unsigned int x = 0u; x < level.size; ++x)
+      {
+        Range range{std::numeric_limits<float>::max(),
+                    std::numeric_limits<float>::lowest()};
+        for (unsigned int cy = 2u * y; cy < std::min(2u * y + 2u, prev.size);
+             ++cy)
+        {
+          for (unsigned int cx = 2u * x;
+               cx < std::min(2u * x + 2u, prev.size); ++cx)
+          {
+            const Range &child =
+                prev.ranges[static_cast<size_t>(cy) * prev.size + cx];
+            range.min = std::min(range.min, child.min);
+            range.max = std::max(range.max, child.max);
+          }
+        }
+        level.ranges[static_cast<size_t>(y) * level.size + x] = range;
+      }
+    }
+    this->levels.push_back(std::move(level));
+  }
+}
+
+//////////////////////////////////////////////////
+bool Ogre2HeightmapRayCaster::Intersect(const math::Vector3d &_origin,
+    const math::Vector3d &_direction, double &_t) const
+{
+  if (this->levels.empty() || _direction == math::Vector3d::Zero)
+    return false;
+
+  const unsigned int cellCount = this->size - 1u;
+  double best = std::numeric_limits<double>::max();
+
+  // Visit nodes front to back. A node is only opened if the ray enters its
+  // bounds before the closest hit found so far.
+  std::vector<Node> stack;
+  stack.push_back({static_cast<unsigned int>(this->levels.size() - 1u),
+      0u, 0u, 0.0});
+  std::vector<Node> children;
+  while (!stack.empty())
+  {
+    const Node node = stack.back();
+    stack.pop_back();
+    if (node.tEnter >= best)
+      continue;
+
+    if (node.level == 0u)
+    {
+      this->IntersectCell(_origin, _direction, node.x, node.y, best);
+      continue;
+    }
+
+    const unsigned int childLevel = node.level - 1u;
+    const Level &level = this->levels[childLevel];
+    const unsigned int span = 1u << childLevel;
+    children.clear();
+    for (unsigned int cy = 2u * node.y;
+         cy < std::min(2u * node.y + 2u, level.size); ++cy)
+    {
+      for (unsigned int cx = 2u * node.x;
+           cx < std::min(2u * node.x + 2u, level.size); ++cx)
+      {
+        const Range &range =
+            level.ranges[static_cast<size_t>(cy) * level.size + cx];
+        const math::Vector3d min(cx * span, cy * span, range.min);
+        const math::Vector3d max(std::min((cx + 1u) * span, cellCount),
+            std::min((cy + 1u) * span, cellCount), range.max);
+        double tEnter;
+        if (IntersectBox(_origin, _direction, min, max, tEnter) &&
+            tEnter < best)
+        {
+          children.push_back({childLevel, cx, cy, tEnter});
+        }
+      }
+    }
+
+    // push the farthest first so the closest is visited next
+    std::sort(children.begin(), children.end(),
+        [](const Node &_a, const Node &_b)
+        {
+          return _a.tEnter > _b.tEnter;
+        });
+    stack.insert(stack.end(), children.begin(), children.end());
+  }
+
+  if (best == std::numeric_limits<double>::max())
+    return false;
+  _t = best;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2HeightmapRayCaster::IntersectCell(const math::Vector3d &_origin,
+    const math::Vector3d &_direction, unsigned int _x, unsigned int _y,
+    double &_t) const
+{
+  const size_t i = static_cast<size_t>(_y) * this->size + _x;
+  const math::Vector3d p00(_x, _y, this->heights[i]);
+  const math::Vector3d p10(_x + 1.0, _y, this->heights[i + 1u]);
+  const math::Vector3d p01(_x, _y + 1.0, this->heights[i + this->size]);
+  const math::Vector3d p11(_x + 1.0, _y + 1.0,
+      this->heights[i + this->size + 1u]);
+
+  bool hit = false;
+  double t;
+  if (IntersectTriangle(_origin, _direction, p00, p10, p11, t) && t < _t)
+  {
+    _t = t;
+    hit = true;
+  }
+  if (IntersectTriangle(_origin, _direction, p00, p11, p01, t) && t < _t)
+  {
+    _t = t;
+    hit = true;
+  }
+  return hit;
+}
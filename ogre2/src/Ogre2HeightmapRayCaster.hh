@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2HEIGHTMAPRAYCASTER_HH_
+#define GZ_RENDERING_OGRE2_OGRE2HEIGHTMAPRAYCASTER_HH_
+
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+#include "gz/rendering/config.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Intersects rays with a height grid on the CPU.
+    ///
+    /// The grid is made of square cells between neighbouring samples, each
+    /// split into two triangles. A hierarchy of min / max heights, where
+    /// each level covers 2x2 nodes of the level below, lets a ray skip the
+    /// regions it passes above or below. Nodes are visited front to back,
+    /// so the traversal stops at the first cell the ray hits.
+    ///
+    /// All coordinates are in grid space: sample (i, j) of height h is at
+    /// (i, j, h).
+    class Ogre2HeightmapRayCaster
+    {
+      /// \brief Constructor. Builds the min / max hierarchy.
+      /// \param[in] _heights Heights, row by row. They are not copied and
+      /// must outlive the ray caster.
+      /// \param[in] _size Number of samples along each side
+      public: Ogre2HeightmapRayCaster(const std::vector<float> &_heights,
+                  unsigned int _size);
+
+      /// \brief Find the closest intersection of a ray with the grid
+      /// \param[in] _origin Origin of the ray, in grid space
+      /// \param[in] _direction Direction of the ray, in grid space. It
+      /// does not need to be normalized.
+      /// \param[out] _t Ray parameter of the intersection, i.e. the point
+      /// is _origin + _direction * _t
+      /// \return True if the ray hits the grid in front of its origin
+      public: bool Intersect(const math::Vector3d &_origin,
+                  const math::Vector3d &_direction, double &_t) const;
+
+      /// \brief Intersect a ray with the two triangles of a cell
+      /// \param[in] _origin Origin of the ray
+      /// \param[in] _direction Direction of the ray
+      /// \param[in] _x Column of the cell
+      /// \param[in] _y Row of the cell
+      /// \param[in,out] _t Closest ray parameter found so far, updated if
+      /// the cell is hit closer
+      /// \return True if the cell is hit closer than _t
+      private: bool IntersectCell(const math::Vector3d &_origin,
+                  const math::Vector3d &_direction, unsigned int _x,
+                  unsigned int _y, double &_t) const;
+
+      /// \brief Height range of a node of the hierarchy
+      private: struct Range
+      {
+        /// \brief Lowest height
+        float min;
+
+        /// \brief Highest height
+        float max;
+      };
+
+      /// \brief Level of the hierarchy
+      private: struct Level
+      {
+        /// \brief Number of nodes along each side
+        unsigned int size;
+
+        /// \brief Height range of the nodes, row by row
+        std::vector<Range> ranges;
+      };
+
+      /// \brief Heights, row by row
+      private: const std::vector<float> &heights;
+
+      /// \brief Number of samples along each side
+      private: unsigned int size = 0u;
+
+      /// \brief Levels of the hierarchy. Level 0 has one node per cell and
+      /// the last level has a single node.
+      private: std::vector<Level> levels;
+    };
+    }
+  }
+}
+
+#endif
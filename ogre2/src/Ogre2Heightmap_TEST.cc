@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Image.hh>
+#include <gz/common/geospatial/ImageHeightmap.hh>
+
+#include <gz/math/Vector3.hh>
+
+#include "gz/rendering/Camera.hh"
+#include "gz/rendering/HeightmapDescriptor.hh"
+#include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
+#include "gz/rendering/ogre2/Ogre2Heightmap.hh"
+#include "gz/rendering/ogre2/Ogre2Includes.hh"
+#include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
+#include "Ogre2TestDirectory.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+/// \brief Directory of the heightmap cache. The engine is loaded once per
+/// process, so the tests share it.
+/// \return The directory
+const Ogre2TestDirectory &CacheDirectory()
+{
+  static const Ogre2TestDirectory dir("ogre2_heightmap_cache");
+  return dir;
+}
+
+/// \brief Load the engine, with the heightmap cache in the test directory
+/// \return The engine, null if it could not be initialized
+Ogre2RenderEngine *LoadEngine()
+{
+  Ogre2RenderEngine *engine = Ogre2RenderEngine::Instance();
+  if (!engine->IsInitialized())
+  {
+    std::map<std::string, std::string> params;
+    params["heightmapCachePath"] = CacheDirectory().Path("cache");
+    if (!engine->Load(params) || !engine->Init())
+      return nullptr;
+  }
+  return engine;
+}
+
+/// \brief Write a 129x129 image sloping along x
+/// \param[in] _path Path of the image
+void WriteSlopeImage(const std::string &_path)
+{
+  const unsigned int width = 129u;
+  std::vector<unsigned char> pixels(width * width * 3u);
+  for (unsigned int i = 0; i < width * width; ++i)
+  {
+    const auto value = static_cast<unsigned char>(i % width);
+    pixels[i * 3u] = value;
+    pixels[i * 3u + 1u] = value;
+    pixels[i * 3u + 2u] = value;
+  }
+  common::Image image;
+  image.SetFromData(pixels.data(), width, width, common::Image::RGB_INT8);
+  image.SavePNG(_path);
+}
+}
+
+/////////////////////////////////////////////////
+TEST(Ogre2Heightmap, Tiles)
+{
+  Ogre2RenderEngine *engine = LoadEngine();
+  if (!engine)
+    GTEST_SKIP() << "Unable to initialize the ogre2 render engine";
+
+  Ogre2TestDirectory dir("ogre2_heightmap");
+  ASSERT_TRUE(dir.Valid());
+  const std::string imagePath = dir.Path("slope.png");
+  WriteSlopeImage(imagePath);
+
+  auto data = std::make_shared<common::ImageHeightmap>();
+  ASSERT_EQ(0, data->Load(imagePath));
+
+  ScenePtr scene = engine->CreateScene("tiled_heightmap");
+  ASSERT_NE(nullptr, scene);
+
+  HeightmapDescriptor desc;
+  desc.SetName("tiled_slope");
+  desc.SetData(data);
+  desc.SetSize({128.0, 128.0, 10.0});
+  desc.SetTileSize(32u);
+  desc.SetTileLoadDistance(10.0);
+
+  auto heightmap = std::dynamic_pointer_cast<Ogre2Heightmap>(
+      scene->CreateHeightmap(desc));
+  ASSERT_NE(nullptr, heightmap);
+
+  VisualPtr vis = scene->CreateVisual();
+  vis->AddGeometry(heightmap);
+  scene->RootVisual()->AddChild(vis);
+
+  // The tiles are attached next to an empty anchor object
+  Ogre::SceneNode *node = heightmap->OgreObject()->getParentSceneNode();
+  ASSERT_NE(nullptr, node);
+  EXPECT_EQ(1u, node->numAttachedObjects());
+  EXPECT_EQ(nullptr, heightmap->Terra());
+
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(32u);
+  camera->SetImageHeight(32u);
+  scene->RootVisual()->AddChild(camera);
+
+  // Only the tiles near the camera corner of the heightmap get loaded
+  camera->SetLocalPosition(-60.0, -60.0, 20.0);
+  camera->Update();
+  EXPECT_NE(nullptr, heightmap->Terra());
+  const size_t loadedCount = node->numAttachedObjects() - 1u;
+  EXPECT_LT(0u, loadedCount);
+  EXPECT_GT(16u, loadedCount);
+
+  // No tile in range far away, but the loaded tiles are kept for a while
+  camera->SetLocalPosition(1000.0, 1000.0, 20.0);
+  camera->Update();
+  EXPECT_EQ(nullptr, heightmap->Terra());
+  EXPECT_EQ(loadedCount + 1u, node->numAttachedObjects());
+
+  // Tiles are unloaded kTileUnloadFrames (60) frames after they were last
+  // in range of a camera
+  for (unsigned int i = 0; i < 60u; ++i)
+    camera->Update();
+  EXPECT_EQ(1u, node->numAttachedObjects());
+  EXPECT_EQ(nullptr, heightmap->Terra());
+
+  // Coming back loads the tiles again
+  camera->SetLocalPosition(-60.0, -60.0, 20.0);
+  camera->Update();
+  EXPECT_NE(nullptr, heightmap->Terra());
+  EXPECT_EQ(loadedCount + 1u, node->numAttachedObjects());
+
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST(Ogre2Heightmap, Cache)
+{
+  Ogre2RenderEngine *engine = LoadEngine();
+  if (!engine)
+    GTEST_SKIP() << "Unable to initialize the ogre2 render engine";
+  const std::string cacheDir = engine->HeightmapCachePath();
+  ASSERT_FALSE(cacheDir.empty());
+
+  // drop the entries of the other tests
+  std::filesystem::remove_all(cacheDir);
+
+  Ogre2TestDirectory dir("ogre2_heightmap");
+  ASSERT_TRUE(dir.Valid());
+  const std::string imagePath = dir.Path("slope.png");
+  WriteSlopeImage(imagePath);
+
+  auto data = std::make_shared<common::ImageHeightmap>();
+  ASSERT_EQ(0, data->Load(imagePath));
+
+  ScenePtr scene = engine->CreateScene("cached_heightmap");
+  ASSERT_NE(nullptr, scene);
+
+  HeightmapDescriptor desc;
+  desc.SetName("slope");
+  desc.SetData(data);
+  desc.SetSize({128.0, 128.0, 10.0});
+
+  auto cacheFileCount = [&]()
+  {
+    size_t count = 0u;
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(cacheDir, ec);
+         !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+    {
+      if (it->path().extension() == ".gzhm")
+        ++count;
+    }
+    return count;
+  };
+
+  // the first load samples the image and writes the cache
+  EXPECT_EQ(0u, cacheFileCount());
+  auto sampled = std::dynamic_pointer_cast<Ogre2Heightmap>(
+      scene->CreateHeightmap(desc));
+  ASSERT_NE(nullptr, sampled);
+  EXPECT_EQ(1u, cacheFileCount());
+
+  // the second load reads the cache
+  auto cached = std::dynamic_pointer_cast<Ogre2Heightmap>(
+      scene->CreateHeightmap(desc));
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(1u, cacheFileCount());
+
+  // both have the same heights
+  const math::Vector3d down = -math::Vector3d::UnitZ;
+  for (double x = -60.0; x <= 60.0; x += 7.5)
+  {
+    for (double y = -60.0; y <= 60.0; y += 7.5)
+    {
+      const math::Vector3d origin(x, y, 100.0);
+      double sampledT = 0.0;
+      double cachedT = 0.0;
+      ASSERT_TRUE(sampled->Intersect(origin, down, sampledT));
+      ASSERT_TRUE(cached->Intersect(origin, down, cachedT));
+      EXPECT_DOUBLE_EQ(sampledT, cachedT) << origin;
+    }
+  }
+
+  // the slope rises along x
+  double lowT = 0.0;
+  double highT = 0.0;
+  ASSERT_TRUE(cached->Intersect({-60.0, 0.0, 100.0}, down, lowT));
+  ASSERT_TRUE(cached->Intersect({60.0, 0.0, 100.0}, down, highT));
+  EXPECT_GT(lowT, highT);
+
+  engine->DestroyScene(scene);
+}
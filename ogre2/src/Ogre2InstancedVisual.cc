@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/math/Color.hh>
+
+#include "gz/rendering/ogre2/Ogre2Conversions.hh"
+#include "gz/rendering/ogre2/Ogre2InstancedVisual.hh"
+#include "gz/rendering/ogre2/Ogre2Mesh.hh"
+#include "gz/rendering/ogre2/Ogre2ParticleEmitter.hh"
+#include "gz/rendering/ogre2/Ogre2Scene.hh"
+#include "gz/rendering/Utils.hh"
+
+#include "Ogre2GzHlmsSharedPrivate.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreItem.h>
+#include <OgreSceneManager.h>
+#include <OgreSceneNode.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+/// \brief Key of the user any holding the instance index of an item
+static const char kInstanceUserAnyKey[] = "gz_instance";
+
+/// \brief Private data for the Ogre2InstancedVisual class
+class gz::rendering::Ogre2InstancedVisualPrivate
+{
+  /// \brief Descriptor of the mesh shared by all instances
+  public: MeshDescriptor desc;
+
+  /// \brief Material of the instances, may be null
+  public: MaterialPtr material;
+
+  /// \brief Number of instances
+  public: unsigned int capacity = 0u;
+
+  /// \brief Mesh the instances are created from. It is never attached,
+  /// it only owns the materials set on the instance sub items.
+  public: Ogre2MeshPtr mesh;
+
+  /// \brief Ogre item of each instance
+  public: std::vector<Ogre::Item *> items;
+
+  /// \brief Ogre scene node of each instance
+  public: std::vector<Ogre::SceneNode *> nodes;
+
+  /// \brief Whether each instance item carries a tint
+  public: std::vector<bool> tinted;
+
+  /// \brief Visibility of the whole visual
+  public: bool visible = true;
+};
+
+using namespace gz;
+using namespace rendering;
+
+//////////////////////////////////////////////////
+/// \brief Set the tint of an instance item. Only tinted items carry the
+/// tint custom parameter, which selects the gz_instance_color shader
+/// variant and a per object buffer write on every draw, so untinted
+/// items are drawn like any other item.
+/// \param[in] _item Instance item
+/// \param[in] _color Tint color, white removes the tint
+/// \param[in] _tinted True if the item is currently tinted
+/// \return True if the item is tinted after the call
+static bool SetItemTint(Ogre::Item *_item, const math::Color &_color,
+    bool _tinted)
+{
+  const bool tinted = _color != math::Color::White;
+  const Ogre::Vector4 tint(_color.R(), _color.G(), _color.B(), _color.A());
+  for (size_t s = 0u; s < _item->getNumSubItems(); ++s)
+  {
+    Ogre::SubItem *subItem = _item->getSubItem(s);
+    if (tinted)
+      subItem->setCustomParameter(kInstanceColorCustomParameter, tint);
+    else if (_tinted)
+      subItem->removeCustomParameter(kInstanceColorCustomParameter);
+
+    // the shader variant is selected when the material is set
+    if (tinted != _tinted)
+    {
+      if (!subItem->getMaterial().isNull())
+        subItem->setMaterial(subItem->getMaterial());
+      else
+        subItem->setDatablock(subItem->getDatablock());
+    }
+  }
+  return tinted;
+}
+
+//////////////////////////////////////////////////
+Ogre2InstancedVisual::Ogre2InstancedVisual(const MeshDescriptor &_desc,
+    MaterialPtr _material, unsigned int _capacity)
+  : dataPtr(new Ogre2InstancedVisualPrivate)
+{
+  this->dataPtr->desc = _desc;
+  this->dataPtr->material = _material;
+  this->dataPtr->capacity = _capacity;
+}
+
+//////////////////////////////////////////////////
+Ogre2InstancedVisual::~Ogre2InstancedVisual()
+{
+}
+
+//////////////////////////////////////////////////
+void Ogre2InstancedVisual::Init()
+{
+  BaseInstancedVisual::Init();
+  this->SetCapacity(this->dataPtr->capacity);
+  this->CreateInstances();
+}
+
+//////////////////////////////////////////////////
+void Ogre2InstancedVisual::CreateInstances()
+{
+  MeshPtr mesh = this->scene->CreateMesh(this->dataPtr->desc);
+  this->dataPtr->mesh = std::dynamic_pointer_cast<Ogre2Mesh>(mesh);
+  if (!this->dataPtr->mesh)
+  {
+    gzerr << "Unable to create the mesh of instanced visual ["
+          << this->Name() << "]" << std::endl;
+    return;
+  }
+  if (this->dataPtr->material)
+    this->dataPtr->mesh->SetMaterial(this->dataPtr->material, false);
+
+  Ogre::Item *templateItem =
+      dynamic_cast<Ogre::Item *>(this->dataPtr->mesh->OgreObject());
+  if (!templateItem)
+  {
+    gzerr << "Instanced visual [" << this->Name() << "] requires a mesh "
+          << "backed by an ogre item" << std::endl;
+    return;
+  }
+
+  Ogre::SceneManager *sceneManager = this->scene->OgreSceneManager();
+  const std::string meshName = templateItem->getMesh()->getName();
+  const uint32_t flags = this->VisibilityFlags() &
+      ~Ogre2ParticleEmitter::kParticleVisibilityFlags;
+
+  this->dataPtr->items.reserve(this->dataPtr->capacity);
+  this->dataPtr->nodes.reserve(this->dataPtr->capacity);
+  this->dataPtr->tinted.assign(this->dataPtr->capacity, false);
+  for (unsigned int i = 0u; i < this->dataPtr->capacity; ++i)
+  {
+    Ogre::Item *item = this->scene->AcquireOgreItem(meshName);
+    if (!item)
+      item = sceneManager->createItem(templateItem->getMesh());
+
+    // instances start untinted, a tint is only added once one is set
+    for (size_t s = 0u; s < item->getNumSubItems(); ++s)
+    {
+      Ogre::SubItem *subItem = item->getSubItem(s);
+      Ogre::SubItem *templateSubItem = templateItem->getSubItem(s);
+      if (!templateSubItem->getMaterial().isNull())
+        subItem->setMaterial(templateSubItem->getMaterial());
+      else
+        subItem->setDatablock(templateSubItem->getDatablock());
+    }
+
+    // set user data for mouse queries
+    item->getUserObjectBindings().setUserAny(Ogre::Any(this->Id()));
+    item->getUserObjectBindings().setUserAny(kInstanceUserAnyKey,
+        Ogre::Any(i));
+    item->setName(this->Name() + "::" + std::to_string(i));
+    item->setVisibilityFlags(flags);
+    item->setCastShadows(templateItem->getCastShadows());
+
+    Ogre::SceneNode *node = this->scene->AcquireOgreSceneNode();
+    this->ogreNode->addChild(node);
+    node->attachObject(item);
+
+    this->dataPtr->items.push_back(item);
+    this->dataPtr->nodes.push_back(node);
+    this->MarkInstanceDirty(i);
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2InstancedVisual::PreRender()
+{
+  for (unsigned int index : this->dirtyInstances)
+  {
+    if (index >= this->dataPtr->nodes.size())
+      continue;
+
+    Ogre::SceneNode *node = this->dataPtr->nodes[index];
+    const math::Pose3d &pose = this->instancePoses[index];
+    node->setPosition(Ogre2Conversions::Convert(pose.Pos()));
+    node->setOrientation(Ogre2Conversions::Convert(pose.Rot()));
+    node->setScale(Ogre2Conversions::Convert(this->instanceScales[index]));
+
+    Ogre::Item *item = this->dataPtr->items[index];
+    item->setVisible(this->dataPtr->visible &&
+        this->instanceVisible[index] != 0u);
+
+    this->dataPtr->tinted[index] = SetItemTint(item,
+        this->instanceColors[index], this->dataPtr->tinted[index]);
+  }
+  this->ClearDirtyInstances();
+
+  BaseInstancedVisual::PreRender();
+}
+
+//////////////////////////////////////////////////
+void Ogre2InstancedVisual::Destroy()
+{
+  // pooled items go back untinted, so a visual reusing one does not get
+  // the tinted shader variant
+  for (size_t i = 0u; i < this->dataPtr->items.size(); ++i)
+  {
+    Ogre::Item *item = this->dataPtr->items[i];
+    item->getUserObjectBindings().eraseUserAny(kInstanceUserAnyKey);
+    SetItemTint(item, math::Color::White, this->dataPtr->tinted[i]);
+    this->scene->ReleaseOgreItem(item);
+  }
+  this->dataPtr->items.clear();
+  this->dataPtr->tinted.clear();
+
+  for (Ogre::SceneNode *node : this->dataPtr->nodes)
+    this->scene->ReleaseOgreSceneNode(node);
+  this->dataPtr->nodes.clear();
+
+  if (this->dataPtr->mesh)
+  {
+    this->dataPtr->mesh->Destroy();
+    this->dataPtr->mesh.reset();
+  }
+  this->dataPtr->material.reset();
+
+  BaseInstancedVisual::Destroy();
+}
+
+//////////////////////////////////////////////////
+void Ogre2InstancedVisual::SetVisible(bool _visible)
+{
+  BaseInstancedVisual::SetVisible(_visible);
+  this->dataPtr->visible = _visible;
+
+  // showing the node shows all the items below it
+  for (size_t i = 0u; i < this->dataPtr->items.size(); ++i)
+  {
+    if (!this->instanceVisible[i])
+      this->dataPtr->items[i]->setVisible(false);
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2InstancedVisual::SetVisibilityFlags(uint32_t _flags)
+{
+  BaseInstancedVisual::SetVisibilityFlags(_flags);
+
+  for (Ogre::Item *item : this->dataPtr->items)
+  {
+    item->setVisibilityFlags(_flags
+      & ~Ogre2ParticleEmitter::kParticleVisibilityFlags);
+  }
+}
+
+//////////////////////////////////////////////////
+math::AxisAlignedBox Ogre2InstancedVisual::LocalBoundingBox() const
+{
+  math::AxisAlignedBox box = BaseInstancedVisual::LocalBoundingBox();
+  this->InstancesBoundingBox(box, math::Pose3d::Zero);
+  return box;
+}
+
+//////////////////////////////////////////////////
+math::AxisAlignedBox Ogre2InstancedVisual::BoundingBox() const
+{
+  math::AxisAlignedBox box = BaseInstancedVisual::BoundingBox();
+  this->InstancesBoundingBox(box, this->WorldPose());
+  return box;
+}
+
+//////////////////////////////////////////////////
+void Ogre2InstancedVisual::InstancesBoundingBox(math::AxisAlignedBox &_box,
+    const math::Pose3d &_pose) const
+{
+  if (this->dataPtr->items.empty())
+    return;
+
+  const Ogre::Aabb aabb = this->dataPtr->items[0]->getLocalAabb();
+  const math::Vector3d meshMin =
+      Ogre2Conversions::Convert(aabb.getMinimum());
+  const math::Vector3d meshMax =
+      Ogre2Conversions::Convert(aabb.getMaximum());
+  const math::Vector3d scale = this->WorldScale();
+
+  for (unsigned int i = 0u; i < this->Capacity(); ++i)
+  {
+    if (!this->instanceVisible[i])
+      continue;
+
+    const math::Vector3d instanceScale = scale * this->instanceScales[i];
+    math::AxisAlignedBox instanceBox(
+        instanceScale * meshMin, instanceScale * meshMax);
+    math::Pose3d pose = this->instancePoses[i];
+    pose.Pos() *= scale;
+    _box.Merge(transformAxisAlignedBox(instanceBox, pose * _pose));
+  }
+}
+
+//////////////////////////////////////////////////
+bool Ogre2InstancedVisual::InstanceIndex(const Ogre::MovableObject *_object,
+    unsigned int &_index)
+{
+  if (!_object)
+    return false;
+
+  const Ogre::Any &any =
+      _object->getUserObjectBindings().getUserAny(kInstanceUserAnyKey);
+  if (any.isEmpty() || any.getType() != typeid(unsigned int))
+    return false;
+
+  _index = Ogre::any_cast<unsigned int>(any);
+  return true;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/math/Color.hh>
+
+#include "gz/rendering/MeshDescriptor.hh"
+#include "gz/rendering/Scene.hh"
+#include "gz/rendering/ogre2/Ogre2Includes.hh"
+#include "gz/rendering/ogre2/Ogre2InstancedVisual.hh"
+#include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
+
+#include "Ogre2GzHlmsSharedPrivate.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/////////////////////////////////////////////////
+TEST(Ogre2InstancedVisual, Tint)
+{
+  Ogre2RenderEngine *engine = Ogre2RenderEngine::Instance();
+  if (!engine->IsInitialized())
+  {
+    std::map<std::string, std::string> params;
+    if (!engine->Load(params) || !engine->Init())
+      GTEST_SKIP() << "Unable to initialize the ogre2 render engine";
+  }
+
+  ScenePtr scene = engine->CreateScene("instanced_visual_tint");
+  ASSERT_NE(nullptr, scene);
+
+  auto visual = std::dynamic_pointer_cast<Ogre2InstancedVisual>(
+      scene->CreateInstancedVisual(MeshDescriptor("unit_box"),
+      scene->CreateMaterial(), 3u));
+  ASSERT_NE(nullptr, visual);
+  scene->RootVisual()->AddChild(visual);
+
+  // items of the instances, by instance index
+  std::vector<Ogre::Item *> items(visual->Capacity(), nullptr);
+  Ogre::SceneNode *node = visual->Node();
+  ASSERT_NE(nullptr, node);
+  for (size_t i = 0u; i < node->numChildren(); ++i)
+  {
+    auto child = dynamic_cast<Ogre::SceneNode *>(node->getChild(i));
+    ASSERT_NE(nullptr, child);
+    ASSERT_EQ(1u, child->numAttachedObjects());
+    unsigned int index = 0u;
+    ASSERT_TRUE(Ogre2InstancedVisual::InstanceIndex(
+        child->getAttachedObject(0), index));
+    ASSERT_LT(index, items.size());
+    items[index] = dynamic_cast<Ogre::Item *>(child->getAttachedObject(0));
+  }
+
+  // count the sub items that carry a tint
+  auto tintCount = [&](unsigned int _index)
+  {
+    size_t count = 0u;
+    for (size_t s = 0u; s < items[_index]->getNumSubItems(); ++s)
+    {
+      if (items[_index]->getSubItem(s)->hasCustomParameter(
+          kInstanceColorCustomParameter))
+      {
+        ++count;
+      }
+    }
+    return count;
+  };
+
+  // untinted instances don't select the tinted shader variant
+  scene->PreRender();
+  for (unsigned int i = 0u; i < visual->Capacity(); ++i)
+  {
+    ASSERT_NE(nullptr, items[i]);
+    EXPECT_EQ(0u, tintCount(i)) << i;
+  }
+
+  // only the tinted instance gets the tint
+  visual->SetInstanceColor(1u, math::Color::Red);
+  scene->PreRender();
+  EXPECT_EQ(0u, tintCount(0u));
+  EXPECT_EQ(items[1]->getNumSubItems(), tintCount(1u));
+  EXPECT_EQ(0u, tintCount(2u));
+  EXPECT_EQ(Ogre::Vector4(1, 0, 0, 1), items[1]->getSubItem(0)->
+      getCustomParameter(kInstanceColorCustomParameter));
+
+  // white removes it again
+  visual->SetInstanceColor(1u, math::Color::White);
+  scene->PreRender();
+  EXPECT_EQ(0u, tintCount(1u));
+
+  engine->DestroyScene(scene);
+}
@@ -520,4 +520,5 @@ void Ogre2LidarVisual::SetVisible(bool _visible)
 {
   this->dataPtr->visible = _visible;
   this->ogreNode->setVisible(this->dataPtr->visible);
+  this->RecordChange(SceneChangeType::VISIBILITY_CHANGED, this->Id());
 }
@@ -49,6 +49,7 @@
 #include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
 #include "gz/rendering/ogre2/Ogre2Scene.hh"
 
+#include "Ogre2TexturePipeline.hh"
 
 /// \brief Private data for the Ogre2Material class
 class gz::rendering::Ogre2MaterialPrivate
@@ -1094,9 +1095,26 @@ void Ogre2Material::SetTextureMapImpl(const std::string &_texture,
   Ogre::TextureGpuManager *textureMgr =
       root->getRenderSystem()->getTextureGpuManager();
 
+  // with the texture cache enabled, the image is converted once to a
+  // mipmapped, compressed RGBA texture, which also takes care of grayscale
+  // images
+  bool converted = false;
+  const std::string cachePath =
+      Ogre2RenderEngine::Instance()->TextureCachePath();
+  if (!cachePath.empty())
+  {
+    Ogre2TexturePipeline::Options options;
+    options.srgb = this->ogreDatablock->suggestUsingSRGB(_type);
+    options.normalMap = _type == Ogre::PBSM_NORMAL;
+    options.compressColor = true;
+    options.compressNormals = true;
+    converted = Ogre2TexturePipeline::Load(root->getRenderSystem(),
+        _texture, baseName, cachePath, options) != nullptr;
+  }
+
   // workaround for grayscale emissive texture
   // convert to RGB otherwise the emissive map is rendered red
-  if (_type == Ogre::PBSM_EMISSIVE &&
+  if (!converted && _type == Ogre::PBSM_EMISSIVE &&
       !this->ogreDatablock->getUseEmissiveAsLightmap())
   {
     common::Image img(_texture);
@@ -1112,23 +1130,9 @@ void Ogre2Material::SetTextureMapImpl(const std::string &_texture,
       {
         gzmsg << "Grayscale emissive texture detected. Converting to RGB: "
                << rgbTexName << std::endl;
-        // need to be 4 channels for gpu texture
-        unsigned int channels = 4u;
-        unsigned int size = img.Width() * img.Height() * channels;
-        unsigned char *data = new unsigned char[size];
-        for (unsigned int i = 0; i < img.Height(); ++i)
-        {
-          for (unsigned int j = 0; j < img.Width(); ++j)
-          {
-            // flip Y
-            math::Color c = img.Pixel(j, img.Height() - i - 1u);
-            unsigned int idx = i * img.Width() * channels + j * channels;
-            data[idx] = static_cast<uint8_t>(c.R() * 255u);
-            data[idx + 1u] = static_cast<uint8_t>(c.R() * 255u);
-            data[idx + 2u] = static_cast<uint8_t>(c.R() * 255u);
-            data[idx + 3u] = 255u;
-          }
-        }
+        // need to be 4 channels for gpu texture. The whole image is
+        // expanded at once, which replicates the gray level to RGB.
+        std::vector<unsigned char> data = img.RGBAData();
 
         // create the gpu texture
         Ogre::uint32 textureFlags = 0;
@@ -1152,9 +1156,8 @@ void Ogre2Material::SetTextureMapImpl(const std::string &_texture,
 
         // upload raw color image data to gpu texture
         Ogre::Image2 image;
-        image.loadDynamicImage(data, false, texture);
+        image.loadDynamicImage(data.data(), false, texture);
         image.uploadTo(texture, 0, 0);
-        delete [] data;
       }
     }
   }
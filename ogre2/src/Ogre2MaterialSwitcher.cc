@@ -61,6 +61,9 @@ void Ogre2MaterialSwitcher::cameraPreRenderScene(
   auto engine = Ogre2RenderEngine::Instance();
   engine->SetGzOgreRenderingMode(GORM_SOLID_COLOR);
 
+  // batches merge visuals, so render each visual on its own
+  this->scene->SetStaticBatchesActive(false);
+
   this->materialMap.clear();
   this->datablockMap.clear();
   Ogre::HlmsManager *hlmsManager = engine->OgreRoot()->getHlmsManager();
@@ -169,7 +172,7 @@ void Ogre2MaterialSwitcher::cameraPreRenderScene(
 
       // TODO(anyone): Retrieve datablock and make sure it's not blending
       // like we do with Items (it should be impossible?)
-      heightmap->Terra()->SetSolidColor(
+      heightmap->SetSolidColor(
         1u, Ogre::Vector4(this->currentColor.R(), this->currentColor.G(),
                           this->currentColor.B(), 1.0));
     }
@@ -231,9 +234,11 @@ void Ogre2MaterialSwitcher::cameraPostRenderScene(
   {
     auto heightmap = h.lock();
     if (heightmap)
-      heightmap->Terra()->UnsetSolidColors();
+      heightmap->UnsetSolidColors();
   }
 
+  this->scene->SetStaticBatchesActive(true);
+
   engine->SetGzOgreRenderingMode(GORM_NORMAL);
 }
 
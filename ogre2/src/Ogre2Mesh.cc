@@ -82,9 +82,9 @@ void Ogre2Mesh::Destroy()
   // Remove this object from parent
   BaseGeometry::Destroy();
 
-  // destroy mesh (ogre item)
+  // destroy mesh (ogre item) or return it to the object pool
   auto ogreScene = std::dynamic_pointer_cast<Ogre2Scene>(this->Scene());
-  ogreScene->OgreSceneManager()->destroyItem(this->ogreItem);
+  ogreScene->ReleaseOgreItem(this->ogreItem);
   this->ogreItem = nullptr;
 
   // destroy submeshes (ogre subitems)
@@ -0,0 +1,474 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+
+#include "Ogre2DiskCacheUtil.hh"
+#include "Ogre2MeshCache.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <Vao/OgreVaoManager.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+/// \brief Identifies a mesh cache file ("GZMC")
+const uint32_t kMagic = 0x434d5a47u;
+
+/// \brief Version of the cache file layout. Increase it whenever the file
+/// layout or the vertex layout built by Ogre2MeshFactory changes.
+const uint32_t kVersion = 3u;
+
+/// \brief Alignment of the vertex and index streams in the file
+const uint64_t kAlignment = 16u;
+
+/// \brief Header at the start of a cache file
+struct FileHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t sourceSize;
+  int64_t sourceTime;
+  uint64_t sourceHash;
+  double min[3];
+  double max[3];
+  uint32_t subMeshCount;
+  uint32_t lodCount;
+};
+
+/// \brief Header of each submesh. It is followed by the submesh name, by a
+/// (type, semantic) pair for each vertex element and by a LodHeader for
+/// each LOD after the first one.
+struct SubMeshHeader
+{
+  uint32_t nameLength;
+  uint32_t operationType;
+  uint32_t elementCount;
+  uint32_t vertexCount;
+  uint32_t vertexSize;
+  uint32_t indexCount;
+  uint32_t indexSize;
+  uint32_t reserved;
+  uint64_t vertexOffset;
+  uint64_t indexOffset;
+};
+
+/// \brief Index stream of a LOD after the first one
+struct LodHeader
+{
+  uint32_t indexCount;
+  uint32_t reserved;
+  uint64_t indexOffset;
+};
+
+/// \brief Round up an offset to the stream alignment
+/// \param[in] _offset Offset to align
+/// \return Aligned offset
+uint64_t Align(uint64_t _offset)
+{
+  return (_offset + kAlignment - 1u) / kAlignment * kAlignment;
+}
+}
+
+//////////////////////////////////////////////////
+Ogre2MeshCache::Ogre2MeshCache(const std::string &_cacheDir,
+    const std::string &_sourcePath, const std::string &_variant)
+{
+  // the same file reached through another relative path or a symlink
+  // shares the entry
+  std::error_code ec;
+  const std::filesystem::path canonical =
+      std::filesystem::weakly_canonical(_sourcePath, ec);
+  this->sourcePath = ec ? _sourcePath : canonical.string();
+
+  std::string key = this->sourcePath;
+  key.push_back('\0');
+  key += _variant;
+  this->cacheFile = common::joinPaths(_cacheDir,
+      CacheKeyString(Fnv1a(key.data(), key.size())) + ".gzmesh");
+
+  auto time = std::filesystem::last_write_time(this->sourcePath, ec);
+  if (ec)
+    return;
+  this->sourceTime = static_cast<int64_t>(time.time_since_epoch().count());
+
+  const auto size = std::filesystem::file_size(this->sourcePath, ec);
+  if (ec)
+    return;
+  this->sourceSize = static_cast<uint64_t>(size);
+  this->sourceValid = true;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2MeshCache::SourceHash(uint64_t &_hash) const
+{
+  if (!this->sourceHashed)
+  {
+    uint64_t hash = kFnvOffset;
+    uint64_t size = 0u;
+    if (!HashFile(this->sourcePath, hash, size) || size != this->sourceSize)
+      return false;
+    this->sourceHash = hash;
+    this->sourceHashed = true;
+  }
+  _hash = this->sourceHash;
+  return true;
+}
+
+//////////////////////////////////////////////////
+Ogre2MeshCache::~Ogre2MeshCache()
+{
+  this->Unmap();
+}
+
+//////////////////////////////////////////////////
+void Ogre2MeshCache::Unmap()
+{
+#ifndef _WIN32
+  if (this->mapped && !this->fileData)
+  {
+    munmap(const_cast<uint8_t *>(this->mapped), this->mappedSize);
+  }
+#endif
+  this->fileData.reset();
+  this->mapped = nullptr;
+  this->mappedSize = 0u;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2MeshCache::Read(std::vector<SubMesh> &_subMeshes,
+    math::Vector3d &_min, math::Vector3d &_max,
+    std::vector<double> &_lodDistances)
+{
+  _subMeshes.clear();
+  _lodDistances.clear();
+  this->Unmap();
+
+  if (!this->sourceValid || !common::isFile(this->cacheFile))
+    return false;
+
+#ifndef _WIN32
+  int fd = open(this->cacheFile.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size <= 0)
+  {
+    close(fd);
+    return false;
+  }
+  void *addr = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+      MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED)
+    return false;
+  this->mapped = static_cast<const uint8_t *>(addr);
+  this->mappedSize = static_cast<size_t>(info.st_size);
+#else
+  std::ifstream file(this->cacheFile, std::ios::binary | std::ios::ate);
+  if (!file)
+    return false;
+  const std::streamoff size = file.tellg();
+  if (size <= 0)
+    return false;
+  this->fileData = std::make_unique<uint8_t[]>(static_cast<size_t>(size));
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char *>(this->fileData.get()), size))
+  {
+    this->fileData.reset();
+    return false;
+  }
+  this->mapped = this->fileData.get();
+  this->mappedSize = static_cast<size_t>(size);
+#endif
+
+  // the file may be stale, truncated or from another version, so every
+  // size and offset is checked before it is used
+  auto fail = [&]()
+  {
+    _subMeshes.clear();
+    _lodDistances.clear();
+    this->Unmap();
+    return false;
+  };
+
+  FileHeader header;
+  if (this->mappedSize < sizeof(header))
+    return fail();
+  memcpy(&header, this->mapped, sizeof(header));
+  if (header.magic != kMagic || header.version != kVersion ||
+      header.sourceSize != this->sourceSize)
+  {
+    return fail();
+  }
+
+  // an unchanged modification time is trusted, so loads of unchanged files
+  // don't read the source. The content is only hashed when the time
+  // changed, e.g. after a checkout that left the content as is.
+  uint64_t hash = 0u;
+  if (header.sourceTime != this->sourceTime &&
+      (!this->SourceHash(hash) || header.sourceHash != hash))
+  {
+    return fail();
+  }
+
+  uint64_t offset = sizeof(header);
+  if (offset + header.lodCount * sizeof(double) > this->mappedSize)
+    return fail();
+  _lodDistances.resize(header.lodCount);
+  if (header.lodCount > 0u)
+  {
+    memcpy(_lodDistances.data(), this->mapped + offset,
+        header.lodCount * sizeof(double));
+  }
+  offset += header.lodCount * sizeof(double);
+
+  for (uint32_t i = 0u; i < header.subMeshCount; ++i)
+  {
+    SubMeshHeader sub;
+    if (offset + sizeof(sub) > this->mappedSize)
+      return fail();
+    memcpy(&sub, this->mapped + offset, sizeof(sub));
+    offset += sizeof(sub);
+
+    const uint64_t elementsSize =
+        static_cast<uint64_t>(sub.elementCount) * 2u * sizeof(uint32_t);
+    const uint64_t lodsSize =
+        static_cast<uint64_t>(header.lodCount) * sizeof(LodHeader);
+    if (offset + sub.nameLength + elementsSize + lodsSize > this->mappedSize)
+      return fail();
+
+    SubMesh subMesh;
+    subMesh.name.assign(
+        reinterpret_cast<const char *>(this->mapped + offset),
+        sub.nameLength);
+    offset += sub.nameLength;
+    subMesh.operationType =
+        static_cast<Ogre::OperationType>(sub.operationType);
+    for (uint32_t e = 0u; e < sub.elementCount; ++e)
+    {
+      uint32_t element[2];
+      memcpy(element, this->mapped + offset, sizeof(element));
+      offset += sizeof(element);
+      subMesh.vertexElements.push_back(Ogre::VertexElement2(
+          static_cast<Ogre::VertexElementType>(element[0]),
+          static_cast<Ogre::VertexElementSemantic>(element[1])));
+    }
+
+    const uint64_t vertexBytes =
+        static_cast<uint64_t>(sub.vertexCount) * sub.vertexSize;
+    const uint64_t indexBytes =
+        static_cast<uint64_t>(sub.indexCount) * sub.indexSize;
+    if (sub.vertexCount == 0u ||
+        (sub.indexSize != sizeof(uint16_t) &&
+         sub.indexSize != sizeof(uint32_t)) ||
+        sub.vertexSize !=
+        Ogre::VaoManager::calculateVertexSize(subMesh.vertexElements) ||
+        sub.vertexOffset + vertexBytes > this->mappedSize ||
+        sub.indexOffset + indexBytes > this->mappedSize)
+    {
+      return fail();
+    }
+
+    subMesh.vertexCount = sub.vertexCount;
+    subMesh.vertexData = this->mapped + sub.vertexOffset;
+    subMesh.indexCount = sub.indexCount;
+    subMesh.indexSize = sub.indexSize;
+    if (sub.indexCount > 0u)
+      subMesh.indexData = this->mapped + sub.indexOffset;
+
+    for (uint32_t l = 0u; l < header.lodCount; ++l)
+    {
+      LodHeader lodHeader;
+      memcpy(&lodHeader, this->mapped + offset, sizeof(lodHeader));
+      offset += sizeof(lodHeader);
+      if (lodHeader.indexCount == 0u || lodHeader.indexOffset +
+          static_cast<uint64_t>(lodHeader.indexCount) * sub.indexSize >
+          this->mappedSize)
+      {
+        return fail();
+      }
+      Lod lod;
+      lod.indexCount = lodHeader.indexCount;
+      lod.indexData = this->mapped + lodHeader.indexOffset;
+      subMesh.lods.push_back(lod);
+    }
+    _subMeshes.push_back(std::move(subMesh));
+  }
+
+  _min.Set(header.min[0], header.min[1], header.min[2]);
+  _max.Set(header.max[0], header.max[1], header.max[2]);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2MeshCache::Write(const std::vector<SubMesh> &_subMeshes,
+    const math::Vector3d &_min, const math::Vector3d &_max,
+    const std::vector<double> &_lodDistances) const
+{
+  if (!this->sourceValid)
+    return false;
+
+  for (const auto &subMesh : _subMeshes)
+  {
+    if (subMesh.lods.size() != _lodDistances.size())
+    {
+      gzerr << "Submesh [" << subMesh.name << "] has " << subMesh.lods.size()
+            << " LODs, expected " << _lodDistances.size() << std::endl;
+      return false;
+    }
+  }
+
+  const std::string dir = common::parentPath(this->cacheFile);
+  if (!common::isDirectory(dir) && !common::createDirectories(dir))
+  {
+    gzwarn << "Unable to create mesh cache directory [" << dir << "]"
+           << std::endl;
+    return false;
+  }
+
+  FileHeader header{};
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.sourceSize = this->sourceSize;
+  header.sourceTime = this->sourceTime;
+  if (!this->SourceHash(header.sourceHash))
+    return false;
+  for (unsigned int i = 0u; i < 3u; ++i)
+  {
+    header.min[i] = _min[i];
+    header.max[i] = _max[i];
+  }
+  header.subMeshCount = static_cast<uint32_t>(_subMeshes.size());
+  header.lodCount = static_cast<uint32_t>(_lodDistances.size());
+
+  // the descriptive part comes first and the aligned streams after it
+  std::vector<SubMeshHeader> subHeaders(_subMeshes.size());
+  std::vector<std::vector<LodHeader>> lodHeaders(_subMeshes.size());
+  uint64_t offset = sizeof(header) + _lodDistances.size() * sizeof(double);
+  for (const auto &subMesh : _subMeshes)
+  {
+    offset += sizeof(SubMeshHeader) + subMesh.name.size() +
+        subMesh.vertexElements.size() * 2u * sizeof(uint32_t) +
+        subMesh.lods.size() * sizeof(LodHeader);
+  }
+  for (size_t i = 0u; i < _subMeshes.size(); ++i)
+  {
+    const SubMesh &subMesh = _subMeshes[i];
+    SubMeshHeader &sub = subHeaders[i];
+    sub.nameLength = static_cast<uint32_t>(subMesh.name.size());
+    sub.operationType = static_cast<uint32_t>(subMesh.operationType);
+    sub.elementCount = static_cast<uint32_t>(subMesh.vertexElements.size());
+    sub.vertexCount = subMesh.vertexCount;
+    sub.vertexSize = static_cast<uint32_t>(
+        Ogre::VaoManager::calculateVertexSize(subMesh.vertexElements));
+    sub.indexCount = subMesh.indexCount;
+    sub.indexSize = subMesh.indexSize;
+    sub.reserved = 0u;
+
+    offset = Align(offset);
+    sub.vertexOffset = offset;
+    offset += static_cast<uint64_t>(sub.vertexCount) * sub.vertexSize;
+    offset = Align(offset);
+    sub.indexOffset = offset;
+    offset += static_cast<uint64_t>(sub.indexCount) * sub.indexSize;
+
+    for (const auto &lod : subMesh.lods)
+    {
+      LodHeader lodHeader{};
+      lodHeader.indexCount = lod.indexCount;
+      offset = Align(offset);
+      lodHeader.indexOffset = offset;
+      offset += static_cast<uint64_t>(lod.indexCount) * sub.indexSize;
+      lodHeaders[i].push_back(lodHeader);
+    }
+  }
+
+  return WriteCacheFile(this->cacheFile, "mesh", [&](std::ostream &_out)
+  {
+    uint64_t written = 0u;
+    auto write = [&](const void *_data, uint64_t _size)
+    {
+      _out.write(static_cast<const char *>(_data),
+          static_cast<std::streamsize>(_size));
+      written += _size;
+    };
+    auto pad = [&](uint64_t _to)
+    {
+      static const char zeros[kAlignment] = {};
+      write(zeros, _to - written);
+    };
+
+    write(&header, sizeof(header));
+    write(_lodDistances.data(), _lodDistances.size() * sizeof(double));
+    for (size_t i = 0u; i < _subMeshes.size(); ++i)
+    {
+      const SubMesh &subMesh = _subMeshes[i];
+      write(&subHeaders[i], sizeof(SubMeshHeader));
+      write(subMesh.name.data(), subMesh.name.size());
+      for (const auto &element : subMesh.vertexElements)
+      {
+        const uint32_t pair[2] = {
+            static_cast<uint32_t>(element.mType),
+            static_cast<uint32_t>(element.mSemantic)};
+        write(pair, sizeof(pair));
+      }
+      write(lodHeaders[i].data(), lodHeaders[i].size() * sizeof(LodHeader));
+    }
+    for (size_t i = 0u; i < _subMeshes.size(); ++i)
+    {
+      const SubMesh &subMesh = _subMeshes[i];
+      const SubMeshHeader &sub = subHeaders[i];
+      pad(sub.vertexOffset);
+      write(subMesh.vertexData,
+          static_cast<uint64_t>(sub.vertexCount) * sub.vertexSize);
+      pad(sub.indexOffset);
+      if (subMesh.indexData)
+      {
+        write(subMesh.indexData,
+            static_cast<uint64_t>(sub.indexCount) * sub.indexSize);
+      }
+      for (size_t l = 0u; l < subMesh.lods.size(); ++l)
+      {
+        pad(lodHeaders[i][l].indexOffset);
+        write(subMesh.lods[l].indexData,
+            static_cast<uint64_t>(subMesh.lods[l].indexCount) *
+            sub.indexSize);
+      }
+    }
+  });
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2MESHCACHE_HH_
+#define GZ_RENDERING_OGRE2_OGRE2MESHCACHE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Export.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <Vao/OgreVertexArrayObject.h>
+#include <Vao/OgreVertexElements.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Entry of the on-disk cache of GPU ready mesh buffers.
+    ///
+    /// An entry stores the interleaved vertex and index streams of
+    /// each submesh exactly as Ogre2MeshFactory uploads them, including the
+    /// index streams of generated LODs, together with the mesh bounds, the
+    /// LOD switch distances and the submesh names, which bind the buffers
+    /// to the materials of the source mesh. It is keyed by the canonical path
+    /// of the source mesh file and a variant string, and is only valid while
+    /// the size of the source file matches and either its modification time
+    /// or its content hash matches.
+    ///
+    /// Cache files are memory mapped when read, so the streams are uploaded
+    /// straight from the mapping.
+    class GZ_RENDERING_OGRE2_VISIBLE Ogre2MeshCache
+    {
+      /// \brief Index stream of one LOD of a submesh
+      public: struct Lod
+      {
+        /// \brief Number of indices
+        uint32_t indexCount = 0u;
+
+        /// \brief Index data
+        const void *indexData = nullptr;
+      };
+
+      /// \brief Buffers of one submesh
+      public: struct SubMesh
+      {
+        /// \brief Submesh name
+        std::string name;
+
+        /// \brief Ogre operation type
+        Ogre::OperationType operationType = Ogre::OT_TRIANGLE_LIST;
+
+        /// \brief Layout of the interleaved vertex data
+        Ogre::VertexElement2Vec vertexElements;
+
+        /// \brief Number of vertices
+        uint32_t vertexCount = 0u;
+
+        /// \brief Interleaved vertex data
+        const void *vertexData = nullptr;
+
+        /// \brief Number of indices
+        uint32_t indexCount = 0u;
+
+        /// \brief Size of each index of the submesh and its LODs in bytes,
+        /// 2 or 4
+        uint32_t indexSize = 4u;
+
+        /// \brief Index data, null if the submesh is not indexed
+        const void *indexData = nullptr;
+
+        /// \brief Index streams of the LODs after the first one. All
+        /// submeshes of a mesh have the same number of LODs.
+        std::vector<Lod> lods;
+      };
+
+      /// \brief Constructor. Only reads the size and modification time of
+      /// the source file, its content is hashed when writing the entry or
+      /// when the modification time no longer matches the entry.
+      /// \param[in] _cacheDir Directory containing the cache files
+      /// \param[in] _sourcePath Path of the source mesh file
+      /// \param[in] _variant Load options that change the buffers, e.g. the
+      /// name of the only submesh to load
+      public: Ogre2MeshCache(const std::string &_cacheDir,
+                  const std::string &_sourcePath,
+                  const std::string &_variant);
+
+      /// \brief Destructor. Unmaps the cache file, which invalidates the
+      /// data pointers returned by Read.
+      public: ~Ogre2MeshCache();
+
+      /// \brief Map the cache file and read its buffers
+      /// \param[out] _subMeshes Buffers of each submesh. The data pointers
+      /// are valid until this object is destroyed.
+      /// \param[out] _min Minimum corner of the mesh bounds
+      /// \param[out] _max Maximum corner of the mesh bounds
+      /// \param[out] _lodDistances Switch distance of each LOD after the
+      /// first one
+      /// \return False if there is no valid cache file for the source
+      public: bool Read(std::vector<SubMesh> &_subMeshes,
+                  math::Vector3d &_min, math::Vector3d &_max,
+                  std::vector<double> &_lodDistances);
+
+      /// \brief Write the cache file. The file is written to a temporary
+      /// name and renamed, so concurrent readers never see a partial file.
+      /// \param[in] _subMeshes Buffers of each submesh
+      /// \param[in] _min Minimum corner of the mesh bounds
+      /// \param[in] _max Maximum corner of the mesh bounds
+      /// \param[in] _lodDistances Switch distance of each LOD after the
+      /// first one
+      /// \return True if the file was written
+      public: bool Write(const std::vector<SubMesh> &_subMeshes,
+                  const math::Vector3d &_min,
+                  const math::Vector3d &_max,
+                  const std::vector<double> &_lodDistances) const;
+
+      /// \brief Unmap the cache file if it is mapped
+      private: void Unmap();
+
+      /// \brief Get the content hash of the source file, hashing the file
+      /// the first time it is needed
+      /// \param[out] _hash Content hash
+      /// \return False if the source file could not be read, or if it
+      /// changed since this object was created
+      private: bool SourceHash(uint64_t &_hash) const;
+
+      /// \brief Path of the cache file
+      private: std::string cacheFile;
+
+      /// \brief Canonical path of the source file
+      private: std::string sourcePath;
+
+      /// \brief True if the size and modification time of the source file
+      /// could be read
+      private: bool sourceValid = false;
+
+      /// \brief Size of the source file in bytes
+      private: uint64_t sourceSize = 0u;
+
+      /// \brief Modification time of the source file
+      private: int64_t sourceTime = 0;
+
+      /// \brief True once the source file was hashed
+      private: mutable bool sourceHashed = false;
+
+      /// \brief Content hash of the source file, valid once sourceHashed
+      /// is true
+      private: mutable uint64_t sourceHash = 0u;
+
+      /// \brief Start of the mapped cache file
+      private: const uint8_t *mapped = nullptr;
+
+      /// \brief Size of the mapped cache file
+      private: size_t mappedSize = 0u;
+
+      /// \brief Copy of the cache file on platforms without mmap
+      private: std::unique_ptr<uint8_t[]> fileData;
+    };
+    }
+  }
+}
+
+#endif
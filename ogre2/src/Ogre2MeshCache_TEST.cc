@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <gz/common/Filesystem.hh>
+
+#include "Ogre2MeshCache.hh"
+#include "Ogre2TestDirectory.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+/// \brief Move the modification time of a file forward
+/// \param[in] _path Path of the file
+/// \param[in] _seconds Number of seconds
+void Touch(const std::string &_path, int _seconds)
+{
+  const auto time = std::filesystem::last_write_time(_path);
+  std::filesystem::last_write_time(_path,
+      time + std::chrono::seconds(_seconds));
+}
+}
+
+/////////////////////////////////////////////////
+TEST(Ogre2MeshCache, HitAndMiss)
+{
+  Ogre2TestDirectory dir("ogre2_mesh_cache");
+  ASSERT_TRUE(dir.Valid());
+
+  const std::string source = dir.WriteFile("triangle.obj",
+      "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+  const std::string cacheDir = dir.Path("cache");
+
+  const float vertices[9] = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+  const uint16_t indices[3] = {0, 1, 2};
+  std::vector<Ogre2MeshCache::SubMesh> subMeshes(1u);
+  subMeshes[0].name = "triangle";
+  subMeshes[0].vertexElements.push_back(
+      Ogre::VertexElement2(Ogre::VET_FLOAT3, Ogre::VES_POSITION));
+  subMeshes[0].vertexCount = 3u;
+  subMeshes[0].vertexData = vertices;
+  subMeshes[0].indexCount = 3u;
+  subMeshes[0].indexSize = sizeof(uint16_t);
+  subMeshes[0].indexData = indices;
+  const math::Vector3d min(0, 0, 0);
+  const math::Vector3d max(1, 1, 0);
+
+  // reads a cache entry, returns true on a hit
+  auto load = [&](const std::string &_source, const std::string &_variant)
+  {
+    Ogre2MeshCache cache(cacheDir, _source, _variant);
+    std::vector<Ogre2MeshCache::SubMesh> read;
+    math::Vector3d readMin;
+    math::Vector3d readMax;
+    std::vector<double> lodDistances;
+    if (!cache.Read(read, readMin, readMax, lodDistances))
+      return false;
+
+    EXPECT_EQ(min, readMin);
+    EXPECT_EQ(max, readMax);
+    EXPECT_TRUE(lodDistances.empty());
+    EXPECT_EQ(1u, read.size());
+    if (read.size() != 1u)
+      return true;
+    EXPECT_EQ("triangle", read[0].name);
+    EXPECT_EQ(Ogre::OT_TRIANGLE_LIST, read[0].operationType);
+    EXPECT_EQ(1u, read[0].vertexElements.size());
+    EXPECT_EQ(3u, read[0].vertexCount);
+    EXPECT_EQ(0, memcmp(vertices, read[0].vertexData, sizeof(vertices)));
+    EXPECT_EQ(3u, read[0].indexCount);
+    EXPECT_EQ(sizeof(uint16_t), read[0].indexSize);
+    EXPECT_EQ(0, memcmp(indices, read[0].indexData, sizeof(indices)));
+    EXPECT_TRUE(read[0].lods.empty());
+    return true;
+  };
+
+  // the first load misses and writes the entry
+  EXPECT_FALSE(load(source, "lod"));
+  {
+    Ogre2MeshCache cache(cacheDir, source, "lod");
+    EXPECT_TRUE(cache.Write(subMeshes, min, max, {}));
+  }
+
+  // the second load hits
+  EXPECT_TRUE(load(source, "lod"));
+
+  // so does another path to the same file
+  EXPECT_TRUE(load(common::joinPaths(dir.Path(), ".", "triangle.obj"),
+      "lod"));
+
+  // other load options use another entry
+  EXPECT_FALSE(load(source, "quantized"));
+
+  // a newer file with the same content still hits
+  Touch(source, 10);
+  EXPECT_TRUE(load(source, "lod"));
+
+  // a modified file of the same size misses
+  dir.WriteFile("triangle.obj", "v 0 0 0\nv 2 0 0\nv 0 2 0\nf 1 2 3\n");
+  Touch(source, 20);
+  EXPECT_FALSE(load(source, "lod"));
+
+  // as does a file of another size
+  {
+    Ogre2MeshCache cache(cacheDir, source, "lod");
+    EXPECT_TRUE(cache.Write(subMeshes, min, max, {}));
+  }
+  EXPECT_TRUE(load(source, "lod"));
+  dir.WriteFile("triangle.obj",
+      "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\nf 1 2 3\n");
+  EXPECT_FALSE(load(source, "lod"));
+
+  // a missing source is never cached
+  {
+    Ogre2MeshCache cache(cacheDir, dir.Path("missing.obj"), "lod");
+    EXPECT_FALSE(cache.Write(subMeshes, min, max, {}));
+  }
+}
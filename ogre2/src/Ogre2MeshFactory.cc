@@ -15,10 +15,21 @@
  *
  */
 
-
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <initializer_list>
+#include <map>
+#include <memory>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
 #include <gz/common/Material.hh>
 #include <gz/common/MeshManager.hh>
 #include <gz/common/Skeleton.hh>
@@ -35,22 +46,33 @@
 #include "gz/rendering/ogre2/Ogre2Scene.hh"
 #include "gz/rendering/ogre2/Ogre2Storage.hh"
 
+#include "Ogre2MeshCache.hh"
+#include "Ogre2MeshSimplifier.hh"
+#include "Ogre2QTangent.hh"
+
 #ifdef _MSC_VER
   #pragma warning(push, 0)
 #endif
+#include <OgreBitwise.h>
 #include <OgreHardwareBufferManager.h>
 #include <OgreItem.h>
 #include <OgreKeyFrame.h>
+#include <OgreLodStrategy.h>
+#include <OgreLodStrategyManager.h>
 #include <OgreMesh2.h>
 #include <OgreMeshManager.h>
 #include <OgreMeshManager2.h>
 #include <OgreOldBone.h>
 #include <OgreOldSkeletonManager.h>
+#include <OgreRenderSystem.h>
 #include <OgreSceneManager.h>
 #include <OgreSkeleton.h>
 #include <OgreSubItem.h>
 #include <OgreSubMesh.h>
 #include <OgreSubMesh2.h>
+#include <Vao/OgreIndexBufferPacked.h>
+#include <Vao/OgreVaoManager.h>
+#include <Vao/OgreVertexArrayObject.h>
 #ifdef _MSC_VER
   #pragma warning(pop)
 #endif
@@ -61,6 +83,11 @@ class gz::rendering::Ogre2MeshFactoryPrivate
   /// \brief Vector with the template materials, we keep the pointer to be
   /// able to remove it when nobody is using it.
   public: std::vector<MaterialPtr> materialCache;
+
+  /// \brief LOD values of the meshes with generated LODs, by mesh name.
+  /// Ogre only fills the LOD values of the meshes it deserializes or
+  /// imports from v1, so the items of these meshes are pointed to them.
+  public: std::map<std::string, Ogre::FastArray<Ogre::Real>> lodValues;
 };
 
 /// \brief Private data for the Ogre2SubMeshStoreFactory class
@@ -71,6 +98,569 @@ class gz::rendering::Ogre2SubMeshStoreFactoryPrivate
 using namespace gz;
 using namespace rendering;
 
+namespace
+{
+/// \brief SIMD aligned staging memory used to upload buffer data
+struct SimdBuffer
+{
+  /// \brief Constructor
+  /// \param[in] _size Size in bytes
+  explicit SimdBuffer(size_t _size)
+    : data(OGRE_MALLOC_SIMD(_size, Ogre::MEMCATEGORY_GEOMETRY))
+  {
+  }
+
+  /// \brief Move constructor
+  /// \param[in] _other Buffer to take the staging memory from
+  SimdBuffer(SimdBuffer &&_other) noexcept
+    : data(_other.data)
+  {
+    _other.data = nullptr;
+  }
+
+  /// \brief Copying would free the staging memory twice
+  SimdBuffer(const SimdBuffer &) = delete;
+
+  /// \brief Copying would free the staging memory twice
+  SimdBuffer &operator=(const SimdBuffer &) = delete;
+
+  /// \brief Destructor
+  ~SimdBuffer()
+  {
+    if (this->data)
+      OGRE_FREE_SIMD(this->data, Ogre::MEMCATEGORY_GEOMETRY);
+  }
+
+  /// \brief Staging memory
+  void *data;
+};
+
+/// \brief CPU side data of a submesh that is ready to be uploaded to the
+/// GPU. It is filled by worker threads, so it must not hold anything that
+/// requires the render thread.
+struct PreparedSubMesh
+{
+  /// \brief Original submesh
+  std::shared_ptr<common::SubMesh> source;
+
+  /// \brief Copy of the original submesh, recentered if requested
+  std::unique_ptr<common::SubMesh> subMesh;
+
+  /// \brief Buffers to upload. The data either points to the staging
+  /// memory below or into a mapped mesh cache file.
+  Ogre2MeshCache::SubMesh buffers;
+
+  /// \brief Staging memory of the interleaved vertex data
+  std::unique_ptr<SimdBuffer> vertexStaging;
+
+  /// \brief Staging memory of the 16 or 32 bit index data
+  std::unique_ptr<SimdBuffer> indexStaging;
+
+  /// \brief Staging memory of the index data of each generated LOD
+  std::vector<std::unique_ptr<SimdBuffer>> lodStaging;
+
+  /// \brief Geometric error of each generated LOD
+  std::vector<double> lodErrors;
+};
+
+/// \brief Options that change how submeshes are prepared
+struct PrepareOptions
+{
+  /// \brief True to recenter the submesh vertices
+  bool center = false;
+
+  /// \brief True to generate LODs of triangle lists
+  bool generateLods = false;
+
+  /// \brief True to pack normals and tangents into 16 bit QTangents
+  bool quantize = false;
+};
+
+/// \brief Maximum number of LODs generated after the original mesh
+const unsigned int kMaxLodCount = 4u;
+
+/// \brief Triangle count ratio between consecutive LODs
+const double kLodReduction = 0.5;
+
+/// \brief Submeshes with fewer triangles are not simplified
+const size_t kMinLodTriangleCount = 512u;
+
+/// \brief Minimum number of vertices prepared by each worker thread.
+/// Starting a thread costs more than preparing smaller meshes.
+const size_t kMinWorkerVertexCount = 65536u;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the ogre operation type of a submesh primitive type
+/// \param[in] _type Submesh primitive type
+/// \param[out] _operationType Ogre operation type
+/// \return False if the primitive type is unknown
+static bool OgreOperationType(common::SubMesh::PrimitiveType _type,
+    Ogre::OperationType &_operationType)
+{
+  switch (_type)
+  {
+    case common::SubMesh::TRIANGLES:
+      _operationType = Ogre::OT_TRIANGLE_LIST;
+      return true;
+    case common::SubMesh::LINES:
+      _operationType = Ogre::OT_LINE_LIST;
+      return true;
+    case common::SubMesh::LINESTRIPS:
+      _operationType = Ogre::OT_LINE_STRIP;
+      return true;
+    case common::SubMesh::TRIFANS:
+      _operationType = Ogre::OT_TRIANGLE_FAN;
+      return true;
+    case common::SubMesh::TRISTRIPS:
+      _operationType = Ogre::OT_TRIANGLE_STRIP;
+      return true;
+    case common::SubMesh::POINTS:
+      _operationType = Ogre::OT_POINT_LIST;
+      return true;
+    default:
+      return false;
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Compute per vertex tangents of a triangle submesh from its
+/// normals and first texture coordinate set. The w component holds the
+/// handedness of the bitangent.
+/// \param[in] _subMesh Submesh with normals
+/// \param[out] _tangents Tangent of each vertex. Left empty if the
+/// submesh is not made of triangles.
+static void ComputeTangents(const common::SubMesh &_subMesh,
+    std::vector<Ogre::Vector4> &_tangents)
+{
+  const auto type = _subMesh.SubMeshPrimitiveType();
+  if (type != common::SubMesh::TRIANGLES &&
+      type != common::SubMesh::TRISTRIPS &&
+      type != common::SubMesh::TRIFANS)
+  {
+    return;
+  }
+
+  const unsigned int vertexCount = _subMesh.VertexCount();
+  const bool indexed = _subMesh.IndexCount() > 0u;
+  const unsigned int count = indexed ? _subMesh.IndexCount() : vertexCount;
+  const bool hasUv = _subMesh.TexCoordSetCount() > 0u &&
+      _subMesh.TexCoordCountBySet(0u) > 0u;
+
+  std::vector<Ogre::Vector3> sdir(vertexCount, Ogre::Vector3::ZERO);
+  std::vector<Ogre::Vector3> tdir(vertexCount, Ogre::Vector3::ZERO);
+
+  auto index = [&](unsigned int _i)
+  {
+    return indexed ? static_cast<unsigned int>(_subMesh.Index(_i)) : _i;
+  };
+
+  auto addTriangle = [&](unsigned int _a, unsigned int _b, unsigned int _c)
+  {
+    if (!hasUv || _a >= vertexCount || _b >= vertexCount ||
+        _c >= vertexCount)
+    {
+      return;
+    }
+
+    const math::Vector3d e1 = _subMesh.Vertex(_b) - _subMesh.Vertex(_a);
+    const math::Vector3d e2 = _subMesh.Vertex(_c) - _subMesh.Vertex(_a);
+    const math::Vector2d uv0 = _subMesh.TexCoordBySet(_a, 0u);
+    const math::Vector2d d1 = _subMesh.TexCoordBySet(_b, 0u) - uv0;
+    const math::Vector2d d2 = _subMesh.TexCoordBySet(_c, 0u) - uv0;
+
+    const double det = d1.X() * d2.Y() - d2.X() * d1.Y();
+    if (std::abs(det) < 1e-12)
+      return;
+    const double r = 1.0 / det;
+
+    const Ogre::Vector3 s = Ogre2Conversions::Convert(
+        (e1 * d2.Y() - e2 * d1.Y()) * r);
+    const Ogre::Vector3 t = Ogre2Conversions::Convert(
+        (e2 * d1.X() - e1 * d2.X()) * r);
+    for (unsigned int v : {_a, _b, _c})
+    {
+      sdir[v] += s;
+      tdir[v] += t;
+    }
+  };
+
+  if (type == common::SubMesh::TRIANGLES)
+  {
+    for (unsigned int i = 0u; i + 2u < count; i += 3u)
+      addTriangle(index(i), index(i + 1u), index(i + 2u));
+  }
+  else if (type == common::SubMesh::TRISTRIPS)
+  {
+    for (unsigned int i = 2u; i < count; ++i)
+    {
+      if (i % 2u == 0u)
+        addTriangle(index(i - 2u), index(i - 1u), index(i));
+      else
+        addTriangle(index(i - 1u), index(i - 2u), index(i));
+    }
+  }
+  else
+  {
+    for (unsigned int i = 2u; i < count; ++i)
+      addTriangle(index(0u), index(i - 1u), index(i));
+  }
+
+  _tangents.resize(vertexCount);
+  for (unsigned int i = 0u; i < vertexCount; ++i)
+  {
+    const Ogre::Vector3 n = Ogre2Conversions::Convert(_subMesh.Normal(i));
+
+    // Gram-Schmidt orthogonalize; fall back to any perpendicular vector
+    // for vertices without usable texture coordinates
+    Ogre::Vector3 t = sdir[i] - n * n.dotProduct(sdir[i]);
+    if (t.squaredLength() < 1e-12f)
+      t = n.perpendicular();
+    t.normalise();
+
+    const float w = (n.crossProduct(t).dotProduct(tdir[i]) < 0.0f) ?
+        -1.0f : 1.0f;
+    _tangents[i] = Ogre::Vector4(t.x, t.y, t.z, w);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Write floats to an interleaved vertex
+/// \param[in] _dst Destination
+/// \param[in] _values Values to write
+/// \return Destination past the written values
+static uint8_t *WriteFloats(uint8_t *_dst,
+    std::initializer_list<float> _values)
+{
+  for (float v : _values)
+  {
+    memcpy(_dst, &v, sizeof(float));
+    _dst += sizeof(float);
+  }
+  return _dst;
+}
+
+//////////////////////////////////////////////////
+/// \brief Write floats as half floats to an interleaved vertex
+/// \param[in] _dst Destination
+/// \param[in] _values Values to write
+/// \return Destination past the written values
+static uint8_t *WriteHalfs(uint8_t *_dst,
+    std::initializer_list<float> _values)
+{
+  for (float v : _values)
+  {
+    const uint16_t h = Ogre::Bitwise::floatToHalf(v);
+    memcpy(_dst, &h, sizeof(uint16_t));
+    _dst += sizeof(uint16_t);
+  }
+  return _dst;
+}
+
+//////////////////////////////////////////////////
+/// \brief Write a normal and tangent as a QTangent
+/// \param[in] _dst Destination
+/// \param[in] _normal Vertex normal
+/// \param[in] _tangent Vertex tangent, w is the bitangent sign
+/// \return Destination past the written values
+static uint8_t *WriteQTangent(uint8_t *_dst, const Ogre::Vector3 &_normal,
+    const Ogre::Vector4 &_tangent)
+{
+  const std::array<int16_t, 4> qTangent = EncodeQTangent(_normal, _tangent);
+  memcpy(_dst, qTangent.data(), sizeof(qTangent));
+  return _dst + sizeof(qTangent);
+}
+
+//////////////////////////////////////////////////
+/// \brief Copy indices to a new staging buffer
+/// \param[in] _indices Indices to copy
+/// \param[in] _indexSize Size of each staged index in bytes, 2 or 4
+/// \return Staging buffer
+static std::unique_ptr<SimdBuffer> StageIndices(
+    const std::vector<uint32_t> &_indices, uint32_t _indexSize)
+{
+  auto staging = std::make_unique<SimdBuffer>(_indexSize * _indices.size());
+  if (_indexSize == sizeof(uint32_t))
+  {
+    memcpy(staging->data, _indices.data(),
+        sizeof(uint32_t) * _indices.size());
+  }
+  else
+  {
+    uint16_t *dst = static_cast<uint16_t *>(staging->data);
+    for (size_t i = 0u; i < _indices.size(); ++i)
+      dst[i] = static_cast<uint16_t>(_indices[i]);
+  }
+  return staging;
+}
+
+//////////////////////////////////////////////////
+/// \brief Copy, recenter and fill the vertex and index data of a submesh.
+/// This only touches CPU memory and is safe to run on a worker thread.
+/// \param[in,out] _prepared Submesh to prepare, source and
+/// buffers.operationType must be set
+/// \param[in] _options Prepare options
+static void PrepareSubMesh(PreparedSubMesh &_prepared,
+    const PrepareOptions &_options)
+{
+  // Copy the original submesh. We may need to modify the vertices, and
+  // we don't want to change the original.
+  _prepared.subMesh = std::make_unique<common::SubMesh>(*_prepared.source);
+  common::SubMesh &subMesh = *_prepared.subMesh;
+
+  // Recenter the vertices if requested.
+  if (_options.center)
+    subMesh.Center(math::Vector3d::Zero);
+
+  const unsigned int vertexCount = subMesh.VertexCount();
+  const bool hasNormals = subMesh.NormalCount() > 0u;
+
+  // Tangents are needed to apply normal maps. They are generated from
+  // the normals and the first texture coordinate set of triangles.
+  std::vector<Ogre::Vector4> tangents;
+  if (hasNormals)
+    ComputeTangents(subMesh, tangents);
+  const bool hasTangents = !tangents.empty();
+
+  // A QTangent replaces the normal and tangent, 8 instead of 28 bytes.
+  // Positions stay full floats, they need the precision.
+  const bool qTangent = _options.quantize && hasTangents;
+
+  // Vertices are interleaved in this order: position, normal, tangent,
+  // texture coordinate sets. Texture coordinates are stored as half
+  // floats, like Ogre::Mesh::importV1 does.
+  Ogre::VertexElement2Vec &vertexElements = _prepared.buffers.vertexElements;
+  vertexElements.push_back(
+      Ogre::VertexElement2(Ogre::VET_FLOAT3, Ogre::VES_POSITION));
+  if (qTangent)
+  {
+    vertexElements.push_back(
+        Ogre::VertexElement2(Ogre::VET_SHORT4_SNORM, Ogre::VES_NORMAL));
+  }
+  else if (hasNormals)
+  {
+    vertexElements.push_back(
+        Ogre::VertexElement2(Ogre::VET_FLOAT3, Ogre::VES_NORMAL));
+  }
+  if (hasTangents && !qTangent)
+  {
+    vertexElements.push_back(
+        Ogre::VertexElement2(Ogre::VET_FLOAT4, Ogre::VES_TANGENT));
+  }
+
+  // If submesh does not have texcoord sets, add one default set so that
+  // textured materials can still be applied.
+  std::vector<unsigned int> texCoordSets;
+  for (unsigned int k = 0u; k < subMesh.TexCoordSetCount(); ++k)
+  {
+    if (subMesh.TexCoordCountBySet(k) > 0u)
+      texCoordSets.push_back(k);
+  }
+  const size_t uvElementCount = std::max<size_t>(texCoordSets.size(), 1u);
+  for (size_t k = 0u; k < uvElementCount; ++k)
+  {
+    vertexElements.push_back(Ogre::VertexElement2(Ogre::VET_HALF2,
+        Ogre::VES_TEXTURE_COORDINATES));
+  }
+
+  const size_t vertexSize =
+      Ogre::VaoManager::calculateVertexSize(vertexElements);
+
+  // fill a single staging copy of the vertex data that is uploaded
+  // once when the immutable buffer is created
+  _prepared.vertexStaging =
+      std::make_unique<SimdBuffer>(vertexSize * vertexCount);
+  _prepared.buffers.vertexCount = vertexCount;
+  _prepared.buffers.vertexData = _prepared.vertexStaging->data;
+  uint8_t *vertex = static_cast<uint8_t *>(_prepared.vertexStaging->data);
+  for (unsigned int j = 0; j < vertexCount; ++j)
+  {
+    const math::Vector3d &p = subMesh.Vertex(j);
+    vertex = WriteFloats(vertex,
+        {static_cast<float>(p.X()), static_cast<float>(p.Y()),
+         static_cast<float>(p.Z())});
+
+    if (qTangent)
+    {
+      vertex = WriteQTangent(vertex,
+          Ogre2Conversions::Convert(subMesh.Normal(j)), tangents[j]);
+    }
+    else if (hasNormals)
+    {
+      const math::Vector3d &n = subMesh.Normal(j);
+      vertex = WriteFloats(vertex,
+          {static_cast<float>(n.X()), static_cast<float>(n.Y()),
+           static_cast<float>(n.Z())});
+    }
+
+    if (hasTangents && !qTangent)
+    {
+      const Ogre::Vector4 &t = tangents[j];
+      vertex = WriteFloats(vertex, {t.x, t.y, t.z, t.w});
+    }
+
+    if (texCoordSets.empty())
+    {
+      vertex = WriteHalfs(vertex, {0.0f, 0.0f});
+    }
+    else
+    {
+      for (unsigned int k : texCoordSets)
+      {
+        const math::Vector2d &uv = subMesh.TexCoordBySet(j, k);
+        vertex = WriteHalfs(vertex,
+            {static_cast<float>(uv.X()), static_cast<float>(uv.Y())});
+      }
+    }
+  }
+
+  // 16 bit indices halve the index data when every vertex can be
+  // addressed. The largest index stays below the 0xFFFF restart index.
+  const uint32_t indexSize = vertexCount < 0x10000u ?
+      sizeof(uint16_t) : sizeof(uint32_t);
+  _prepared.buffers.indexSize = indexSize;
+
+  const unsigned int indexCount = subMesh.IndexCount();
+  std::vector<uint32_t> indices(indexCount);
+  for (unsigned int j = 0; j < indexCount; ++j)
+    indices[j] = static_cast<uint32_t>(subMesh.Index(j));
+  if (indexCount > 0u)
+  {
+    _prepared.indexStaging = StageIndices(indices, indexSize);
+    _prepared.buffers.indexCount = indexCount;
+    _prepared.buffers.indexData = _prepared.indexStaging->data;
+  }
+
+  if (!_options.generateLods ||
+      _prepared.buffers.operationType != Ogre::OT_TRIANGLE_LIST ||
+      indexCount / 3u < kMinLodTriangleCount)
+  {
+    return;
+  }
+
+  // every LOD indexes the vertex buffer of the original submesh
+  std::vector<math::Vector3d> positions(vertexCount);
+  for (unsigned int j = 0; j < vertexCount; ++j)
+    positions[j] = subMesh.Vertex(j);
+  Ogre2MeshSimplifier simplifier(positions, indices);
+
+  std::vector<uint32_t> lodIndices;
+  size_t triangleCount = simplifier.TriangleCount();
+  for (unsigned int l = 0u; l < kMaxLodCount; ++l)
+  {
+    const size_t target =
+        static_cast<size_t>(static_cast<double>(triangleCount) * kLodReduction);
+    if (target < kMinLodTriangleCount / 2u)
+      break;
+
+    const double error = simplifier.Simplify(target, lodIndices);
+
+    // stop when the simplifier is stuck, e.g. on meshes made of many
+    // small disconnected parts whose borders cannot move
+    if (lodIndices.size() / 3u > triangleCount * 9u / 10u)
+      break;
+    triangleCount = lodIndices.size() / 3u;
+
+    _prepared.lodStaging.push_back(StageIndices(lodIndices, indexSize));
+
+    Ogre2MeshCache::Lod lod;
+    lod.indexCount = static_cast<uint32_t>(lodIndices.size());
+    lod.indexData = _prepared.lodStaging.back()->data;
+    _prepared.buffers.lods.push_back(lod);
+    _prepared.lodErrors.push_back(error);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Give all submeshes the same number of LODs and compute the
+/// distance at which each LOD is used. Submeshes with fewer LODs repeat
+/// their last one.
+///
+/// The distance of a LOD is where its geometric error projects to one
+/// pixel for a camera with a focal length of one pixel. Sensors scale it
+/// with their focal length and LOD bias, see Ogre2Sensor::UpdateLodBias.
+/// \param[in,out] _prepared Prepared submeshes
+/// \return Distance of each LOD after the first one
+static std::vector<double> EqualizeLods(
+    std::vector<PreparedSubMesh> &_prepared)
+{
+  size_t lodCount = 0u;
+  for (const auto &p : _prepared)
+    lodCount = std::max(lodCount, p.buffers.lods.size());
+
+  std::vector<double> distances(lodCount, 0.0);
+  for (auto &p : _prepared)
+  {
+    Ogre2MeshCache::Lod last;
+    last.indexCount = p.buffers.indexCount;
+    last.indexData = p.buffers.indexData;
+    double lastError = 0.0;
+    for (size_t l = 0u; l < lodCount; ++l)
+    {
+      if (l < p.buffers.lods.size())
+      {
+        last = p.buffers.lods[l];
+        lastError = p.lodErrors[l];
+      }
+      else
+      {
+        p.buffers.lods.push_back(last);
+      }
+      distances[l] = std::max(distances[l], lastError);
+    }
+  }
+
+  // LOD values must not decrease
+  for (size_t l = 1u; l < lodCount; ++l)
+    distances[l] = std::max(distances[l], distances[l - 1u]);
+  return distances;
+}
+
+//////////////////////////////////////////////////
+/// \brief Prepare submeshes, spreading them over worker threads when
+/// there is more than one and they are large enough. Small meshes are
+/// prepared serially on the calling thread. Exceptions thrown by a worker,
+/// e.g. std::bad_alloc, are rethrown on the calling thread.
+/// \param[in,out] _prepared Submeshes to prepare
+/// \param[in] _options Prepare options
+static void PrepareSubMeshes(std::vector<PreparedSubMesh> &_prepared,
+    const PrepareOptions &_options)
+{
+  size_t vertexCount = 0u;
+  for (const auto &prepared : _prepared)
+    vertexCount += prepared.source->VertexCount();
+
+  const size_t workerCount = std::min<size_t>({_prepared.size(),
+      std::max(std::thread::hardware_concurrency(), 1u),
+      vertexCount / kMinWorkerVertexCount});
+
+  if (workerCount <= 1u)
+  {
+    for (auto &prepared : _prepared)
+      PrepareSubMesh(prepared, _options);
+    return;
+  }
+
+  // submeshes vary a lot in size so workers pull the next one from a
+  // shared counter instead of getting a fixed range
+  std::atomic<size_t> next{0u};
+  auto work = [&]()
+  {
+    for (size_t i = next++; i < _prepared.size(); i = next++)
+      PrepareSubMesh(_prepared[i], _options);
+  };
+
+  // the calling thread works too
+  std::vector<std::future<void>> workers;
+  workers.reserve(workerCount - 1u);
+  for (size_t i = 1u; i < workerCount; ++i)
+    workers.push_back(std::async(std::launch::async, work));
+  work();
+
+  for (auto &worker : workers)
+    worker.get();
+}
+
 //////////////////////////////////////////////////
 Ogre2MeshFactory::Ogre2MeshFactory(Ogre2ScenePtr _scene) :
   scene(_scene), dataPtr(std::make_unique<Ogre2MeshFactoryPrivate>())
@@ -89,6 +679,7 @@ void Ogre2MeshFactory::Clear()
     Ogre::MeshManager::getSingleton().remove(m);
 
   this->ogreMeshes.clear();
+  this->dataPtr->lodValues.clear();
 }
 
 //////////////////////////////////////////////////
@@ -154,7 +745,7 @@ Ogre::Item *Ogre2MeshFactory::OgreItem(const MeshDescriptor &_desc)
   Ogre::MeshPtr mesh =
       Ogre::MeshManager::getSingleton().getByName(name);
 
-  // if not, it probably has not been imported from v1 yet
+  // if not, it is a skeletal mesh that has not been imported from v1 yet
   if (!mesh)
   {
     Ogre::v1::MeshPtr v1Mesh =
@@ -169,7 +760,18 @@ Ogre::Item *Ogre2MeshFactory::OgreItem(const MeshDescriptor &_desc)
     this->ogreMeshes.push_back(name);
   }
 
-  return sceneManager->createItem(mesh, Ogre::SCENE_DYNAMIC);
+  // reuse an item of the same mesh if object pooling is enabled
+  Ogre::Item *item = this->scene->AcquireOgreItem(name);
+  if (item)
+    return item;
+
+  item = sceneManager->createItem(mesh, Ogre::SCENE_DYNAMIC);
+
+  // items select their LOD with the values of the mesh by default
+  auto lodIt = this->dataPtr->lodValues.find(name);
+  if (lodIt != this->dataPtr->lodValues.end())
+    item->mLodMesh = &lodIt->second;
+  return item;
 }
 
 //////////////////////////////////////////////////
@@ -197,6 +799,243 @@ bool Ogre2MeshFactory::IsLoaded(const MeshDescriptor &_desc)
 
 //////////////////////////////////////////////////
 bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
+{
+  // skeletal meshes still go through a v1 mesh until bone assignments and
+  // animations are ported to the v2 path
+  if (_desc.mesh->HasSkeleton())
+    return this->LoadV1Impl(_desc);
+
+  return this->LoadV2Impl(_desc);
+}
+
+//////////////////////////////////////////////////
+bool Ogre2MeshFactory::LoadV2Impl(const MeshDescriptor &_desc)
+{
+  Ogre2RenderEngine::Instance()->AddResourcePath(_desc.mesh->Path());
+
+  Ogre::VaoManager *vaoManager = this->scene->OgreSceneManager()->
+      getDestinationRenderSystem()->getVaoManager();
+
+  std::string name = this->MeshName(_desc);
+  Ogre::MeshPtr ogreMesh;
+
+  try
+  {
+    ogreMesh = Ogre::MeshManager::getSingleton().createManual(
+        name, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+    // Select the submeshes to load and validate them here so that all
+    // errors are reported from the calling thread.
+    std::vector<PreparedSubMesh> prepared;
+    for (unsigned int i = 0; i < _desc.mesh->SubMeshCount(); i++)
+    {
+      // if submesh is specified then load only that particular submesh
+      auto s = _desc.mesh->SubMeshByIndex(i).lock();
+      if (!s || (!_desc.subMeshName.empty() &&
+          s->Name() != _desc.subMeshName))
+      {
+        continue;
+      }
+
+      Ogre::OperationType operationType;
+      if (!OgreOperationType(s->SubMeshPrimitiveType(), operationType))
+      {
+        gzerr << "Unknown primitive type["
+              << s->SubMeshPrimitiveType() << "]\n";
+        continue;
+      }
+
+      if (s->VertexCount() == 0u)
+      {
+        gzwarn << "Skipping submesh [" << s->Name() << "] of mesh ["
+               << _desc.meshName << "] with no vertices" << std::endl;
+        continue;
+      }
+
+      prepared.emplace_back();
+      prepared.back().source = s;
+      prepared.back().buffers.name = s->Name();
+      prepared.back().buffers.operationType = operationType;
+    }
+
+    // Meshes loaded from a file can be uploaded straight from the on-disk
+    // cache, if it is enabled and up to date. The mesh manager names them
+    // after their file, other meshes may have any name.
+    PrepareOptions options;
+    options.center = _desc.centerSubMesh;
+    options.generateLods = this->scene->MeshLodEnabled();
+    options.quantize = this->scene->MeshQuantizationEnabled();
+    std::unique_ptr<Ogre2MeshCache> cache;
+    const std::string cachePath =
+        Ogre2RenderEngine::Instance()->MeshCachePath();
+    common::MeshManager *meshManager = common::MeshManager::Instance();
+    if (!cachePath.empty() &&
+        meshManager->MeshByName(_desc.mesh->Name()) == _desc.mesh &&
+        meshManager->IsValidFilename(_desc.mesh->Name()) &&
+        common::isFile(_desc.mesh->Name()))
+    {
+      cache = std::make_unique<Ogre2MeshCache>(cachePath,
+          _desc.mesh->Name(), _desc.subMeshName + "\n" +
+          (options.center ? "centered" : "") + "\n" +
+          (options.generateLods ? "lod" : "") + "\n" +
+          (options.quantize ? "quantized" : ""));
+    }
+
+    math::Vector3d max;
+    math::Vector3d min;
+    std::vector<double> lodDistances;
+    std::vector<Ogre2MeshCache::SubMesh> cached;
+    bool cacheHit = cache && cache->Read(cached, min, max, lodDistances) &&
+        cached.size() == prepared.size();
+    for (size_t i = 0u; cacheHit && i < prepared.size(); ++i)
+    {
+      cacheHit = cached[i].name == prepared[i].buffers.name &&
+          cached[i].operationType == prepared[i].buffers.operationType;
+    }
+
+    if (cacheHit)
+    {
+      for (size_t i = 0u; i < prepared.size(); ++i)
+        prepared[i].buffers = std::move(cached[i]);
+    }
+    else
+    {
+      // Copying, recentering and filling the staging buffers does not need
+      // the render thread, so it is done in parallel.
+      PrepareSubMeshes(prepared, options);
+      lodDistances = EqualizeLods(prepared);
+      max = _desc.mesh->Max();
+      min = _desc.mesh->Min();
+    }
+
+    if (!max.IsFinite())
+    {
+      gzerr << "Max bounding box is not finite[" << max << "]" << std::endl;
+      Ogre::MeshManager::getSingleton().remove(name);
+      return false;
+    }
+
+    if (!min.IsFinite())
+    {
+      gzerr << "Min bounding box is not finite[" << min << "]" << std::endl;
+      Ogre::MeshManager::getSingleton().remove(name);
+      return false;
+    }
+
+    if (cache && !cacheHit)
+    {
+      std::vector<Ogre2MeshCache::SubMesh> buffers;
+      for (const auto &p : prepared)
+        buffers.push_back(p.buffers);
+      cache->Write(buffers, min, max, lodDistances);
+    }
+
+    // Buffer, VAO and material creation must happen on the render thread.
+    // Submeshes are added in their original order.
+    for (auto &p : prepared)
+    {
+      Ogre::VertexBufferPacked *vertexBuffer = vaoManager->createVertexBuffer(
+          p.buffers.vertexElements, p.buffers.vertexCount,
+          Ogre::BT_IMMUTABLE, const_cast<void *>(p.buffers.vertexData),
+          false);
+      Ogre::VertexBufferPackedVec vertexBuffers;
+      vertexBuffers.push_back(vertexBuffer);
+
+      // it is ok to use null index buffer for non-indexed submeshes
+      Ogre::IndexBufferPacked *indexBuffer = nullptr;
+      const Ogre::IndexBufferPacked::IndexType indexType =
+          p.buffers.indexSize == sizeof(uint16_t) ?
+          Ogre::IndexBufferPacked::IT_16BIT :
+          Ogre::IndexBufferPacked::IT_32BIT;
+      if (p.buffers.indexData)
+      {
+        indexBuffer = vaoManager->createIndexBuffer(
+            indexType, p.buffers.indexCount,
+            Ogre::BT_IMMUTABLE, const_cast<void *>(p.buffers.indexData),
+            false);
+      }
+
+      Ogre::VertexArrayObject *vao = vaoManager->createVertexArrayObject(
+          vertexBuffers, indexBuffer, p.buffers.operationType);
+
+      // the copied submesh only differs from the original in its vertices,
+      // so the original is used to look up the material
+      Ogre::SubMesh *ogreSubMesh = ogreMesh->createSubMesh();
+      ogreSubMesh->mVao[Ogre::VpNormal].push_back(vao);
+      ogreSubMesh->mVao[Ogre::VpShadow].push_back(vao);
+
+      // LODs share the vertex buffer and only have their own indices.
+      // Ogre destroys shared vertex buffers once when the mesh is unloaded.
+      for (const auto &lod : p.buffers.lods)
+      {
+        Ogre::IndexBufferPacked *lodIndexBuffer =
+            vaoManager->createIndexBuffer(
+            indexType, lod.indexCount,
+            Ogre::BT_IMMUTABLE, const_cast<void *>(lod.indexData), false);
+        Ogre::VertexArrayObject *lodVao =
+            vaoManager->createVertexArrayObject(
+            vertexBuffers, lodIndexBuffer, p.buffers.operationType);
+        ogreSubMesh->mVao[Ogre::VpNormal].push_back(lodVao);
+        ogreSubMesh->mVao[Ogre::VpShadow].push_back(lodVao);
+      }
+
+      // the staging copies have been uploaded
+      p.vertexStaging.reset();
+      p.indexStaging.reset();
+      p.lodStaging.clear();
+
+      ogreSubMesh->setMaterialName(
+          this->CreateSubMeshMaterial(_desc, *p.source));
+      ogreMesh->nameSubMesh(p.buffers.name,
+          static_cast<uint16_t>(ogreMesh->getNumSubMeshes() - 1u));
+    }
+
+    ogreMesh->_setBounds(Ogre::Aabb::newFromExtents(
+          Ogre2Conversions::Convert(min), Ogre2Conversions::Convert(max)),
+          false);
+    ogreMesh->_setBoundingSphereRadius((max - min).Length());
+
+    // The distance strategy compares squared view distances, scaled by the
+    // camera LOD bias, against these values.
+    this->dataPtr->lodValues.erase(name);
+    if (!lodDistances.empty() && ogreMesh->getNumSubMeshes() > 0u)
+    {
+      const Ogre::LodStrategy *strategy =
+          Ogre::LodStrategyManager::getSingleton().getDefaultStrategy();
+      auto &lodValues = this->dataPtr->lodValues[name];
+      lodValues.push_back(strategy->getBaseValue());
+      for (double distance : lodDistances)
+      {
+        lodValues.push_back(strategy->transformUserValue(
+            static_cast<Ogre::Real>(distance)));
+      }
+    }
+  }
+  catch(Ogre::Exception &e)
+  {
+    gzerr << "Unable to insert mesh[" << e.getDescription() << "]"
+        << std::endl;
+    if (ogreMesh)
+      Ogre::MeshManager::getSingleton().remove(name);
+    return false;
+  }
+
+  this->ogreMeshes.push_back(name);
+
+  if (ogreMesh->getNumSubMeshes() == 0u)
+  {
+    std::string msg = "Unable to load mesh: '" + _desc.meshName + "'";
+    if (!_desc.subMeshName.empty())
+      msg += ", submesh: '" + _desc.subMeshName + "'";
+    msg += ". Mesh will be empty.";
+    gzwarn << msg << std::endl;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2MeshFactory::LoadV1Impl(const MeshDescriptor &_desc)
 {
   Ogre::v1::MeshPtr ogreMesh;
   std::string name;
@@ -492,25 +1331,8 @@ bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
 
       iBuf->unlock();
 
-      common::MaterialPtr material;
-      if (const auto subMeshIdx = subMesh.GetMaterialIndex())
-      {
-        material = _desc.mesh->MaterialByIndex(subMeshIdx.value());
-      }
-
-      MaterialPtr mat = this->scene->CreateMaterial();
-      if (material)
-      {
-        mat->CopyFrom(*material);
-        this->dataPtr->materialCache.push_back(mat);
-      }
-      else
-      {
-        MaterialPtr defaultMat = this->scene->Material("Default/White");
-        if (defaultMat != nullptr)
-          mat->CopyFrom(defaultMat);
-      }
-      ogreSubMesh->setMaterialName(mat->Name());
+      ogreSubMesh->setMaterialName(
+          this->CreateSubMeshMaterial(_desc, subMesh));
     }
 
     math::Vector3d max = _desc.mesh->Max();
@@ -566,6 +1388,31 @@ bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
   return true;
 }
 
+//////////////////////////////////////////////////
+std::string Ogre2MeshFactory::CreateSubMeshMaterial(
+    const MeshDescriptor &_desc, const common::SubMesh &_subMesh)
+{
+  common::MaterialPtr material;
+  if (const auto subMeshIdx = _subMesh.GetMaterialIndex())
+  {
+    material = _desc.mesh->MaterialByIndex(subMeshIdx.value());
+  }
+
+  MaterialPtr mat = this->scene->CreateMaterial();
+  if (material)
+  {
+    mat->CopyFrom(*material);
+    this->dataPtr->materialCache.push_back(mat);
+  }
+  else
+  {
+    MaterialPtr defaultMat = this->scene->Material("Default/White");
+    if (defaultMat != nullptr)
+      mat->CopyFrom(defaultMat);
+  }
+  return mat->Name();
+}
+
 //////////////////////////////////////////////////
 std::string Ogre2MeshFactory::MeshName(const MeshDescriptor &_desc)
 {
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include <gz/common/MeshManager.hh>
+
+#include "gz/rendering/MeshDescriptor.hh"
+#include "gz/rendering/Scene.hh"
+#include "gz/rendering/ogre2/Ogre2Includes.hh"
+#include "gz/rendering/ogre2/Ogre2Mesh.hh"
+#include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+/// \brief Load the engine
+/// \return The engine, null if it could not be initialized
+Ogre2RenderEngine *LoadEngine()
+{
+  Ogre2RenderEngine *engine = Ogre2RenderEngine::Instance();
+  if (!engine->IsInitialized())
+  {
+    std::map<std::string, std::string> params;
+    if (!engine->Load(params) || !engine->Init())
+      return nullptr;
+  }
+  return engine;
+}
+
+/// \brief Get the ogre item of a mesh
+/// \param[in] _mesh Mesh
+/// \return Ogre item, null if the mesh is not an ogre2 mesh
+Ogre::Item *OgreItem(const MeshPtr &_mesh)
+{
+  auto ogreMesh = std::dynamic_pointer_cast<Ogre2Mesh>(_mesh);
+  if (!ogreMesh)
+    return nullptr;
+  return dynamic_cast<Ogre::Item *>(ogreMesh->OgreObject());
+}
+
+/// \brief Find a vertex element of a VAO
+/// \param[in] _vao Vertex array object
+/// \param[in] _semantic Semantic of the element
+/// \return The element, null if the VAO has none with the semantic
+const Ogre::VertexElement2 *FindElement(const Ogre::VertexArrayObject *_vao,
+    Ogre::VertexElementSemantic _semantic)
+{
+  for (const auto *buffer : _vao->getVertexBuffers())
+  {
+    for (const auto &element : buffer->getVertexElements())
+    {
+      if (element.mSemantic == _semantic)
+        return &element;
+    }
+  }
+  return nullptr;
+}
+}
+
+/////////////////////////////////////////////////
+TEST(Ogre2MeshFactory, MeshLod)
+{
+  Ogre2RenderEngine *engine = LoadEngine();
+  if (!engine)
+    GTEST_SKIP() << "Unable to initialize the ogre2 render engine";
+
+  ScenePtr scene = engine->CreateScene("mesh_lod");
+  ASSERT_NE(nullptr, scene);
+
+  // thousands of triangles, dense enough to be simplified
+  common::MeshManager::Instance()->CreateSphere(
+      "ogre2_mesh_lod_sphere", 0.5f, 64, 64);
+  MeshDescriptor descriptor(common::MeshManager::Instance()->MeshByName(
+      "ogre2_mesh_lod_sphere"));
+  ASSERT_NE(nullptr, descriptor.mesh);
+
+  // without LODs there is a single VAO
+  MeshPtr mesh = scene->CreateMesh(descriptor);
+  Ogre::Item *item = OgreItem(mesh);
+  ASSERT_NE(nullptr, item);
+  ASSERT_EQ(1u, item->getMesh()->getNumSubMeshes());
+  EXPECT_EQ(1u,
+      item->getMesh()->getSubMesh(0)->mVao[Ogre::VpNormal].size());
+  scene->DestroyMesh(mesh);
+  engine->DestroyScene(scene);
+
+  scene = engine->CreateScene("mesh_lod");
+  ASSERT_NE(nullptr, scene);
+  scene->SetMeshLodEnabled(true);
+  mesh = scene->CreateMesh(descriptor);
+  item = OgreItem(mesh);
+  ASSERT_NE(nullptr, item);
+  ASSERT_EQ(1u, item->getMesh()->getNumSubMeshes());
+
+  // each LOD has fewer triangles and shares the vertices of the first one
+  const auto &vaos = item->getMesh()->getSubMesh(0)->mVao[Ogre::VpNormal];
+  ASSERT_LT(1u, vaos.size());
+  ASSERT_NE(nullptr, vaos[0]->getIndexBuffer());
+  for (size_t l = 1u; l < vaos.size(); ++l)
+  {
+    ASSERT_NE(nullptr, vaos[l]->getIndexBuffer());
+    EXPECT_LT(vaos[l]->getIndexBuffer()->getNumElements(),
+        vaos[l - 1u]->getIndexBuffer()->getNumElements()) << l;
+    EXPECT_EQ(vaos[0]->getVertexBuffers()[0],
+        vaos[l]->getVertexBuffers()[0]) << l;
+  }
+  EXPECT_EQ(vaos.size(),
+      item->getMesh()->getSubMesh(0)->mVao[Ogre::VpShadow].size());
+
+  // the item switches LODs at increasing distances
+  ASSERT_NE(nullptr, item->mLodMesh);
+  ASSERT_EQ(vaos.size(), item->mLodMesh->size());
+  for (size_t l = 1u; l < vaos.size(); ++l)
+    EXPECT_LE((*item->mLodMesh)[l - 1u], (*item->mLodMesh)[l]) << l;
+
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST(Ogre2MeshFactory, MeshQuantization)
+{
+  Ogre2RenderEngine *engine = LoadEngine();
+  if (!engine)
+    GTEST_SKIP() << "Unable to initialize the ogre2 render engine";
+
+  // full float normals and tangents
+  ScenePtr scene = engine->CreateScene("mesh_quantization");
+  ASSERT_NE(nullptr, scene);
+  Ogre::Item *item = OgreItem(scene->CreateMesh("unit_sphere"));
+  ASSERT_NE(nullptr, item);
+  const Ogre::VertexArrayObject *vao =
+      item->getMesh()->getSubMesh(0)->mVao[Ogre::VpNormal][0];
+  const Ogre::VertexElement2 *normal = FindElement(vao, Ogre::VES_NORMAL);
+  ASSERT_NE(nullptr, normal);
+  EXPECT_EQ(Ogre::VET_FLOAT3, normal->mType);
+  const Ogre::VertexElement2 *tangent = FindElement(vao, Ogre::VES_TANGENT);
+  ASSERT_NE(nullptr, tangent);
+  EXPECT_EQ(Ogre::VET_FLOAT4, tangent->mType);
+  engine->DestroyScene(scene);
+
+  // a QTangent replaces the normal and tangent
+  scene = engine->CreateScene("mesh_quantization");
+  ASSERT_NE(nullptr, scene);
+  scene->SetMeshQuantizationEnabled(true);
+  item = OgreItem(scene->CreateMesh("unit_sphere"));
+  ASSERT_NE(nullptr, item);
+  vao = item->getMesh()->getSubMesh(0)->mVao[Ogre::VpNormal][0];
+  normal = FindElement(vao, Ogre::VES_NORMAL);
+  ASSERT_NE(nullptr, normal);
+  EXPECT_EQ(Ogre::VET_SHORT4_SNORM, normal->mType);
+  EXPECT_EQ(nullptr, FindElement(vao, Ogre::VES_TANGENT));
+  const Ogre::VertexElement2 *position =
+      FindElement(vao, Ogre::VES_POSITION);
+  ASSERT_NE(nullptr, position);
+  EXPECT_EQ(Ogre::VET_FLOAT3, position->mType);
+
+  // 16 bit indices address all the vertices of small meshes
+  ASSERT_NE(nullptr, vao->getIndexBuffer());
+  EXPECT_GT(0x10000u, vao->getVertexBuffers()[0]->getNumElements());
+  EXPECT_EQ(Ogre::IndexBufferPacked::IT_16BIT,
+      vao->getIndexBuffer()->getIndexType());
+
+  // larger meshes need 32 bit indices
+  common::MeshManager::Instance()->CreateSphere(
+      "ogre2_mesh_quantization_sphere", 0.5f, 300, 300);
+  MeshDescriptor descriptor(common::MeshManager::Instance()->MeshByName(
+      "ogre2_mesh_quantization_sphere"));
+  ASSERT_NE(nullptr, descriptor.mesh);
+  item = OgreItem(scene->CreateMesh(descriptor));
+  ASSERT_NE(nullptr, item);
+  vao = item->getMesh()->getSubMesh(0)->mVao[Ogre::VpNormal][0];
+  ASSERT_NE(nullptr, vao->getIndexBuffer());
+  EXPECT_LE(0x10000u, vao->getVertexBuffers()[0]->getNumElements());
+  EXPECT_EQ(Ogre::IndexBufferPacked::IT_32BIT,
+      vao->getIndexBuffer()->getIndexType());
+
+  engine->DestroyScene(scene);
+}
@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+#include "Ogre2MeshSimplifier.hh"
+
+using namespace gz;
+using namespace rendering;
+
+//////////////////////////////////////////////////
+/// \brief Evaluate a quadric at a point
+/// \param[in] _q Quadric
+/// \param[in] _p Point
+/// \return Sum of the squared distances to the planes of the quadric
+static double QuadricError(const std::array<double, 10> &_q,
+    const math::Vector3d &_p)
+{
+  const double x = _p.X();
+  const double y = _p.Y();
+  const double z = _p.Z();
+  return _q[0] * x * x + 2 * _q[1] * x * y + 2 * _q[2] * x * z +
+      2 * _q[3] * x + _q[4] * y * y + 2 * _q[5] * y * z + 2 * _q[6] * y +
+      _q[7] * z * z + 2 * _q[8] * z + _q[9];
+}
+
+//////////////////////////////////////////////////
+Ogre2MeshSimplifier::Ogre2MeshSimplifier(
+    const std::vector<math::Vector3d> &_positions,
+    const std::vector<uint32_t> &_indices)
+  : positions(_positions), indices(_indices)
+{
+  const size_t vertexCount = this->positions.size();
+  const size_t count = this->indices.size() / 3u;
+  this->indices.resize(count * 3u);
+  for (uint32_t index : this->indices)
+  {
+    if (index >= vertexCount)
+    {
+      // invalid input, nothing can be simplified
+      this->indices.clear();
+      return;
+    }
+  }
+
+  // vertices that share a position are welded, the first one stands for
+  // all of them
+  this->canonical.resize(vertexCount);
+  std::map<std::array<double, 3>, uint32_t> byPosition;
+  for (uint32_t i = 0u; i < vertexCount; ++i)
+  {
+    const math::Vector3d &p = this->positions[i];
+    this->canonical[i] =
+        byPosition.emplace(std::array<double, 3>{p.X(), p.Y(), p.Z()}, i)
+        .first->second;
+  }
+
+  this->locked.assign(vertexCount, false);
+  this->quadrics.assign(vertexCount, Quadric{});
+  this->vertexTriangles.resize(vertexCount);
+  this->alive.assign(count, true);
+  this->triangleCount = count;
+
+  // a position with several used vertices lies on a seam
+  std::vector<uint32_t> usedVertex(vertexCount, UINT32_MAX);
+  for (uint32_t index : this->indices)
+  {
+    uint32_t &used = usedVertex[this->canonical[index]];
+    if (used == UINT32_MAX)
+      used = index;
+    else if (used != index)
+      this->locked[this->canonical[index]] = true;
+  }
+
+  // edges used by a single triangle lie on a border
+  std::unordered_map<uint64_t, unsigned int> edgeUse;
+  for (uint32_t t = 0u; t < count; ++t)
+  {
+    for (unsigned int k = 0u; k < 3u; ++k)
+    {
+      uint64_t a = this->canonical[this->indices[t * 3u + k]];
+      uint64_t b = this->canonical[this->indices[t * 3u + (k + 1u) % 3u]];
+      if (a > b)
+        std::swap(a, b);
+      edgeUse[(a << 32u) | b]++;
+    }
+  }
+  for (const auto &edge : edgeUse)
+  {
+    if (edge.second == 1u)
+    {
+      this->locked[static_cast<uint32_t>(edge.first >> 32u)] = true;
+      this->locked[static_cast<uint32_t>(edge.first & 0xffffffffu)] = true;
+    }
+  }
+
+  for (uint32_t t = 0u; t < count; ++t)
+  {
+    const uint32_t *tri = &this->indices[t * 3u];
+    for (unsigned int k = 0u; k < 3u; ++k)
+      this->vertexTriangles[this->canonical[tri[k]]].push_back(t);
+
+    const math::Vector3d &p0 = this->positions[tri[0]];
+    math::Vector3d n = (this->positions[tri[1]] - p0).Cross(
+        this->positions[tri[2]] - p0);
+    const double length = n.Length();
+    if (length <= 0.0)
+      continue;
+    n /= length;
+    const double d = -n.Dot(p0);
+    const Quadric q = {n.X() * n.X(), n.X() * n.Y(), n.X() * n.Z(),
+        n.X() * d, n.Y() * n.Y(), n.Y() * n.Z(), n.Y() * d,
+        n.Z() * n.Z(), n.Z() * d, d * d};
+    for (unsigned int k = 0u; k < 3u; ++k)
+    {
+      Quadric &vq = this->quadrics[this->canonical[tri[k]]];
+      for (unsigned int i = 0u; i < vq.size(); ++i)
+        vq[i] += q[i];
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+double Ogre2MeshSimplifier::Simplify(size_t _targetTriangleCount,
+    std::vector<uint32_t> &_indices)
+{
+  while (this->triangleCount > _targetTriangleCount &&
+      this->Pass(_targetTriangleCount))
+  {
+  }
+
+  _indices.clear();
+  _indices.reserve(this->triangleCount * 3u);
+  for (size_t t = 0u; t < this->alive.size(); ++t)
+  {
+    if (this->alive[t])
+    {
+      _indices.insert(_indices.end(), this->indices.begin() + t * 3u,
+          this->indices.begin() + t * 3u + 3u);
+    }
+  }
+  return std::sqrt(this->maxCost);
+}
+
+//////////////////////////////////////////////////
+size_t Ogre2MeshSimplifier::TriangleCount() const
+{
+  return this->triangleCount;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2MeshSimplifier::Pass(size_t _targetTriangleCount)
+{
+  // find the cheapest collapse of every vertex that may move
+  std::vector<Collapse> collapses;
+  for (uint32_t v = 0u; v < this->vertexTriangles.size(); ++v)
+  {
+    auto &triangles = this->vertexTriangles[v];
+    triangles.erase(std::remove_if(triangles.begin(), triangles.end(),
+        [&](uint32_t _t) { return !this->UsesPosition(_t, v); }),
+        triangles.end());
+    if (this->locked[v] || triangles.empty())
+      continue;
+
+    Collapse best{std::numeric_limits<double>::max(), 0u, 0u};
+    for (uint32_t t : triangles)
+    {
+      const uint32_t *tri = &this->indices[t * 3u];
+      for (unsigned int k = 0u; k < 3u; ++k)
+      {
+        if (this->canonical[tri[k]] != v)
+          continue;
+        for (unsigned int j = 1u; j < 3u; ++j)
+        {
+          const uint32_t to = tri[(k + j) % 3u];
+          if (this->canonical[to] == v)
+            continue;
+          const double cost = this->Cost(tri[k], to);
+          if (cost < best.cost)
+            best = Collapse{cost, tri[k], to};
+        }
+      }
+    }
+    if (best.cost < std::numeric_limits<double>::max())
+      collapses.push_back(best);
+  }
+
+  std::sort(collapses.begin(), collapses.end(),
+      [](const Collapse &_a, const Collapse &_b)
+      {
+        return _a.cost < _b.cost;
+      });
+
+  // a vertex whose quadric or neighbourhood changed in this pass waits for
+  // the next one, where its costs are computed again
+  std::vector<bool> touched(this->positions.size(), false);
+  bool applied = false;
+  for (const Collapse &collapse : collapses)
+  {
+    if (this->triangleCount <= _targetTriangleCount)
+      break;
+
+    const uint32_t cf = this->canonical[collapse.from];
+    const uint32_t ct = this->canonical[collapse.to];
+    if (touched[cf] || touched[ct] || !this->CanCollapse(collapse))
+      continue;
+
+    for (uint32_t t : this->vertexTriangles[cf])
+    {
+      if (!this->UsesPosition(t, cf))
+        continue;
+      const uint32_t *tri = &this->indices[t * 3u];
+      for (unsigned int k = 0u; k < 3u; ++k)
+        touched[this->canonical[tri[k]]] = true;
+    }
+    this->ApplyCollapse(collapse);
+    applied = true;
+  }
+  return applied;
+}
+
+//////////////////////////////////////////////////
+double Ogre2MeshSimplifier::Cost(uint32_t _from, uint32_t _to) const
+{
+  Quadric q = this->quadrics[this->canonical[_from]];
+  const Quadric &qt = this->quadrics[this->canonical[_to]];
+  for (unsigned int i = 0u; i < q.size(); ++i)
+    q[i] += qt[i];
+  return std::max(0.0, QuadricError(q, this->positions[_to]));
+}
+
+//////////////////////////////////////////////////
+bool Ogre2MeshSimplifier::UsesPosition(uint32_t _triangle,
+    uint32_t _position) const
+{
+  if (!this->alive[_triangle])
+    return false;
+  const uint32_t *tri = &this->indices[_triangle * 3u];
+  return this->canonical[tri[0]] == _position ||
+      this->canonical[tri[1]] == _position ||
+      this->canonical[tri[2]] == _position;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2MeshSimplifier::CanCollapse(const Collapse &_collapse) const
+{
+  const uint32_t cf = this->canonical[_collapse.from];
+  const uint32_t ct = this->canonical[_collapse.to];
+
+  // moving the removed vertex must not flip the triangles that remain
+  // around it
+  const math::Vector3d &target = this->positions[_collapse.to];
+  for (uint32_t t : this->vertexTriangles[cf])
+  {
+    if (!this->UsesPosition(t, cf) || this->UsesPosition(t, ct))
+      continue;
+
+    const uint32_t *tri = &this->indices[t * 3u];
+    math::Vector3d p[3];
+    math::Vector3d q[3];
+    for (unsigned int k = 0u; k < 3u; ++k)
+    {
+      p[k] = this->positions[tri[k]];
+      q[k] = tri[k] == _collapse.from ? target : p[k];
+    }
+    const math::Vector3d before = (p[1] - p[0]).Cross(p[2] - p[0]);
+    const math::Vector3d after = (q[1] - q[0]).Cross(q[2] - q[0]);
+    if (before.Dot(after) <= 0.0)
+      return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Ogre2MeshSimplifier::ApplyCollapse(const Collapse &_collapse)
+{
+  const uint32_t cf = this->canonical[_collapse.from];
+  const uint32_t ct = this->canonical[_collapse.to];
+
+  for (uint32_t t : this->vertexTriangles[cf])
+  {
+    if (!this->UsesPosition(t, cf))
+      continue;
+
+    if (this->UsesPosition(t, ct))
+    {
+      this->alive[t] = false;
+      this->triangleCount--;
+      continue;
+    }
+
+    uint32_t *tri = &this->indices[t * 3u];
+    for (unsigned int k = 0u; k < 3u; ++k)
+    {
+      if (tri[k] == _collapse.from)
+        tri[k] = _collapse.to;
+    }
+    this->vertexTriangles[ct].push_back(t);
+  }
+  this->vertexTriangles[cf].clear();
+
+  for (unsigned int i = 0u; i < this->quadrics[ct].size(); ++i)
+    this->quadrics[ct][i] += this->quadrics[cf][i];
+  this->maxCost = std::max(this->maxCost, _collapse.cost);
+
+  // the removed vertex is gone for good
+  this->locked[cf] = true;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2MESHSIMPLIFIER_HH_
+#define GZ_RENDERING_OGRE2_OGRE2MESHSIMPLIFIER_HH_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+#include "gz/rendering/config.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Quadric error metric simplifier of indexed triangle lists,
+    /// used to generate mesh LODs.
+    ///
+    /// Edges are collapsed onto one of their existing vertices, so every
+    /// simplified level indexes the original vertex buffer and only needs a
+    /// new index buffer. Vertices on open borders and on texture or normal
+    /// seams (several vertices at the same position) are never moved, which
+    /// keeps the outline and the attributes of the mesh intact.
+    ///
+    /// Edges are collapsed in passes. Each pass sorts the cheapest collapse
+    /// of every vertex and applies them in order, touching every vertex at
+    /// most once, so high valence vertices cannot absorb their whole
+    /// neighbourhood at once. Simplification is incremental: each call to
+    /// Simplify continues from the result of the previous call, so a whole
+    /// LOD chain is built from a single simplifier.
+    class Ogre2MeshSimplifier
+    {
+      /// \brief Constructor
+      /// \param[in] _positions Vertex positions
+      /// \param[in] _indices Triangle list indices
+      public: Ogre2MeshSimplifier(
+                  const std::vector<math::Vector3d> &_positions,
+                  const std::vector<uint32_t> &_indices);
+
+      /// \brief Collapse edges until at most _targetTriangleCount triangles
+      /// remain, or no edge can be collapsed anymore.
+      /// \param[in] _targetTriangleCount Target number of triangles
+      /// \param[out] _indices Indices of the remaining triangles
+      /// \return Geometric error of the result, in mesh units
+      public: double Simplify(size_t _targetTriangleCount,
+                  std::vector<uint32_t> &_indices);
+
+      /// \brief Get the current number of triangles
+      /// \return Number of triangles
+      public: size_t TriangleCount() const;
+
+      /// \brief Symmetric 4x4 quadric, upper triangle in row major order
+      private: using Quadric = std::array<double, 10>;
+
+      /// \brief Candidate collapse of a vertex onto a neighbour
+      private: struct Collapse
+      {
+        /// \brief Quadric error of the collapse
+        double cost;
+
+        /// \brief Vertex that is removed
+        uint32_t from;
+
+        /// \brief Vertex that remains
+        uint32_t to;
+      };
+
+      /// \brief Apply one pass of collapses
+      /// \param[in] _targetTriangleCount Stop when this many triangles remain
+      /// \return False if no collapse could be applied
+      private: bool Pass(size_t _targetTriangleCount);
+
+      /// \brief Get the quadric error of collapsing one vertex onto another
+      /// \param[in] _from Vertex that would be removed
+      /// \param[in] _to Vertex that would remain
+      /// \return Quadric error
+      private: double Cost(uint32_t _from, uint32_t _to) const;
+
+      /// \brief Check that a collapse does not flip any triangle
+      /// \param[in] _collapse Collapse to check
+      /// \return True if the collapse can be applied
+      private: bool CanCollapse(const Collapse &_collapse) const;
+
+      /// \brief Apply a collapse
+      /// \param[in] _collapse Collapse to apply
+      private: void ApplyCollapse(const Collapse &_collapse);
+
+      /// \brief Check if a triangle is alive and uses a position
+      /// \param[in] _triangle Triangle index
+      /// \param[in] _position Canonical vertex of the position
+      /// \return True if the triangle uses the position
+      private: bool UsesPosition(uint32_t _triangle, uint32_t _position) const;
+
+      /// \brief Vertex positions
+      private: std::vector<math::Vector3d> positions;
+
+      /// \brief First vertex with the same position as each vertex
+      private: std::vector<uint32_t> canonical;
+
+      /// \brief True for vertices that must not be moved
+      private: std::vector<bool> locked;
+
+      /// \brief Accumulated quadric of each canonical vertex
+      private: std::vector<Quadric> quadrics;
+
+      /// \brief Triangles that used each canonical vertex at some point.
+      /// Entries are checked with UsesPosition before use and are compacted
+      /// at the start of each pass.
+      private: std::vector<std::vector<uint32_t>> vertexTriangles;
+
+      /// \brief Triangle list indices
+      private: std::vector<uint32_t> indices;
+
+      /// \brief True for triangles that have not been collapsed
+      private: std::vector<bool> alive;
+
+      /// \brief Number of alive triangles
+      private: size_t triangleCount = 0u;
+
+      /// \brief Largest quadric error of the collapses applied so far
+      private: double maxCost = 0.0;
+    };
+    }
+  }
+}
+
+#endif
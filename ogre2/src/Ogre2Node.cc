@@ -72,9 +72,16 @@ void Ogre2Node::Destroy()
 
   if (nullptr != this->scene)
   {
-    Ogre::SceneManager *ogreSceneManager = this->scene->OgreSceneManager();
-    if (nullptr != ogreSceneManager)
-      ogreSceneManager->destroySceneNode(this->ogreNode);
+    if (this->recyclable)
+    {
+      this->scene->ReleaseOgreSceneNode(this->ogreNode);
+    }
+    else
+    {
+      Ogre::SceneManager *ogreSceneManager = this->scene->OgreSceneManager();
+      if (nullptr != ogreSceneManager)
+        ogreSceneManager->destroySceneNode(this->ogreNode);
+    }
   }
   this->ogreNode = nullptr;
 }
@@ -168,14 +175,17 @@ void Ogre2Node::Init()
     return;
   }
 
-  this->ogreNode = sceneManager->createSceneNode();
+  if (this->recyclable)
+    this->ogreNode = this->scene->AcquireOgreSceneNode();
+  else
+    this->ogreNode = sceneManager->createSceneNode();
   if (nullptr == this->ogreNode)
   {
     gzerr << "Failed to create Ogre node" << std::endl;
     return;
   }
   this->ogreNode->setInheritScale(true);
-  this->children = Ogre2NodeStorePtr(new Ogre2NodeStore);
+  this->children = std::make_shared<Ogre2NodeStore>();
 }
 
 //////////////////////////////////////////////////
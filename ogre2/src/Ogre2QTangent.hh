@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2QTANGENT_HH_
+#define GZ_RENDERING_OGRE2_OGRE2QTANGENT_HH_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include "gz/rendering/config.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreMatrix3.h>
+#include <OgreQuaternion.h>
+#include <OgreVector3.h>
+#include <OgreVector4.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Encode a normal and tangent as a QTangent, a quaternion of
+    /// the tangent frame stored as 4 signed normalized shorts, like
+    /// Ogre::Mesh::importV1 does when QTangents are requested. Hlms shaders
+    /// detect the format from the VET_SHORT4_SNORM normal element type.
+    /// \param[in] _normal Vertex normal
+    /// \param[in] _tangent Vertex tangent, w is the bitangent sign
+    /// \return QTangent in x, y, z, w order
+    inline std::array<int16_t, 4> EncodeQTangent(
+        const Ogre::Vector3 &_normal, const Ogre::Vector4 &_tangent)
+    {
+      Ogre::Vector3 n = _normal;
+      if (n.squaredLength() < 1e-12f)
+        n = Ogre::Vector3::UNIT_Z;
+      n.normalise();
+      Ogre::Vector3 t(_tangent.x, _tangent.y, _tangent.z);
+      t -= n * n.dotProduct(t);
+      if (t.squaredLength() < 1e-12f)
+        t = n.perpendicular();
+      t.normalise();
+
+      Ogre::Matrix3 tbn;
+      tbn.SetColumn(0, n);
+      tbn.SetColumn(1, t);
+      tbn.SetColumn(2, n.crossProduct(t));
+      Ogre::Quaternion q(tbn);
+      q.normalise();
+
+      // w is kept positive so that its sign can store the reflection. A
+      // bias keeps it away from 0, which has no sign once stored as an
+      // integer.
+      if (q.w < 0.0f)
+        q = -q;
+      const float bias = 1.0f / 32767.0f;
+      if (q.w < bias)
+      {
+        const float normFactor = std::sqrt(1.0f - bias * bias);
+        q.w = bias;
+        q.x *= normFactor;
+        q.y *= normFactor;
+        q.z *= normFactor;
+      }
+      if (_tangent.w < 0.0f)
+        q = -q;
+
+      std::array<int16_t, 4> result;
+      const float values[4] = {q.x, q.y, q.z, q.w};
+      for (unsigned int i = 0u; i < 4u; ++i)
+      {
+        result[i] = static_cast<int16_t>(
+            std::lround(std::clamp(values[i], -1.0f, 1.0f) * 32767.0f));
+      }
+      return result;
+    }
+
+    /// \brief Decode a QTangent written by EncodeQTangent
+    /// \param[in] _qTangent QTangent in x, y, z, w order
+    /// \param[out] _normal Vertex normal
+    /// \param[out] _tangent Vertex tangent, w is the bitangent sign
+    inline void DecodeQTangent(const std::array<int16_t, 4> &_qTangent,
+        Ogre::Vector3 &_normal, Ogre::Vector4 &_tangent)
+    {
+      Ogre::Quaternion q(
+          std::max(_qTangent[3] / 32767.0f, -1.0f),
+          std::max(_qTangent[0] / 32767.0f, -1.0f),
+          std::max(_qTangent[1] / 32767.0f, -1.0f),
+          std::max(_qTangent[2] / 32767.0f, -1.0f));
+      const float sign = q.w < 0.0f ? -1.0f : 1.0f;
+      q.normalise();
+      _normal = q.xAxis();
+      const Ogre::Vector3 t = q.yAxis();
+      _tangent = Ogre::Vector4(t.x, t.y, t.z, sign);
+    }
+    }
+  }
+}
+#endif
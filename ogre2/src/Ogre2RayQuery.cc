@@ -23,6 +23,7 @@
 #include "gz/rendering/ogre2/Ogre2Camera.hh"
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
 #include "gz/rendering/ogre2/Ogre2DepthCamera.hh"
+#include "gz/rendering/ogre2/Ogre2Heightmap.hh"
 #include "gz/rendering/ogre2/Ogre2ObjectInterface.hh"
 #include "gz/rendering/ogre2/Ogre2RayQuery.hh"
 #include "gz/rendering/ogre2/Ogre2Scene.hh"
@@ -61,6 +62,45 @@ class gz::rendering::Ogre2RayQueryPrivate
 using namespace gz;
 using namespace rendering;
 
+namespace
+{
+/// \brief Intersect a ray with the visible heightmaps of a scene, using
+/// their height data on the CPU
+/// \param[in] _scene Scene holding the heightmaps
+/// \param[in] _origin Origin of the ray
+/// \param[in] _direction Direction of the ray
+/// \param[out] _t Ray parameter of the closest intersection
+/// \param[out] _objectId Id of the visual of the heightmap hit
+/// \return True if a heightmap is hit
+bool IntersectHeightmaps(const Ogre2ScenePtr &_scene,
+    const math::Vector3d &_origin, const math::Vector3d &_direction,
+    double &_t, unsigned int &_objectId)
+{
+  bool hit = false;
+  for (const auto &weakHeightmap : _scene->Heightmaps())
+  {
+    Ogre2HeightmapPtr heightmap = weakHeightmap.lock();
+    if (!heightmap)
+      continue;
+
+    VisualPtr parent = heightmap->Parent();
+    Ogre::MovableObject *ogreObj = heightmap->OgreObject();
+    if (!parent || !ogreObj || !ogreObj->getVisible())
+      continue;
+
+    double t;
+    if (heightmap->Intersect(_origin, _direction, t) && t > 0.0 &&
+        (!hit || t < _t))
+    {
+      _t = t;
+      _objectId = parent->Id();
+      hit = true;
+    }
+  }
+  return hit;
+}
+}
+
 //////////////////////////////////////////////////
 Ogre2RayQuery::Ogre2RayQuery()
     : dataPtr(new Ogre2RayQueryPrivate)
@@ -190,8 +230,16 @@ RayQueryResult Ogre2RayQuery::ClosestPointBySelectionBuffer()
     }
     else
     {
-      // \todo(anyone) Change ExecuteQuery to return Ogre::MovableObject
-      // in gz-rendering8 so heightmaps can be included in the result
+      // The selection buffer does not return heightmaps, so find the one
+      // under the cursor on the CPU
+      Ogre2ScenePtr ogreScene =
+          std::dynamic_pointer_cast<Ogre2Scene>(this->Scene());
+      double t;
+      if (ogreScene)
+      {
+        IntersectHeightmaps(ogreScene, this->origin, this->direction, t,
+            objectId);
+      }
     }
     if (!std::isinf(distance))
     {
@@ -312,5 +360,17 @@ RayQueryResult Ogre2RayQuery::ClosestPointByIntersection(bool _forceSceneUpdate)
     }
   }
 
+  // Terra is not a mesh, heightmaps are intersected with their heights
+  double t;
+  unsigned int heightmapId;
+  if (IntersectHeightmaps(ogreScene, this->origin, this->direction, t,
+      heightmapId) && (distance < 0.0 || t < distance))
+  {
+    distance = t;
+    result.distance = distance;
+    result.point = this->origin + this->direction * t;
+    result.objectId = heightmapId;
+  }
+
   return result;
 }
@@ -20,6 +20,15 @@
   // pulled in by anybody (e.g., Boost).
   #include <Winsock2.h>
 #endif
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+#include <system_error>
+#include <unordered_set>
+#include <vector>
+
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
 #include <gz/common/StringUtils.hh>
@@ -37,6 +46,7 @@
 #include "gz/rendering/ogre2/Ogre2Scene.hh"
 #include "gz/rendering/ogre2/Ogre2Storage.hh"
 
+#include "Ogre2DiskCacheUtil.hh"
 #include "Ogre2GzHlmsPbsPrivate.hh"
 #include "Ogre2GzHlmsTerraPrivate.hh"
 #include "Ogre2GzHlmsUnlitPrivate.hh"
@@ -57,6 +67,17 @@
   #include <EGL/egl.h>
 #endif
 
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreArchive.h>
+#include <OgreArchiveManager.h>
+#include <OgreHlmsDiskCache.h>
+#include <OgreRenderSystemCapabilities.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
 class GZ_RENDERING_OGRE2_HIDDEN
     gz::rendering::Ogre2RenderEnginePrivate
 {
@@ -70,6 +91,39 @@ class GZ_RENDERING_OGRE2_HIDDEN
   /// \brief A list of supported fsaa levels
   public: std::vector<unsigned int> fsaaLevels;
 
+  /// \brief Directory of the on-disk mesh buffer cache, empty if disabled
+  public: std::string meshCachePath;
+
+  /// \brief Directory of the on-disk converted texture cache, empty if
+  /// disabled
+  public: std::string textureCachePath;
+
+  /// \brief Directory of the on-disk processed heightmap cache, empty if
+  /// disabled
+  public: std::string heightmapCachePath;
+
+  /// \brief Directory of the on-disk HLMS shader cache, empty if disabled
+  public: std::string hlmsCachePath;
+
+  /// \brief Subdirectory of hlmsCachePath matching the current HLMS
+  /// templates, render system and device. Empty until the cache is loaded,
+  /// which happens once per engine.
+  public: std::string hlmsCacheDir;
+
+  /// \brief All resource paths added with AddResourcePath, used to ignore
+  /// repeated additions
+  public: std::unordered_set<std::string> resourcePathSet;
+
+  /// \brief Resource paths added but not yet registered with OGRE
+  public: std::vector<std::string> pendingResourcePaths;
+
+  /// \brief Directories registered as recursive OGRE resource locations.
+  /// Their subdirectories are already indexed by OGRE.
+  public: std::vector<std::string> resourceDirs;
+
+  /// \brief Material scripts that were already parsed
+  public: std::unordered_set<std::string> parsedMaterialScripts;
+
   /// \brief Controls Hlms customizations for both PBS and Unlit
   public: gz::rendering::Ogre2GzHlmsSphericalClipMinDistance
   sphericalClipMinDistance;
@@ -94,6 +148,57 @@ class GZ_RENDERING_OGRE2_HIDDEN
 using namespace gz;
 using namespace rendering;
 
+namespace
+{
+/// \brief Count the resources indexed by OGRE in all resource groups
+/// \return Number of resources, 0 before the resource manager exists
+uint64_t StartupResourceCount()
+{
+  auto *mgr = Ogre::ResourceGroupManager::getSingletonPtr();
+  if (!mgr)
+    return 0u;
+
+  uint64_t count = 0u;
+  for (const auto &group : mgr->getResourceGroups())
+    count += mgr->listResourceNames(group)->size();
+  return count;
+}
+
+/// \brief Count the shader programs created by OGRE
+/// \return Number of shader programs, 0 before the program manager exists
+uint64_t StartupShaderCount()
+{
+  auto *mgr = Ogre::HighLevelGpuProgramManager::getSingletonPtr();
+  if (!mgr)
+    return 0u;
+
+  uint64_t count = 0u;
+  auto it = mgr->getResourceIterator();
+  while (it.hasMoreElements())
+  {
+    it.moveNext();
+    ++count;
+  }
+  return count;
+}
+
+/// \brief Version of the HLMS cache, part of the name of the cache
+/// directory. Increase it when the gz HLMS customizations change in a way
+/// that does not show in the templates.
+const uint32_t kHlmsCacheVersion = 1u;
+
+/// \brief Name of the shader microcode cache file
+const char kMicrocodeCacheFile[] = "microcode.bin";
+
+/// \brief Get the name of the HLMS disk cache file of an HLMS type
+/// \param[in] _type HLMS type
+/// \return File name
+std::string HlmsCacheFile(size_t _type)
+{
+  return "hlms" + std::to_string(_type) + ".bin";
+}
+}
+
 //////////////////////////////////////////////////
 Ogre2RenderEnginePlugin::Ogre2RenderEnginePlugin()
 {
@@ -158,6 +263,15 @@ void Ogre2RenderEngine::Destroy()
   delete this->ogreOverlaySystem;
   this->ogreOverlaySystem = nullptr;
 
+  this->SaveHlmsCache();
+  this->dataPtr->hlmsCacheDir.clear();
+
+  // resource locations and parsed materials go away with the root
+  this->dataPtr->resourcePathSet.clear();
+  this->dataPtr->pendingResourcePaths.clear();
+  this->dataPtr->resourceDirs.clear();
+  this->dataPtr->parsedMaterialScripts.clear();
+
   this->dataPtr->hlmsPbsTerraShadows.reset();
 
   if (this->ogreRoot)
@@ -244,19 +358,60 @@ void Ogre2RenderEngine::AddResourcePath(const std::string &_uri)
     return;
   }
 
+  // meshes and textures of the same model add the same path many times
+  if (!this->dataPtr->resourcePathSet.insert(path).second)
+    return;
+
   this->resourcePaths.push_back(path);
 
+  // Callers use the resource right after adding its path, so register it
+  // now. Paths added before the engine is loaded are registered by
+  // LoadResourcePaths once the root exists.
+  this->dataPtr->pendingResourcePaths.push_back(path);
+  this->LoadResourcePaths();
+}
+
+//////////////////////////////////////////////////
+void Ogre2RenderEngine::LoadResourcePaths()
+{
+  if (this->dataPtr->pendingResourcePaths.empty() || !this->ogreRoot)
+    return;
+
+  std::vector<std::string> pending;
+  pending.swap(this->dataPtr->pendingResourcePaths);
+
+  Ogre::ResourceGroupManager &resourceMgr =
+      Ogre::ResourceGroupManager::getSingleton();
+
+  // a directory inside a recursive location is already indexed by OGRE
+  auto indexed = [this](const std::string &_path)
+  {
+    for (const auto &dir : this->dataPtr->resourceDirs)
+    {
+      if (_path.size() > dir.size() &&
+          _path.compare(0u, dir.size(), dir) == 0 &&
+          (_path[dir.size()] == '/' || _path[dir.size()] == '\\'))
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  std::vector<std::string> materialScripts;
   try
   {
-    if (!Ogre::ResourceGroupManager::getSingleton().resourceLocationExists(
-          path, "General"))
+    for (const auto &path : pending)
     {
-      Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
-          path, "FileSystem", "General", true);
+      if (!indexed(path) && !resourceMgr.resourceLocationExists(
+            path, "General"))
+      {
+        resourceMgr.addResourceLocation(path, "FileSystem", "General", true);
+        if (common::isDirectory(path))
+          this->dataPtr->resourceDirs.push_back(path);
+      }
 
-      Ogre::ResourceGroupManager::getSingleton().initialiseResourceGroup(
-          "General", false);
-      // Parse all material files in the path if any exist
+      // Collect the material files in the path if any exist
       if (common::isDirectory(path))
       {
         std::vector<std::string> paths;
@@ -268,42 +423,49 @@ void Ogre2RenderEngine::AddResourcePath(const std::string &_uri)
         }
         std::sort(paths.begin(), paths.end());
 
-        // Iterate over all the models in the current gz-rendering path
-        for (auto dIter = paths.begin(); dIter != paths.end(); ++dIter)
+        for (const auto &fullPath : paths)
         {
-          std::string fullPath = *dIter;
-          std::string matExtension = fullPath.substr(fullPath.size()-9);
-          if (matExtension == ".material")
+          if (common::EndsWith(fullPath, ".material") &&
+              this->dataPtr->parsedMaterialScripts.insert(fullPath).second)
           {
-            Ogre::DataStreamPtr stream =
-              Ogre::ResourceGroupManager::getSingleton().openResource(
-                  fullPath, "General");
-
-            // There is a material file under there somewhere, read the thing in
-            try
-            {
-              Ogre::MaterialManager::getSingleton().parseScript(
-                  stream, "General");
-              Ogre::MaterialPtr matPtr =
-                Ogre::MaterialManager::getSingleton().getByName(
-                    fullPath);
-
-              if (!matPtr.isNull())
-              {
-                // is this necessary to do here? Someday try it without
-                matPtr->compile();
-                matPtr->load();
-              }
-            }
-            catch(Ogre::Exception&)
-            {
-              gzerr << "Unable to parse material file[" << fullPath << "]\n";
-            }
-            stream->close();
+            materialScripts.push_back(fullPath);
           }
         }
       }
     }
+
+    // the group only has to be initialised once, new locations of an
+    // initialised group are indexed when they are added
+    if (!resourceMgr.isResourceGroupInitialised("General"))
+      resourceMgr.initialiseResourceGroup("General", false);
+
+    for (const auto &fullPath : materialScripts)
+    {
+      Ogre::DataStreamPtr stream =
+        resourceMgr.openResource(fullPath, "General");
+
+      // There is a material file under there somewhere, read the thing in
+      try
+      {
+        Ogre::MaterialManager::getSingleton().parseScript(
+            stream, "General");
+        Ogre::MaterialPtr matPtr =
+          Ogre::MaterialManager::getSingleton().getByName(
+              fullPath);
+
+        if (!matPtr.isNull())
+        {
+          // is this necessary to do here? Someday try it without
+          matPtr->compile();
+          matPtr->load();
+        }
+      }
+      catch(Ogre::Exception&)
+      {
+        gzerr << "Unable to parse material file[" << fullPath << "]\n";
+      }
+      stream->close();
+    }
   }
   catch(Ogre::Exception &)
   {
@@ -368,6 +530,54 @@ bool Ogre2RenderEngine::LoadImpl(
         this->dataPtr->graphicsAPI = GraphicsAPI::VULKAN;
   }
 
+  it = _params.find("meshCachePath");
+  if (it != _params.end())
+  {
+    this->dataPtr->meshCachePath = it->second;
+  }
+  else
+  {
+    const char *env = std::getenv("GZ_RENDERING_MESH_CACHE_PATH");
+    if (env)
+      this->dataPtr->meshCachePath = env;
+  }
+
+  it = _params.find("textureCachePath");
+  if (it != _params.end())
+  {
+    this->dataPtr->textureCachePath = it->second;
+  }
+  else
+  {
+    const char *env = std::getenv("GZ_RENDERING_TEXTURE_CACHE_PATH");
+    if (env)
+      this->dataPtr->textureCachePath = env;
+  }
+
+  it = _params.find("heightmapCachePath");
+  if (it != _params.end())
+  {
+    this->dataPtr->heightmapCachePath = it->second;
+  }
+  else
+  {
+    const char *env = std::getenv("GZ_RENDERING_HEIGHTMAP_CACHE_PATH");
+    if (env)
+      this->dataPtr->heightmapCachePath = env;
+  }
+
+  it = _params.find("hlmsCachePath");
+  if (it != _params.end())
+  {
+    this->dataPtr->hlmsCachePath = it->second;
+  }
+  else
+  {
+    const char *env = std::getenv("GZ_RENDERING_HLMS_CACHE_PATH");
+    if (env)
+      this->dataPtr->hlmsCachePath = env;
+  }
+
   try
   {
     this->LoadAttempt();
@@ -386,6 +596,207 @@ bool Ogre2RenderEngine::LoadImpl(
   }
 }
 
+//////////////////////////////////////////////////
+std::string Ogre2RenderEngine::MeshCachePath() const
+{
+  return this->dataPtr->meshCachePath;
+}
+
+//////////////////////////////////////////////////
+std::string Ogre2RenderEngine::TextureCachePath() const
+{
+  return this->dataPtr->textureCachePath;
+}
+
+//////////////////////////////////////////////////
+std::string Ogre2RenderEngine::HeightmapCachePath() const
+{
+  return this->dataPtr->heightmapCachePath;
+}
+
+//////////////////////////////////////////////////
+std::string Ogre2RenderEngine::HlmsCachePath() const
+{
+  return this->dataPtr->hlmsCachePath;
+}
+
+//////////////////////////////////////////////////
+void Ogre2RenderEngine::LoadHlmsCache(const std::string &_hlmsFolder)
+{
+  // RegisterHlms runs for every render window, the cache is only loaded
+  // with the first one until the engine is destroyed
+  if (this->dataPtr->hlmsCachePath.empty() ||
+      !this->dataPtr->hlmsCacheDir.empty())
+  {
+    return;
+  }
+
+  // hash the templates, including the gz customizations, so that editing
+  // any of them starts a new cache
+  std::vector<std::filesystem::path> files;
+  std::error_code ec;
+  for (std::filesystem::recursive_directory_iterator it(_hlmsFolder, ec);
+       !ec && it != std::filesystem::recursive_directory_iterator();
+       it.increment(ec))
+  {
+    if (it->is_regular_file(ec))
+      files.push_back(it->path());
+  }
+  std::sort(files.begin(), files.end());
+
+  uint64_t hash = kFnvOffset;
+  for (const auto &file : files)
+  {
+    const std::string relative =
+        file.lexically_relative(_hlmsFolder).generic_string();
+    hash = Fnv1a(relative.data(), relative.size(), hash);
+    uint64_t size = 0u;
+    HashFile(file.string(), hash, size);
+  }
+
+  // shaders compiled for another render system, device or driver can't be
+  // reused
+  Ogre::RenderSystem *renderSys = this->ogreRoot->getRenderSystem();
+  const Ogre::RenderSystemCapabilities *caps = renderSys->getCapabilities();
+  const std::string key = renderSys->getName() + "\n" +
+      caps->getDeviceName() + "\n" +
+      caps->getDriverVersion().toString() + "\n" +
+      std::string(OGRE2_VERSION) + "\n" + GZ_RENDERING_VERSION_FULL;
+  hash = Fnv1a(key.data(), key.size(), hash);
+
+  this->dataPtr->hlmsCacheDir = common::joinPaths(
+      this->dataPtr->hlmsCachePath,
+      "v" + std::to_string(kHlmsCacheVersion) + "-" + CacheKeyString(hash));
+
+  // microcodes are only kept if this is set before shaders are compiled
+  Ogre::GpuProgramManager &programMgr =
+      Ogre::GpuProgramManager::getSingleton();
+  programMgr.setSaveMicrocodesToCache(true);
+
+  if (!common::isDirectory(this->dataPtr->hlmsCacheDir))
+    return;
+
+  Ogre::ArchiveManager &archiveManager = Ogre::ArchiveManager::getSingleton();
+  Ogre::Archive *archive = archiveManager.load(
+      this->dataPtr->hlmsCacheDir, "FileSystem", true);
+
+  // microcodes are loaded first so the cached shaders below don't need to
+  // be compiled
+  try
+  {
+    if (archive->exists(kMicrocodeCacheFile))
+    {
+      Ogre::DataStreamPtr stream = archive->open(kMicrocodeCacheFile);
+      programMgr.loadMicrocodeCache(stream);
+    }
+  }
+  catch (Ogre::Exception &_e)
+  {
+    gzwarn << "Unable to load the shader microcode cache from ["
+           << this->dataPtr->hlmsCacheDir << "]: " << _e.getDescription()
+           << std::endl;
+  }
+
+  Ogre::HlmsManager *hlmsManager = this->ogreRoot->getHlmsManager();
+  Ogre::HlmsDiskCache diskCache(hlmsManager);
+  for (size_t i = Ogre::HLMS_LOW_LEVEL + 1u; i < Ogre::HLMS_MAX; ++i)
+  {
+    Ogre::Hlms *hlms = hlmsManager->getHlms(static_cast<Ogre::HlmsTypes>(i));
+    const std::string fileName = HlmsCacheFile(i);
+    if (!hlms || !archive->exists(fileName))
+      continue;
+
+    try
+    {
+      Ogre::DataStreamPtr stream = archive->open(fileName);
+      diskCache.loadFrom(stream);
+      diskCache.applyTo(hlms);
+    }
+    catch (Ogre::Exception &_e)
+    {
+      gzwarn << "Unable to load the HLMS cache [" << fileName << "] from ["
+             << this->dataPtr->hlmsCacheDir << "]: " << _e.getDescription()
+             << std::endl;
+    }
+  }
+
+  archiveManager.unload(archive);
+}
+
+//////////////////////////////////////////////////
+bool Ogre2RenderEngine::SaveHlmsCache()
+{
+  const std::string &dir = this->dataPtr->hlmsCacheDir;
+  if (dir.empty() || !this->ogreRoot || !this->ogreRoot->getRenderSystem())
+    return false;
+
+  if (!common::isDirectory(dir) && !common::createDirectories(dir))
+  {
+    gzwarn << "Unable to create HLMS cache directory [" << dir << "]"
+           << std::endl;
+    return false;
+  }
+
+  // other processes may load or save the same cache at the same time, so
+  // files are written to a temporary name and renamed
+  const std::string suffix = TempCacheSuffix();
+  auto commit = [&](const std::string &_fileName)
+  {
+    std::string error;
+    if (!CommitCacheFile(common::joinPaths(dir, _fileName + suffix),
+        common::joinPaths(dir, _fileName), error))
+    {
+      gzwarn << "Unable to write HLMS cache file [" << _fileName << "] to ["
+             << dir << "]: " << error << std::endl;
+      return false;
+    }
+    return true;
+  };
+
+  Ogre::ArchiveManager &archiveManager = Ogre::ArchiveManager::getSingleton();
+  Ogre::Archive *archive = archiveManager.load(dir, "FileSystem", false);
+  bool result = true;
+  try
+  {
+    Ogre::HlmsManager *hlmsManager = this->ogreRoot->getHlmsManager();
+    Ogre::HlmsDiskCache diskCache(hlmsManager);
+    for (size_t i = Ogre::HLMS_LOW_LEVEL + 1u; i < Ogre::HLMS_MAX; ++i)
+    {
+      Ogre::Hlms *hlms =
+          hlmsManager->getHlms(static_cast<Ogre::HlmsTypes>(i));
+      if (!hlms)
+        continue;
+
+      const std::string fileName = HlmsCacheFile(i);
+      diskCache.copyFrom(hlms);
+      Ogre::DataStreamPtr stream = archive->create(fileName + suffix);
+      diskCache.saveTo(stream);
+      stream->close();
+      result = commit(fileName) && result;
+    }
+
+    Ogre::GpuProgramManager &programMgr =
+        Ogre::GpuProgramManager::getSingleton();
+    if (programMgr.isCacheDirty())
+    {
+      Ogre::DataStreamPtr stream =
+          archive->create(std::string(kMicrocodeCacheFile) + suffix);
+      programMgr.saveMicrocodeCache(stream);
+      stream->close();
+      result = commit(kMicrocodeCacheFile) && result;
+    }
+  }
+  catch (Ogre::Exception &_e)
+  {
+    gzwarn << "Unable to save the HLMS cache to [" << dir << "]: "
+           << _e.getDescription() << std::endl;
+    result = false;
+  }
+
+  archiveManager.unload(archive);
+  return result;
+}
+
 //////////////////////////////////////////////////
 bool Ogre2RenderEngine::InitImpl()
 {
@@ -407,21 +818,32 @@ bool Ogre2RenderEngine::InitImpl()
 //////////////////////////////////////////////////
 void Ogre2RenderEngine::LoadAttempt()
 {
-  this->CreateLogger();
+  auto phase = [this](const std::string &_name,
+      const std::function<void()> &_func)
+  {
+    const uint64_t resources = StartupResourceCount();
+    const uint64_t shaders = StartupShaderCount();
+    const auto start = std::chrono::steady_clock::now();
+    _func();
+    this->RecordStartupPhase(_name, start,
+        StartupResourceCount() - resources, StartupShaderCount() - shaders);
+  };
+
+  phase("CreateLogger", [this]{this->CreateLogger();});
   if (!this->useCurrentGLContext &&
       (this->dataPtr->graphicsAPI == GraphicsAPI::OPENGL ||
        this->dataPtr->graphicsAPI == GraphicsAPI::VULKAN))
   {
-    this->CreateContext();
+    phase("CreateContext", [this]{this->CreateContext();});
   }
 
-  this->CreateRoot();
-  this->CreateOverlay();
-  this->LoadPlugins();
-  this->CreateRenderSystem();
-  this->ogreRoot->initialise(false);
-  this->CreateRenderWindow();
-  this->CreateResources();
+  phase("CreateRoot", [this]{this->CreateRoot();});
+  phase("CreateOverlay", [this]{this->CreateOverlay();});
+  phase("LoadPlugins", [this]{this->LoadPlugins();});
+  phase("CreateRenderSystem", [this]{this->CreateRenderSystem();});
+  phase("InitialiseRoot", [this]{this->ogreRoot->initialise(false);});
+  phase("CreateRenderWindow", [this]{this->CreateRenderWindow();});
+  phase("CreateResources", [this]{this->CreateResources();});
 }
 
 //////////////////////////////////////////////////
@@ -959,6 +1381,8 @@ void Ogre2RenderEngine::RegisterHlms()
 
     this->dataPtr->gzHlmsTerra = hlmsTerra;
   }
+
+  this->LoadHlmsCache(common::joinPaths(rootHlmsFolder, "Hlms"));
 }
 
 //////////////////////////////////////////////////
@@ -1150,7 +1574,19 @@ std::string Ogre2RenderEngine::CreateRenderWindow(const std::string &_handle,
     return std::string();
   }
 
-  this->RegisterHlms();
+  if (this->loaded)
+  {
+    this->RegisterHlms();
+  }
+  else
+  {
+    const uint64_t resources = StartupResourceCount();
+    const uint64_t shaders = StartupShaderCount();
+    const auto start = std::chrono::steady_clock::now();
+    this->RegisterHlms();
+    this->RecordStartupPhase("RegisterHlms", start,
+        StartupResourceCount() - resources, StartupShaderCount() - shaders);
+  }
 
   if (this->window)
   {
@@ -1174,7 +1610,12 @@ void Ogre2RenderEngine::InitAttempt()
   this->initialized = false;
 
   // init the resources
+  const uint64_t resources = StartupResourceCount();
+  const uint64_t shaders = StartupShaderCount();
+  const auto start = std::chrono::steady_clock::now();
   Ogre::ResourceGroupManager::getSingleton().initialiseAllResourceGroups(false);
+  this->RecordStartupPhase("InitialiseResourceGroups", start,
+      StartupResourceCount() - resources, StartupShaderCount() - shaders);
 
   this->scenes = Ogre2SceneStorePtr(new Ogre2SceneStore);
 }
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "gz/rendering/Camera.hh"
+#include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
+#include "gz/rendering/ogre2/Ogre2Includes.hh"
+#include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
+#include "Ogre2TestDirectory.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+/// \brief Directory of the HLMS cache. The engine is loaded once per
+/// process, so the tests share it.
+/// \return The directory
+const Ogre2TestDirectory &CacheDirectory()
+{
+  static const Ogre2TestDirectory dir("ogre2_hlms_cache");
+  return dir;
+}
+
+/// \brief Path of the HLMS cache of the tests
+/// \return The path
+std::string HlmsCacheDir()
+{
+  return CacheDirectory().Path("hlms");
+}
+
+/// \brief Load the engine, with the HLMS cache in the test directory
+/// \return The engine, null if it could not be initialized
+Ogre2RenderEngine *LoadEngine()
+{
+  Ogre2RenderEngine *engine = Ogre2RenderEngine::Instance();
+  if (!engine->IsInitialized())
+  {
+    std::map<std::string, std::string> params;
+    params["hlmsCachePath"] = HlmsCacheDir();
+    if (!engine->Load(params) || !engine->Init())
+      return nullptr;
+  }
+  return engine;
+}
+
+/// \brief Count the shader programs created by ogre
+/// \return Number of shader programs
+size_t ShaderCount()
+{
+  size_t count = 0u;
+  auto it =
+      Ogre::HighLevelGpuProgramManager::getSingleton().getResourceIterator();
+  while (it.hasMoreElements())
+  {
+    it.moveNext();
+    ++count;
+  }
+  return count;
+}
+
+/// \brief List the subdirectories of a directory
+/// \param[in] _dir Directory
+/// \return Subdirectories
+std::vector<std::filesystem::path> SubDirectories(const std::string &_dir)
+{
+  std::vector<std::filesystem::path> dirs;
+  std::error_code ec;
+  for (std::filesystem::directory_iterator it(_dir, ec);
+       !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+  {
+    if (it->is_directory(ec))
+      dirs.push_back(it->path());
+  }
+  return dirs;
+}
+}
+
+/////////////////////////////////////////////////
+TEST(Ogre2RenderEngine, AddResourcePath)
+{
+  Ogre2RenderEngine *engine = LoadEngine();
+  if (!engine)
+    GTEST_SKIP() << "Unable to initialize the ogre2 render engine";
+
+  Ogre2TestDirectory dir("ogre2_resource_path");
+  ASSERT_TRUE(dir.Valid());
+
+  dir.WriteFile("gz_resource_probe.png", "probe");
+  dir.WriteFile("gz_resource_probe.material",
+      "material GzResourceProbe\n"
+      "{\n"
+      "  technique\n"
+      "  {\n"
+      "    pass\n"
+      "    {\n"
+      "    }\n"
+      "  }\n"
+      "}\n");
+
+  Ogre::ResourceGroupManager &resourceMgr =
+      Ogre::ResourceGroupManager::getSingleton();
+  EXPECT_FALSE(resourceMgr.resourceExistsInAnyGroup("gz_resource_probe.png"));
+
+  // resources resolve right after adding the path, no scene has to render
+  // first
+  engine->AddResourcePath(dir.Path());
+  EXPECT_TRUE(resourceMgr.resourceExistsInAnyGroup("gz_resource_probe.png"));
+  EXPECT_FALSE(Ogre::MaterialManager::getSingleton().getByName(
+      "GzResourceProbe").isNull());
+
+  // adding the same path again does not parse the script again, which
+  // would throw on the duplicate material
+  engine->AddResourcePath(dir.Path());
+  EXPECT_FALSE(Ogre::MaterialManager::getSingleton().getByName(
+      "GzResourceProbe").isNull());
+}
+
+/////////////////////////////////////////////////
+TEST(Ogre2RenderEngine, HlmsCache)
+{
+  Ogre2RenderEngine *engine = LoadEngine();
+  if (!engine)
+    GTEST_SKIP() << "Unable to initialize the ogre2 render engine";
+  const std::string hlmsCacheDir = HlmsCacheDir();
+  ASSERT_EQ(hlmsCacheDir, engine->HlmsCachePath());
+
+  // start from an empty cache
+  engine->Destroy();
+  std::filesystem::remove_all(hlmsCacheDir);
+  engine = LoadEngine();
+  ASSERT_NE(nullptr, engine);
+  const size_t emptyCacheShaderCount = ShaderCount();
+
+  // render a box to generate some shaders
+  auto render = [&]()
+  {
+    ScenePtr scene = engine->CreateScene("hlms_cache");
+    ASSERT_NE(nullptr, scene);
+    VisualPtr box = scene->CreateVisual();
+    box->AddGeometry(scene->CreateBox());
+    box->SetMaterial(scene->CreateMaterial(), false);
+    box->SetLocalPosition(2, 0, 0);
+    scene->RootVisual()->AddChild(box);
+    CameraPtr camera = scene->CreateCamera();
+    ASSERT_NE(nullptr, camera);
+    camera->SetImageWidth(32u);
+    camera->SetImageHeight(32u);
+    scene->RootVisual()->AddChild(camera);
+    camera->Update();
+    engine->DestroyScene(scene);
+  };
+  render();
+
+  // the caches are saved in a single directory for this device
+  EXPECT_TRUE(engine->SaveHlmsCache());
+  auto dirs = SubDirectories(hlmsCacheDir);
+  ASSERT_EQ(1u, dirs.size());
+  const std::filesystem::path cacheDir = dirs[0];
+  size_t hlmsFileCount = 0u;
+  std::error_code ec;
+  for (std::filesystem::directory_iterator it(cacheDir, ec);
+       !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+  {
+    const std::string fileName = it->path().filename().string();
+    if (fileName.rfind("hlms", 0) == 0u && it->path().extension() == ".bin")
+    {
+      EXPECT_LT(0u, std::filesystem::file_size(it->path()));
+      ++hlmsFileCount;
+    }
+  }
+  EXPECT_LT(0u, hlmsFileCount);
+
+  // reloading the engine compiles the cached shaders up front
+  engine->Destroy();
+  engine = LoadEngine();
+  ASSERT_NE(nullptr, engine);
+  EXPECT_LT(emptyCacheShaderCount, ShaderCount());
+  dirs = SubDirectories(hlmsCacheDir);
+  ASSERT_EQ(1u, dirs.size());
+  EXPECT_EQ(cacheDir, dirs[0]);
+
+  render();
+  EXPECT_TRUE(engine->SaveHlmsCache());
+  EXPECT_EQ(1u, SubDirectories(hlmsCacheDir).size());
+}
@@ -92,9 +92,6 @@ class gz::rendering::Ogre2RenderTargetPrivate
   /// \brief Name of final rendering compositor node
   public: const std::string kFinalNodeName = "FinalComposition";
 
-  /// \brief Name of shadow compositor node
-  public: const std::string kShadowNodeName = "PbsMaterialsShadowNode";
-
   /// \brief Pointer to the internal ogre render texture objects
   /// There's two because we ping pong postprocessing effects
   /// and the final result is always in ogreTexture[1]
@@ -197,7 +194,7 @@ void Ogre2RenderTarget::BuildCompositor()
         Ogre::CompositorPassSceneDef *passScene =
             static_cast<Ogre::CompositorPassSceneDef *>(
             rt0TargetDef->addPass(Ogre::PASS_SCENE));
-        passScene->mShadowNode = this->dataPtr->kShadowNodeName;
+        passScene->mShadowNode = this->scene->ShadowNodeName();
         passScene->mIncludeOverlays = false;
         passScene->mFirstRQ = 0u;
         passScene->mLastRQ = 2u;
@@ -233,7 +230,7 @@ void Ogre2RenderTarget::BuildCompositor()
             static_cast<Ogre::CompositorPassSceneDef *>(
             rt0TargetDef->addPass(Ogre::PASS_SCENE));
         passScene->mIncludeOverlays = true;
-        passScene->mShadowNode = this->dataPtr->kShadowNodeName;
+        passScene->mShadowNode = this->scene->ShadowNodeName();
         passScene->mFirstRQ = 2u;
       }
     }
@@ -496,7 +493,8 @@ void Ogre2RenderTarget::PostRender()
 //////////////////////////////////////////////////
 void Ogre2RenderTarget::Render()
 {
-  this->scene->StartRendering(this->ogreCamera);
+  this->scene->StartRendering(this->ogreCamera,
+      this->allowPlaceholderTextures);
 
   this->ogreCompositorWorkspace->_validateFinalTarget();
   this->ogreCompositorWorkspace->_beginUpdate(false);
@@ -643,6 +641,18 @@ void Ogre2RenderTarget::SetVisibilityMask(uint32_t _mask)
   this->visibilityMask = _mask;
 }
 
+//////////////////////////////////////////////////
+void Ogre2RenderTarget::SetAllowPlaceholderTextures(bool _allow)
+{
+  this->allowPlaceholderTextures = _allow;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2RenderTarget::AllowPlaceholderTextures() const
+{
+  return this->allowPlaceholderTextures;
+}
+
 //////////////////////////////////////////////////
 void Ogre2RenderTarget::UpdateBackgroundColor()
 {
@@ -874,10 +884,46 @@ void Ogre2RenderTarget::SetMaterial(MaterialPtr _material)
 //////////////////////////////////////////////////
 void Ogre2RenderTarget::SetShadowsNodeDefDirty()
 {
-  this->DestroyCompositor();
+  SetShadowNode(this->ogreCompositorWorkspace,
+      this->ogreCompositorWorkspaceDefName + "/" +
+      this->dataPtr->kBaseNodeName,
+      this->scene->ShadowNodeName());
+}
 
-  // Have to rebuild the target so there is something to apply the applicator to
-  this->targetDirty = true;
+//////////////////////////////////////////////////
+void Ogre2RenderTarget::SetShadowNode(Ogre::CompositorWorkspace *_workspace,
+    const std::string &_baseNode, const std::string &_shadowNodeName)
+{
+  if (!_workspace || _baseNode.empty())
+    return;
+
+  auto engine = Ogre2RenderEngine::Instance();
+  auto ogreRoot = engine->OgreRoot();
+  Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
+  if (!ogreCompMgr->hasNodeDefinition(_baseNode))
+    return;
+
+  // point the scene passes that render shadows to the new definition
+  Ogre::CompositorNodeDef *nodeDef =
+      ogreCompMgr->getNodeDefinitionNonConst(_baseNode);
+  for (size_t i = 0u; i < nodeDef->getNumTargetPasses(); ++i)
+  {
+    Ogre::CompositorPassDefVec &passes =
+        nodeDef->getTargetPass(i)->getCompositorPassesNonConst();
+    for (Ogre::CompositorPassDef *pass : passes)
+    {
+      if (pass->getType() != Ogre::PASS_SCENE)
+        continue;
+      Ogre::CompositorPassSceneDef *passScene =
+          static_cast<Ogre::CompositorPassSceneDef *>(pass);
+      if (passScene->mShadowNode != Ogre::IdString())
+        passScene->mShadowNode = _shadowNodeName;
+    }
+  }
+
+  // Only the nodes are recreated. The workspace keeps its listeners,
+  // external textures and render pass connections.
+  _workspace->recreateAllNodes();
 }
 
 //////////////////////////////////////////////////
@@ -15,6 +15,10 @@
  *
  */
 
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
 #include <gz/common/Console.hh>
 
 #include "gz/rendering/base/SceneExt.hh"
@@ -33,6 +37,7 @@
 #include "gz/rendering/ogre2/Ogre2Grid.hh"
 #include "gz/rendering/ogre2/Ogre2Heightmap.hh"
 #include "gz/rendering/ogre2/Ogre2InertiaVisual.hh"
+#include "gz/rendering/ogre2/Ogre2InstancedVisual.hh"
 #include "gz/rendering/ogre2/Ogre2JointVisual.hh"
 #include "gz/rendering/ogre2/Ogre2Light.hh"
 #include "gz/rendering/ogre2/Ogre2LightVisual.hh"
@@ -62,10 +67,14 @@
 #include <Compositor/Pass/PassQuad/OgreCompositorPassQuadDef.h>
 #include <Compositor/Pass/PassScene/OgreCompositorPassSceneDef.h>
 #include <OgreDepthBuffer.h>
+#include <OgreItem.h>
 #include <OgreMatrix4.h>
+#include <OgreMesh2.h>
 #include <OgrePlatformInformation.h>
 #include <OgreRoot.h>
 #include <OgreSceneManager.h>
+#include <OgreSubItem.h>
+#include <OgreSubMesh2.h>
 #include <Overlay/OgreOverlayManager.h>
 #include <Overlay/OgreOverlaySystem.h>
 #if OGRE_VERSION_MAJOR == 2 && OGRE_VERSION_MINOR == 1
@@ -73,6 +82,7 @@
 #include <OgreHlmsManager.h>
 #endif
 
+#include "Ogre2StaticBatcher.hh"
 #include "Terra/Terra.h"
 #include "Terra/Hlms/PbsListener/OgreHlmsPbsTerraShadows.h"
 #ifdef _MSC_VER
@@ -92,6 +102,10 @@ class gz::rendering::Ogre2ScenePrivate
   /// is incorrect
   public: bool frameUpdateStarted = false;
 
+  /// \brief True once no texture was found to be loading during the
+  /// current frame, so later renders of the frame don't check again
+  public: bool texturesReady = false;
+
   /// \brief Total time elapsed in simulation since last rendering frame
   public: std::chrono::steady_clock::duration lastRenderSimTime{0};
 
@@ -102,8 +116,63 @@ class gz::rendering::Ogre2ScenePrivate
   /// \brief Flag to indicate if we should flush GPU very often (per camera)
   public: uint8_t cameraPassCountPerGpuFlush = 6u;
 
-  /// \brief Name of shadow compositor node
+  /// \brief Prefix of the names of shadow compositor node definitions
   public: const std::string kShadowNodeName = "PbsMaterialsShadowNode";
+
+  /// \brief Name of the shadow node definition cameras render with. One
+  /// definition is created per light configuration and kept, so a scene
+  /// switching back to a configuration reuses it.
+  public: std::string shadowNodeName;
+
+  /// \brief True if ogre objects of destroyed visuals and geometries
+  /// should be recycled
+  public: bool objectPoolingEnabled = false;
+
+  /// \brief True if LODs should be generated for loaded meshes
+  public: bool meshLodEnabled = false;
+
+  /// \brief True if normals and tangents of loaded meshes are quantized
+  public: bool meshQuantizationEnabled = false;
+
+  /// \brief Merges static visuals into batches, created on first use
+  public: std::unique_ptr<Ogre2StaticBatcher> staticBatcher;
+
+  /// \brief Detached ogre scene nodes available for reuse
+  public: std::vector<Ogre::SceneNode *> freeSceneNodes;
+
+  /// \brief Detached ogre items available for reuse, keyed by mesh name
+  public: std::unordered_map<std::string, std::vector<Ogre::Item *>>
+      freeItems;
+
+  /// \brief Maximum number of scene nodes, and of items per mesh, kept in
+  /// the object pool. Objects released beyond this limit are destroyed.
+  public: const size_t kMaxPooledObjects = 1024u;
+
+  /// \brief Incremented by PreRender, used to know whether heightmaps were
+  /// already updated for a camera during the current frame
+  public: uint64_t frame = 0u;
+
+  /// \brief Camera pose heightmaps were last updated for
+  public: struct HeightmapUpdate
+  {
+    /// \brief Frame of the update, invalid if different from frame
+    uint64_t frame = std::numeric_limits<uint64_t>::max();
+
+    /// \brief Camera of the update
+    const Ogre::Camera *camera = nullptr;
+
+    /// \brief Camera position
+    Ogre::Vector3 position = Ogre::Vector3::ZERO;
+
+    /// \brief Camera orientation
+    Ogre::Quaternion orientation = Ogre::Quaternion::IDENTITY;
+
+    /// \brief True if the update covered all directions
+    bool allDirections = false;
+  };
+
+  /// \brief Last heightmap update
+  public: HeightmapUpdate lastHeightmapUpdate;
 };
 
 using namespace gz;
@@ -188,8 +257,12 @@ void Ogre2Scene::PreRender()
              "Scene::PreRender called again before calling Scene::PostRender. "
              "See Scene::SetCameraPassCountPerGpuFlush for details");
   this->dataPtr->frameUpdateStarted = true;
+  this->dataPtr->texturesReady = false;
+  ++this->dataPtr->frame;
 
-  if (this->ShadowsDirty())
+  // cameras only need to switch shadow node if the light configuration
+  // actually changed
+  if (this->ShadowsDirty() && this->UpdateShadowNode())
   {
     // notify all render targets
     for (unsigned int i  = 0; i < this->SensorCount(); ++i)
@@ -201,12 +274,14 @@ void Ogre2Scene::PreRender()
          camera->SetShadowsDirty();
       }
     }
-
-    this->UpdateShadowNode();
   }
 
   BaseScene::PreRender();
 
+  // register the resource paths of the meshes and textures created since
+  // the last frame
+  Ogre2RenderEngine::Instance()->LoadResourcePaths();
+
   if (!this->LegacyAutoGpuFlush())
   {
     auto engine = Ogre2RenderEngine::Instance();
@@ -289,7 +364,8 @@ void Ogre2Scene::EndForcedRender()
 }
 
 //////////////////////////////////////////////////
-void Ogre2Scene::StartRendering(Ogre::Camera *_camera)
+void Ogre2Scene::StartRendering(Ogre::Camera *_camera,
+                                bool _allowPlaceholderTextures)
 {
   if (_camera)
     this->UpdateAllHeightmaps(_camera);
@@ -326,10 +402,21 @@ void Ogre2Scene::StartRendering(Ogre::Camera *_camera)
   // results
   //
   // We don't want placeholder textures to be used; thus wait until all
-  // textures being loaded are done.
-  Ogre::RenderSystem *renderSys =
-    this->ogreSceneManager->getDestinationRenderSystem();
-  renderSys->getTextureGpuManager()->waitForStreamingCompletion();
+  // textures being loaded are done. Textures are requested while the
+  // scene is updated in PreRender, so this is checked once per frame and
+  // only blocks if something is actually streaming. Cameras which are
+  // fine with placeholders (e.g. GUI cameras) skip the check.
+  if (!this->dataPtr->texturesReady && !_allowPlaceholderTextures)
+  {
+    Ogre::RenderSystem *renderSys =
+      this->ogreSceneManager->getDestinationRenderSystem();
+    Ogre::TextureGpuManager *textureMgr = renderSys->getTextureGpuManager();
+    if (!textureMgr->isDoneStreaming())
+      textureMgr->waitForStreamingCompletion();
+    this->dataPtr->texturesReady = true;
+  }
+#else
+  (void)_allowPlaceholderTextures;
 #endif
 }
 
@@ -403,6 +490,8 @@ void Ogre2Scene::EndFrame()
   }
 
   ogreRoot->_fireFrameEnded(evt);
+
+  this->dataPtr->texturesReady = false;
 }
 
 //////////////////////////////////////////////////
@@ -423,18 +512,236 @@ bool Ogre2Scene::LegacyAutoGpuFlush() const
   return this->dataPtr->cameraPassCountPerGpuFlush == 0u;
 }
 
+//////////////////////////////////////////////////
+void Ogre2Scene::SetObjectPoolingEnabled(bool _enabled)
+{
+  this->dataPtr->objectPoolingEnabled = _enabled;
+  if (!_enabled)
+    this->ClearObjectPools();
+}
+
+//////////////////////////////////////////////////
+bool Ogre2Scene::ObjectPoolingEnabled() const
+{
+  return this->dataPtr->objectPoolingEnabled;
+}
+
+//////////////////////////////////////////////////
+void Ogre2Scene::SetMeshLodEnabled(bool _enabled)
+{
+  this->dataPtr->meshLodEnabled = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2Scene::MeshLodEnabled() const
+{
+  return this->dataPtr->meshLodEnabled;
+}
+
+//////////////////////////////////////////////////
+void Ogre2Scene::SetMeshQuantizationEnabled(bool _enabled)
+{
+  this->dataPtr->meshQuantizationEnabled = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2Scene::MeshQuantizationEnabled() const
+{
+  return this->dataPtr->meshQuantizationEnabled;
+}
+
+//////////////////////////////////////////////////
+unsigned int Ogre2Scene::BuildStaticBatches(double _cellSize)
+{
+  if (!this->dataPtr->staticBatcher)
+  {
+    this->dataPtr->staticBatcher =
+        std::make_unique<Ogre2StaticBatcher>(this);
+  }
+  return this->dataPtr->staticBatcher->Build(_cellSize);
+}
+
+//////////////////////////////////////////////////
+void Ogre2Scene::ClearStaticBatches()
+{
+  if (this->dataPtr->staticBatcher)
+    this->dataPtr->staticBatcher->Clear();
+}
+
+//////////////////////////////////////////////////
+unsigned int Ogre2Scene::StaticBatchCount() const
+{
+  if (!this->dataPtr->staticBatcher)
+    return 0u;
+  return static_cast<unsigned int>(
+      this->dataPtr->staticBatcher->BatchCount());
+}
+
+//////////////////////////////////////////////////
+unsigned int Ogre2Scene::WarmUp(const WarmUpOptions &_options)
+{
+  const unsigned int count = BaseScene::WarmUp(_options);
+
+  // the HLMS cache otherwise is only saved when the engine is destroyed
+  if (count > 0u && _options.saveShaderCache)
+    Ogre2RenderEngine::Instance()->SaveHlmsCache();
+
+  return count;
+}
+
+//////////////////////////////////////////////////
+void Ogre2Scene::SetStaticBatchesActive(bool _active)
+{
+  if (this->dataPtr->staticBatcher)
+    this->dataPtr->staticBatcher->SetActive(_active);
+}
+
+//////////////////////////////////////////////////
+void Ogre2Scene::RemoveFromStaticBatches(unsigned int _visualId)
+{
+  if (this->dataPtr->staticBatcher)
+    this->dataPtr->staticBatcher->RemoveVisual(_visualId);
+}
+
+//////////////////////////////////////////////////
+Ogre::SceneNode *Ogre2Scene::AcquireOgreSceneNode()
+{
+  if (!this->dataPtr->freeSceneNodes.empty())
+  {
+    Ogre::SceneNode *node = this->dataPtr->freeSceneNodes.back();
+    this->dataPtr->freeSceneNodes.pop_back();
+    return node;
+  }
+
+  return this->ogreSceneManager->createSceneNode();
+}
+
+//////////////////////////////////////////////////
+void Ogre2Scene::ReleaseOgreSceneNode(Ogre::SceneNode *_node)
+{
+  if (nullptr == _node || nullptr == this->ogreSceneManager)
+    return;
+
+  if (!this->dataPtr->objectPoolingEnabled ||
+      this->dataPtr->freeSceneNodes.size() >= this->dataPtr->kMaxPooledObjects)
+  {
+    this->ogreSceneManager->destroySceneNode(_node);
+    return;
+  }
+
+  // reset node to the state of a newly created one
+  Ogre::SceneNode *parentNode = _node->getParentSceneNode();
+  if (parentNode)
+    parentNode->removeChild(_node);
+  _node->detachAllObjects();
+  _node->removeAllChildren();
+  _node->setPosition(Ogre::Vector3::ZERO);
+  _node->setOrientation(Ogre::Quaternion::IDENTITY);
+  _node->setScale(Ogre::Vector3::UNIT_SCALE);
+  _node->setInheritScale(true);
+  _node->setVisible(true);
+
+  this->dataPtr->freeSceneNodes.push_back(_node);
+}
+
+//////////////////////////////////////////////////
+Ogre::Item *Ogre2Scene::AcquireOgreItem(const std::string &_meshName)
+{
+  auto it = this->dataPtr->freeItems.find(_meshName);
+  if (it == this->dataPtr->freeItems.end() || it->second.empty())
+    return nullptr;
+
+  Ogre::Item *item = it->second.back();
+  it->second.pop_back();
+  return item;
+}
+
+//////////////////////////////////////////////////
+void Ogre2Scene::ReleaseOgreItem(Ogre::Item *_item)
+{
+  if (nullptr == _item || nullptr == this->ogreSceneManager)
+    return;
+
+  // show the other items batched with this one before it goes away
+  if (this->dataPtr->staticBatcher)
+    this->dataPtr->staticBatcher->RemoveItem(_item);
+
+  // skeleton instances carry per-item animation state so do not recycle
+  // items with skeletons
+  std::vector<Ogre::Item *> *pool = nullptr;
+  if (this->dataPtr->objectPoolingEnabled && !_item->hasSkeleton())
+  {
+    pool = &this->dataPtr->freeItems[_item->getMesh()->getName()];
+    if (pool->size() >= this->dataPtr->kMaxPooledObjects)
+      pool = nullptr;
+  }
+
+  if (!pool)
+  {
+    this->ogreSceneManager->destroyItem(_item);
+    return;
+  }
+
+  // reset item to the state of a newly created one. Restoring the original
+  // datablocks also unlinks the item from the materials of its previous
+  // owner so they can be safely destroyed.
+  if (_item->isAttached())
+    _item->detachFromParent();
+  for (size_t i = 0; i < _item->getNumSubItems(); ++i)
+  {
+    Ogre::SubItem *subItem = _item->getSubItem(i);
+    subItem->setDatablockOrMaterialName(
+        subItem->getSubMesh()->getMaterialName(),
+        Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+  }
+  _item->getUserObjectBindings().setUserAny(Ogre::Any());
+  _item->setVisibilityFlags(Ogre::MovableObject::getDefaultVisibilityFlags());
+  _item->setVisible(true);
+  _item->setCastShadows(true);
+  // by default, ogre items are in render queue 10
+  _item->setRenderQueueGroup(10);
+
+  pool->push_back(_item);
+}
+
+//////////////////////////////////////////////////
+void Ogre2Scene::ClearObjectPools()
+{
+  if (nullptr != this->ogreSceneManager)
+  {
+    for (auto &[meshName, items] : this->dataPtr->freeItems)
+    {
+      for (auto item : items)
+        this->ogreSceneManager->destroyItem(item);
+    }
+    for (auto node : this->dataPtr->freeSceneNodes)
+      this->ogreSceneManager->destroySceneNode(node);
+  }
+  this->dataPtr->freeItems.clear();
+  this->dataPtr->freeSceneNodes.clear();
+}
+
 //////////////////////////////////////////////////
 void Ogre2Scene::Clear()
 {
+  // batches reference the meshes and materials about to be destroyed
+  this->ClearStaticBatches();
+
   this->meshFactory->Clear();
 
   BaseScene::Clear();
+
+  // pooled items hold references to meshes that were just removed
+  this->ClearObjectPools();
 }
 
 //////////////////////////////////////////////////
 void Ogre2Scene::Destroy()
 {
+  this->dataPtr->staticBatcher.reset();
+
   this->DestroyNodes();
+  this->ClearObjectPools();
 
   // cleanup any items that were not attached to nodes
   // make sure to do this before destroying materials done by BaseScene::Destroy
@@ -475,8 +782,32 @@ bool Ogre2Scene::InitImpl()
 }
 
 //////////////////////////////////////////////////
-void Ogre2Scene::UpdateAllHeightmaps(Ogre::Camera *_camera)
+void Ogre2Scene::UpdateAllHeightmaps(Ogre::Camera *_camera,
+    bool _allDirections)
 {
+  if (this->heightmaps.empty())
+    return;
+
+  // Terra keeps the cells selected for the last camera, so they can be
+  // reused while the same camera, or any camera at the same position for
+  // all-directions updates, renders again during the same frame
+  auto &last = this->dataPtr->lastHeightmapUpdate;
+  const Ogre::Vector3 cameraPos = _camera->getDerivedPosition();
+  const Ogre::Quaternion cameraRot = _camera->getDerivedOrientation();
+  if (last.frame == this->dataPtr->frame &&
+      last.allDirections == _allDirections &&
+      last.position == cameraPos &&
+      (_allDirections ||
+       (last.camera == _camera && last.orientation == cameraRot)))
+  {
+    return;
+  }
+  last.frame = this->dataPtr->frame;
+  last.camera = _camera;
+  last.position = cameraPos;
+  last.orientation = cameraRot;
+  last.allDirections = _allDirections;
+
   auto engine = Ogre2RenderEngine::Instance();
   Ogre::HlmsPbsTerraShadows *pbsTerraShadows = engine->HlmsPbsTerraShadows();
 
@@ -484,7 +815,7 @@ void Ogre2Scene::UpdateAllHeightmaps(Ogre::Camera *_camera)
   Ogre::Terra *closestTerra = 0;
   Ogre::Terra *insideTerra = 0;
 
-  const Ogre::Vector2 cameraPos2d(_camera->getDerivedPosition().xy());
+  const Ogre::Vector2 cameraPos2d(cameraPos.xy());
 
   auto itor = this->heightmaps.begin();
   auto endt = this->heightmaps.end();
@@ -501,8 +832,14 @@ void Ogre2Scene::UpdateAllHeightmaps(Ogre::Camera *_camera)
     }
     else
     {
-      heightmap->UpdateForRender(_camera);
+      heightmap->UpdateForRender(_camera, _allDirections);
       Ogre::Terra *terra = heightmap->Terra();
+      if (!terra)
+      {
+        // Tiled heightmap with no tile in range of the camera
+        ++itor;
+        continue;
+      }
 
       const Ogre::Vector2 origin2d = terra->getTerrainOrigin().xy() +
                                      terra->getXZDimensions() * 0.5f;
@@ -565,20 +902,25 @@ void Ogre2Scene::UpdateAllHeightmaps(Ogre::Camera *_camera)
 }
 
 //////////////////////////////////////////////////
-void Ogre2Scene::UpdateShadowNode()
+bool Ogre2Scene::UpdateShadowNode()
 {
   if (!this->ShadowsDirty())
-    return;
+    return false;
 
+  this->SetShadowsDirty(false);
+
+  // count through the ogre lights, indexing the light store is linear
   unsigned int spotPointLightCount = 0;
   unsigned int dirLightCount = 0;
 
-  for (unsigned int i = 0; i < this->LightCount(); ++i)
+  auto itor = this->ogreSceneManager->getMovableObjectIterator(
+      Ogre::LightFactory::FACTORY_TYPE_NAME);
+  while (itor.hasMoreElements())
   {
-    LightPtr light = this->LightByIndex(i);
-    if (light->CastShadows())
+    Ogre::Light *light = static_cast<Ogre::Light *>(itor.getNext());
+    if (light->getCastShadows())
     {
-      if (std::dynamic_pointer_cast<DirectionalLight>(light))
+      if (light->getType() == Ogre::Light::LT_DIRECTIONAL)
         dirLightCount++;
       else
         spotPointLightCount++;
@@ -591,22 +933,44 @@ void Ogre2Scene::UpdateShadowNode()
   // suggest that the number of uniform variables has exceeded the max number
   // allowed
   unsigned int maxShadowMaps = 25u;
+  bool limited = false;
   if (dirLightCount * 3 + spotPointLightCount > maxShadowMaps)
   {
     dirLightCount = std::min(static_cast<unsigned int>(maxShadowMaps / 3),
         dirLightCount);
     spotPointLightCount = std::min(
         std::max(maxShadowMaps - dirLightCount * 3, 0u), spotPointLightCount);
+    limited = true;
+  }
+
+  // The shadow node only depends on the number of shadow maps of each type,
+  // so lights toggled without changing it keep the current definition and
+  // the cameras keep their workspaces
+  const std::string shadowNodeDefName = this->dataPtr->kShadowNodeName +
+      "_" + std::to_string(dirLightCount) +
+      "_" + std::to_string(spotPointLightCount);
+  if (shadowNodeDefName == this->dataPtr->shadowNodeName)
+    return false;
+
+  if (limited)
+  {
     gzwarn << "Number of shadow-casting lights exceeds the limit supported by "
             << "the underlying rendering engine ogre2. Limiting to "
             << dirLightCount << " directional lights and "
             << spotPointLightCount << " point / spot lights" << std::endl;
   }
 
+  this->dataPtr->shadowNodeName = shadowNodeDefName;
+
   auto engine = Ogre2RenderEngine::Instance();
   Ogre::CompositorManager2 *compositorManager =
       engine->OgreRoot()->getCompositorManager2();
 
+  // definitions are never removed, workspaces of this or other scenes may
+  // still reference them
+  if (compositorManager->hasShadowNodeDefinition(shadowNodeDefName))
+    return true;
+
   Ogre::ShadowNodeHelper::ShadowParamVec shadowParams;
   Ogre::ShadowNodeHelper::ShadowParam shadowParam;
 
@@ -674,14 +1038,9 @@ void Ogre2Scene::UpdateShadowNode()
     }
   }
 
-  std::string shadowNodeDefName = this->dataPtr->kShadowNodeName;
-  if (compositorManager->hasShadowNodeDefinition(shadowNodeDefName))
-    compositorManager->removeShadowNodeDefinition(shadowNodeDefName);
-
   this->CreateShadowNodeWithSettings(compositorManager, shadowNodeDefName,
       shadowParams);
-
-  this->SetShadowsDirty(false);
+  return true;
 }
 
 ////////////////////////////////////////////////////
@@ -1220,6 +1579,8 @@ HeightmapPtr Ogre2Scene::CreateHeightmapImpl(unsigned int _id,
 {
   Ogre2HeightmapPtr heightmap(new Ogre2Heightmap(_desc));
   heightmaps.push_back(heightmap);
+  this->dataPtr->lastHeightmapUpdate.frame =
+      std::numeric_limits<uint64_t>::max();
   bool result = this->InitObject(heightmap, _id, _name);
   return (result) ? heightmap : nullptr;
 }
@@ -1269,6 +1630,17 @@ FrustumVisualPtr Ogre2Scene::CreateFrustumVisualImpl(unsigned int _id,
   return (result) ? frustum: nullptr;
 }
 
+//////////////////////////////////////////////////
+InstancedVisualPtr Ogre2Scene::CreateInstancedVisualImpl(unsigned int _id,
+    const std::string &_name, const MeshDescriptor &_desc,
+    MaterialPtr _material, unsigned int _capacity)
+{
+  Ogre2InstancedVisualPtr visual(
+      new Ogre2InstancedVisual(_desc, _material, _capacity));
+  bool result = this->InitObject(visual, _id, _name);
+  return (result) ? visual : nullptr;
+}
+
 //////////////////////////////////////////////////
 TextPtr Ogre2Scene::CreateTextImpl(unsigned int /*_id*/,
     const std::string &/*_name*/)
@@ -1442,6 +1814,12 @@ bool Ogre2Scene::ShadowsDirty() const
   return this->dataPtr->shadowsDirty;
 }
 
+//////////////////////////////////////////////////
+const std::string &Ogre2Scene::ShadowNodeName() const
+{
+  return this->dataPtr->shadowNodeName;
+}
+
 //////////////////////////////////////////////////
 void Ogre2Scene::SetSkyEnabled(bool _enabled)
 {
@@ -311,6 +311,8 @@ gz::common::ConnectionPtr
 /////////////////////////////////////////////////
 void Ogre2SegmentationCamera::Render()
 {
+  this->UpdateLodBias(this->ogreCamera, this->ImageHeight());
+
   // update the compositors
   this->scene->StartRendering(this->ogreCamera);
 
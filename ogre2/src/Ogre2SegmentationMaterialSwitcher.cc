@@ -24,6 +24,7 @@
 #include <gz/common/Console.hh>
 
 #include "gz/rendering/ogre2/Ogre2Heightmap.hh"
+#include "gz/rendering/ogre2/Ogre2InstancedVisual.hh"
 #include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
 #include "gz/rendering/ogre2/Ogre2Scene.hh"
 #include "gz/rendering/ogre2/Ogre2Visual.hh"
@@ -52,6 +53,11 @@ Ogre2SegmentationMaterialSwitcher::Ogre2SegmentationMaterialSwitcher(
 {
   this->scene = _scene;
   this->segmentationCamera = _camera;
+  if (this->scene)
+  {
+    this->labelHandle =
+        this->scene->InternAttribute("label", NodeAttributeType::INT);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -81,16 +87,12 @@ bool Ogre2SegmentationMaterialSwitcher::IsTakenColor(const math::Color &_color)
 
 /////////////////////////////////////////////////
 Ogre::Vector4 Ogre2SegmentationMaterialSwitcher::ColorForVisual(
-  const VisualPtr &_visual, std::string &_prevParentName)
+  const VisualPtr &_visual, std::string &_prevParentName,
+  const Ogre::Item *_item)
 {
   // get class user data
-  Variant labelAny = _visual->UserData("label");
   int label;
-  try
-  {
-    label = std::get<int>(labelAny);
-  }
-  catch (std::bad_variant_access &)
+  if (!this->scene->IntAttribute(this->labelHandle, _visual->Id(), label))
   {
     // items with no class are considered background
     label = this->segmentationCamera->BackgroundLabel();
@@ -120,6 +122,11 @@ Ogre::Vector4 Ogre2SegmentationMaterialSwitcher::ColorForVisual(
     auto itemName = _visual->Name();
     std::string parentName = this->TopLevelModelVisual(_visual)->Name();
 
+    // each instance of an instanced visual is a separate object
+    unsigned int instanceIndex = 0u;
+    if (_item && Ogre2InstancedVisual::InstanceIndex(_item, instanceIndex))
+      parentName += "::" + std::to_string(instanceIndex);
+
     auto it = this->instancesCount.find(label);
     if (it == this->instancesCount.end())
       it = this->instancesCount.insert(std::make_pair(label, 0)).first;
@@ -230,6 +237,9 @@ VisualPtr Ogre2SegmentationMaterialSwitcher::TopLevelModelVisual(
 void Ogre2SegmentationMaterialSwitcher::cameraPreRenderScene(
     Ogre::Camera * /*_cam*/)
 {
+  // batches merge visuals, so render each visual on its own
+  this->scene->SetStaticBatchesActive(false);
+
   this->colorToLabel.clear();
   auto itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
       Ogre::ItemFactory::FACTORY_TYPE_NAME);
@@ -293,7 +303,7 @@ void Ogre2SegmentationMaterialSwitcher::cameraPreRenderScene(
       }
 
       const Ogre::Vector4 customParameter =
-        ColorForVisual(visual, prevParentName);
+        ColorForVisual(visual, prevParentName, item);
 
       const size_t numSubItems = item->getNumSubItems();
       for (size_t i = 0; i < numSubItems; ++i)
@@ -376,7 +386,7 @@ void Ogre2SegmentationMaterialSwitcher::cameraPreRenderScene(
       VisualPtr visual = heightmap->Parent();
       const Ogre::Vector4 customParameter =
         ColorForVisual(visual, prevParentName);
-      heightmap->Terra()->SetSolidColor(1u, customParameter);
+      heightmap->SetSolidColor(1u, customParameter);
     }
   }
 
@@ -441,9 +451,11 @@ void Ogre2SegmentationMaterialSwitcher::cameraPostRenderScene(
   {
     auto heightmap = h.lock();
     if (heightmap)
-      heightmap->Terra()->UnsetSolidColors();
+      heightmap->UnsetSolidColors();
   }
 
+  this->scene->SetStaticBatchesActive(true);
+
   engine->SetGzOgreRenderingMode(GORM_NORMAL);
 }
 
@@ -73,9 +73,12 @@ class GZ_RENDERING_OGRE2_VISIBLE Ogre2SegmentationMaterialSwitcher :
   /// \param[in] _visual Visual will be applying the color to
   /// \param[in,out] _prevParentName A persistent string between call
   /// to ensure multilink visuals receive the same color
+  /// \param[in] _item Ogre item being colored, if any. Instances of an
+  /// instanced visual are told apart by their item.
   /// \return The color to apply to the visual
   private: Ogre::Vector4 ColorForVisual(const VisualPtr &_visual,
-                                        std::string &_prevParentName);
+                                        std::string &_prevParentName,
+                                        const Ogre::Item *_item = nullptr);
 
   /// \brief Convert label of semantic map to a unique color for colored map and
   /// add the color of the label to the taken colors if it doesn't exist
@@ -135,6 +138,9 @@ class GZ_RENDERING_OGRE2_VISIBLE Ogre2SegmentationMaterialSwitcher :
   /// \brief Ogre2 Scene
   private: Ogre2ScenePtr scene = nullptr;
 
+  /// \brief Handle of the interned "label" attribute
+  private: unsigned int labelHandle = 0u;
+
   /// \brief Pointer to segmentation camera that gives the material switcher
   /// access to things like the segmentation type, background color, background
   /// label, and if colored map is enabled
@@ -14,6 +14,16 @@
  * limitations under the License.
  *
  */
+#include <cmath>
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreCamera.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
 #include "gz/rendering/ogre2/Ogre2Sensor.hh"
 
 using namespace gz;
@@ -28,3 +38,23 @@ Ogre2Sensor::Ogre2Sensor()
 Ogre2Sensor::~Ogre2Sensor()
 {
 }
+
+//////////////////////////////////////////////////
+void Ogre2Sensor::UpdateLodBias(Ogre::Camera *_camera,
+    unsigned int _imageHeight) const
+{
+  if (!_camera || _imageHeight == 0u)
+    return;
+
+  // focal length in pixels
+  const double tanHalfFov =
+      std::tan(_camera->getFOVy().valueRadians() * 0.5);
+  if (!(tanHalfFov > 0.0))
+    return;
+  const double focal = _imageHeight / (2.0 * tanHalfFov);
+
+  // the distance LOD strategy compares squared distances divided by the
+  // bias against the squared LOD distances
+  const double scale = focal * this->lodBias;
+  _camera->setLodBias(static_cast<Ogre::Real>(scale * scale));
+}
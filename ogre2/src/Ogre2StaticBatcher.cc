@@ -0,0 +1,633 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <set>
+#include <tuple>
+#include <utility>
+
+#include <gz/common/Console.hh>
+
+#include "gz/rendering/Visual.hh"
+#include "gz/rendering/ogre2/Ogre2Scene.hh"
+
+#include "Ogre2QTangent.hh"
+#include "Ogre2StaticBatcher.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreHlmsDatablock.h>
+#include <OgreItem.h>
+#include <OgreMatrix3.h>
+#include <OgreMatrix4.h>
+#include <OgreMesh2.h>
+#include <OgreMeshManager2.h>
+#include <OgreRenderSystem.h>
+#include <OgreSceneManager.h>
+#include <OgreSubItem.h>
+#include <OgreSubMesh2.h>
+#include <Vao/OgreAsyncTicket.h>
+#include <Vao/OgreIndexBufferPacked.h>
+#include <Vao/OgreVertexBufferPacked.h>
+#include <Vao/OgreVaoManager.h>
+#include <Vao/OgreVertexArrayObject.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+/// \brief Properties that must be equal for submeshes to be merged. A
+/// missing attribute is stored as NaN, which compares as a distinct value
+/// through its bit pattern.
+using BatchKey = std::tuple<
+    Ogre::HlmsDatablock *,              // datablock
+    std::vector<std::pair<int, int>>,   // vertex element types, semantics
+    uint32_t,                           // visibility flags
+    bool,                               // cast shadows
+    uint8_t,                            // render queue group
+    std::array<int64_t, 3>,             // grid cell
+    uint32_t,                           // temperature bits
+    uint32_t>;                          // laser retro bits
+
+/// \brief Submesh of an original item to merge
+struct BatchPart
+{
+  /// \brief Original item
+  Ogre::Item *item;
+
+  /// \brief Index of the submesh
+  size_t subItem;
+
+  /// \brief Id of the visual of the item
+  unsigned int visualId;
+
+  /// \brief World transform of the item
+  Ogre::Matrix4 transform;
+};
+
+/// \brief Offsets of the vertex attributes that are transformed to world
+/// space, or -1 if the vertex has no such attribute
+struct VertexLayout
+{
+  /// \brief Offset of the float3 position
+  int position = -1;
+
+  /// \brief Offset of the float3 normal
+  int normal = -1;
+
+  /// \brief Offset of the float4 tangent
+  int tangent = -1;
+
+  /// \brief Offset of the short4 snorm QTangent
+  int qTangent = -1;
+
+  /// \brief Size of a vertex in bytes
+  size_t size = 0u;
+};
+
+/// \brief Find the attributes of a vertex layout that are transformed
+/// \param[in] _elements Vertex elements
+/// \param[out] _layout Attribute offsets
+/// \return False if the layout has attributes that cannot be transformed,
+/// e.g. half float positions or bone weights
+bool ParseLayout(const Ogre::VertexElement2Vec &_elements,
+    VertexLayout &_layout)
+{
+  size_t offset = 0u;
+  for (const auto &element : _elements)
+  {
+    const int at = static_cast<int>(offset);
+    switch (element.mSemantic)
+    {
+      case Ogre::VES_POSITION:
+        if (element.mType != Ogre::VET_FLOAT3)
+          return false;
+        _layout.position = at;
+        break;
+      case Ogre::VES_NORMAL:
+        if (element.mType == Ogre::VET_FLOAT3)
+          _layout.normal = at;
+        else if (element.mType == Ogre::VET_SHORT4_SNORM)
+          _layout.qTangent = at;
+        else
+          return false;
+        break;
+      case Ogre::VES_TANGENT:
+        if (element.mType != Ogre::VET_FLOAT4)
+          return false;
+        _layout.tangent = at;
+        break;
+      case Ogre::VES_TEXTURE_COORDINATES:
+      case Ogre::VES_DIFFUSE:
+      case Ogre::VES_SPECULAR:
+        break;
+      default:
+        return false;
+    }
+    offset += Ogre::v1::VertexElement::getTypeSize(element.mType);
+  }
+  _layout.size = offset;
+  return _layout.position >= 0;
+}
+
+/// \brief Get the bits of a float so that NaN compares equal to itself
+/// \param[in] _value Value
+/// \return Bits of the value
+uint32_t FloatBits(float _value)
+{
+  uint32_t bits;
+  memcpy(&bits, &_value, sizeof(bits));
+  return bits;
+}
+
+/// \brief Read a float3 from unaligned vertex data
+/// \param[in] _src Source
+/// \return Value
+Ogre::Vector3 ReadVector3(const uint8_t *_src)
+{
+  float v[3];
+  memcpy(v, _src, sizeof(v));
+  return Ogre::Vector3(v[0], v[1], v[2]);
+}
+
+/// \brief Write a float3 to unaligned vertex data
+/// \param[in] _dst Destination
+/// \param[in] _value Value
+void WriteVector3(uint8_t *_dst, const Ogre::Vector3 &_value)
+{
+  const float v[3] = {_value.x, _value.y, _value.z};
+  memcpy(_dst, v, sizeof(v));
+}
+
+/// \brief Transform the vertices of a submesh to world space in place
+/// \param[in,out] _vertices Vertex data
+/// \param[in] _count Number of vertices
+/// \param[in] _layout Vertex layout
+/// \param[in] _transform World transform
+/// \param[in,out] _bounds Bounds to merge the transformed positions into
+void TransformVertices(uint8_t *_vertices, size_t _count,
+    const VertexLayout &_layout, const Ogre::Matrix4 &_transform,
+    Ogre::Aabb &_bounds)
+{
+  Ogre::Matrix3 linear;
+  _transform.extract3x3Matrix(linear);
+  const Ogre::Matrix3 normalMatrix = linear.Inverse().Transpose();
+  const float handedness = linear.Determinant() < 0.0f ? -1.0f : 1.0f;
+
+  for (size_t i = 0u; i < _count; ++i)
+  {
+    uint8_t *vertex = _vertices + i * _layout.size;
+
+    const Ogre::Vector3 p = _transform * ReadVector3(vertex + _layout.position);
+    WriteVector3(vertex + _layout.position, p);
+    _bounds.merge(p);
+
+    if (_layout.normal >= 0)
+    {
+      const Ogre::Vector3 n =
+          normalMatrix * ReadVector3(vertex + _layout.normal);
+      WriteVector3(vertex + _layout.normal, n.normalisedCopy());
+    }
+
+    if (_layout.tangent >= 0)
+    {
+      float t[4];
+      memcpy(t, vertex + _layout.tangent, sizeof(t));
+      const Ogre::Vector3 d =
+          (linear * Ogre::Vector3(t[0], t[1], t[2])).normalisedCopy();
+      const float result[4] = {d.x, d.y, d.z, t[3] * handedness};
+      memcpy(vertex + _layout.tangent, result, sizeof(result));
+    }
+
+    if (_layout.qTangent >= 0)
+    {
+      std::array<int16_t, 4> q;
+      memcpy(q.data(), vertex + _layout.qTangent, sizeof(q));
+      Ogre::Vector3 n;
+      Ogre::Vector4 t;
+      DecodeQTangent(q, n, t);
+      const Ogre::Vector3 d = linear * Ogre::Vector3(t.x, t.y, t.z);
+      q = EncodeQTangent(normalMatrix * n,
+          Ogre::Vector4(d.x, d.y, d.z, t.w * handedness));
+      memcpy(vertex + _layout.qTangent, q.data(), sizeof(q));
+    }
+  }
+}
+
+/// \brief Check whether a visual is part of the scene graph
+/// \param[in] _visual Visual to check
+/// \param[in] _root Root visual of the scene
+/// \return True if _root is an ancestor of _visual
+bool InSceneGraph(const VisualPtr &_visual, const VisualPtr &_root)
+{
+  for (NodePtr node = _visual->Parent(); node; node = node->Parent())
+  {
+    if (node == _root)
+      return true;
+  }
+  return false;
+}
+}
+
+//////////////////////////////////////////////////
+Ogre2StaticBatcher::Ogre2StaticBatcher(Ogre2Scene *_scene)
+  : scene(_scene)
+{
+}
+
+//////////////////////////////////////////////////
+Ogre2StaticBatcher::~Ogre2StaticBatcher()
+{
+  this->Clear();
+}
+
+//////////////////////////////////////////////////
+unsigned int Ogre2StaticBatcher::Build(double _cellSize)
+{
+  this->Clear();
+
+  Ogre::SceneManager *sceneManager = this->scene->OgreSceneManager();
+  if (!sceneManager)
+    return 0u;
+
+  if (!(_cellSize > 0.0))
+  {
+    gzerr << "Static batch cell size must be positive, got ["
+          << _cellSize << "]" << std::endl;
+    return 0u;
+  }
+
+  const VisualPtr root = this->scene->RootVisual();
+  const unsigned int tempHandle =
+      this->scene->InternAttribute("temperature", NodeAttributeType::FLOAT);
+  const unsigned int retroHandle =
+      this->scene->InternAttribute("laser_retro", NodeAttributeType::FLOAT);
+
+  // group the submeshes of static visuals by everything that must match
+  // for them to be drawn together
+  std::map<BatchKey, std::vector<BatchPart>> groups;
+  auto itor = sceneManager->getMovableObjectIterator(
+      Ogre::ItemFactory::FACTORY_TYPE_NAME);
+  while (itor.hasMoreElements())
+  {
+    Ogre::Item *item = static_cast<Ogre::Item *>(itor.getNext());
+
+    Ogre::Any userAny = item->getUserObjectBindings().getUserAny();
+    if (userAny.isEmpty() || userAny.getType() != typeid(unsigned int) ||
+        !item->isAttached() || !item->getVisible() ||
+        item->getVisibilityFlags() == 0u || item->hasSkeleton() ||
+        item->getNumSubItems() == 0u)
+    {
+      continue;
+    }
+
+    const unsigned int visualId = Ogre::any_cast<unsigned int>(userAny);
+    VisualPtr visual = this->scene->VisualById(visualId);
+    // items of subtrees removed from their parent are still attached to
+    // their ogre scene nodes
+    if (!visual || !visual->Static() || !InSceneGraph(visual, root))
+      continue;
+
+    // heat signatures are textures looked up per visual
+    float temperature = std::numeric_limits<float>::quiet_NaN();
+    if (!this->scene->FloatAttribute(tempHandle, visualId, temperature) &&
+        visual->HasUserData("temperature"))
+    {
+      continue;
+    }
+    float retro = std::numeric_limits<float>::quiet_NaN();
+    this->scene->FloatAttribute(retroHandle, visualId, retro);
+
+    const Ogre::Aabb aabb = item->getWorldAabbUpdated();
+    std::array<int64_t, 3> cell;
+    for (unsigned int k = 0u; k < 3u; ++k)
+    {
+      cell[k] = static_cast<int64_t>(
+          std::floor(aabb.mCenter[k] / _cellSize));
+    }
+
+    // an item is hidden as a whole, so all of its submeshes must be
+    // batched for it to be batched at all
+    std::vector<std::pair<BatchKey, size_t>> keys;
+    for (size_t i = 0u; i < item->getNumSubItems(); ++i)
+    {
+      Ogre::SubItem *subItem = item->getSubItem(i);
+      Ogre::HlmsDatablock *datablock = subItem->getDatablock();
+      const auto &vaos = subItem->getSubMesh()->mVao[Ogre::VpNormal];
+      if (!subItem->getMaterial().isNull() || !datablock ||
+          datablock->getBlendblock()->mIsTransparent || vaos.empty() ||
+          vaos[0]->getVertexBuffers().size() != 1u ||
+          !vaos[0]->getIndexBuffer() ||
+          vaos[0]->getOperationType() != Ogre::OT_TRIANGLE_LIST)
+      {
+        break;
+      }
+
+      const Ogre::VertexElement2Vec &elements =
+          vaos[0]->getVertexBuffers()[0]->getVertexElements();
+      VertexLayout layout;
+      if (!ParseLayout(elements, layout))
+        break;
+
+      std::vector<std::pair<int, int>> format;
+      for (const auto &element : elements)
+        format.emplace_back(element.mType, element.mSemantic);
+
+      keys.emplace_back(BatchKey(datablock, format,
+          item->getVisibilityFlags(), item->getCastShadows(),
+          item->getRenderQueueGroup(), cell, FloatBits(temperature),
+          FloatBits(retro)), i);
+    }
+    if (keys.size() != item->getNumSubItems())
+      continue;
+
+    const Ogre::Matrix4 transform =
+        item->getParentNode()->_getFullTransformUpdated();
+    for (auto &[key, subItem] : keys)
+      groups[key].push_back({item, subItem, visualId, transform});
+  }
+
+  Ogre::VaoManager *vaoManager =
+      sceneManager->getDestinationRenderSystem()->getVaoManager();
+
+  std::set<Ogre::Item *> batchedItems;
+  for (auto &[key, parts] : groups)
+  {
+    // merging a single submesh saves nothing
+    if (parts.size() < 2u)
+      continue;
+
+    VertexLayout layout;
+    const Ogre::VertexElement2Vec &elements = parts[0].item->getSubItem(
+        parts[0].subItem)->getSubMesh()->mVao[Ogre::VpNormal][0]->
+        getVertexBuffers()[0]->getVertexElements();
+    ParseLayout(elements, layout);
+
+    // read back the original buffers, which are immutable on the GPU
+    std::vector<uint8_t> vertices;
+    std::vector<uint32_t> indices;
+    Ogre::Aabb bounds = Ogre::Aabb::BOX_NULL;
+    for (const auto &part : parts)
+    {
+      Ogre::VertexArrayObject *vao = part.item->getSubItem(part.subItem)->
+          getSubMesh()->mVao[Ogre::VpNormal][0];
+      Ogre::VertexBufferPacked *vertexBuffer = vao->getVertexBuffers()[0];
+      Ogre::IndexBufferPacked *indexBuffer = vao->getIndexBuffer();
+
+      const size_t base = vertices.size() / layout.size;
+      const size_t vertexCount = vertexBuffer->getNumElements();
+      vertices.resize(vertices.size() + vertexCount * layout.size);
+      uint8_t *dst = vertices.data() + base * layout.size;
+      Ogre::AsyncTicketPtr ticket = vertexBuffer->readRequest(0u, vertexCount);
+      memcpy(dst, ticket->map(), vertexCount * layout.size);
+      ticket->unmap();
+      TransformVertices(dst, vertexCount, layout, part.transform, bounds);
+
+      const size_t indexStart = vao->getPrimitiveStart();
+      const size_t indexCount = vao->getPrimitiveCount();
+      ticket = indexBuffer->readRequest(indexStart, indexCount);
+      const void *src = ticket->map();
+      for (size_t i = 0u; i < indexCount; ++i)
+      {
+        uint32_t index;
+        if (indexBuffer->getIndexType() == Ogre::IndexBufferPacked::IT_16BIT)
+          index = static_cast<const uint16_t *>(src)[i];
+        else
+          index = static_cast<const uint32_t *>(src)[i];
+        indices.push_back(static_cast<uint32_t>(base + index));
+      }
+      ticket->unmap();
+    }
+
+    const size_t vertexCount = vertices.size() / layout.size;
+    const bool use16 = vertexCount < 0x10000u;
+    std::vector<uint16_t> indices16;
+    if (use16)
+      indices16.assign(indices.begin(), indices.end());
+
+    Batch batch;
+    batch.meshName = this->scene->Name() + "::StaticBatch::" +
+        std::to_string(this->meshCounter++);
+    try
+    {
+      Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().createManual(
+          batch.meshName,
+          Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+      Ogre::VertexBufferPackedVec vertexBuffers;
+      vertexBuffers.push_back(vaoManager->createVertexBuffer(elements,
+          vertexCount, Ogre::BT_IMMUTABLE, vertices.data(), false));
+      Ogre::IndexBufferPacked *indexBuffer = vaoManager->createIndexBuffer(
+          use16 ? Ogre::IndexBufferPacked::IT_16BIT :
+                  Ogre::IndexBufferPacked::IT_32BIT,
+          indices.size(), Ogre::BT_IMMUTABLE,
+          use16 ? static_cast<void *>(indices16.data()) :
+                  static_cast<void *>(indices.data()), false);
+      Ogre::VertexArrayObject *vao = vaoManager->createVertexArrayObject(
+          vertexBuffers, indexBuffer, Ogre::OT_TRIANGLE_LIST);
+
+      Ogre::SubMesh *subMesh = mesh->createSubMesh();
+      subMesh->mVao[Ogre::VpNormal].push_back(vao);
+      subMesh->mVao[Ogre::VpShadow].push_back(vao);
+      mesh->_setBounds(bounds, false);
+      mesh->_setBoundingSphereRadius(bounds.getRadius());
+
+      batch.item = sceneManager->createItem(mesh, Ogre::SCENE_DYNAMIC);
+    }
+    catch(Ogre::Exception &e)
+    {
+      gzerr << "Unable to create static batch [" << e.getDescription()
+            << "]" << std::endl;
+      if (Ogre::MeshManager::getSingleton().resourceExists(batch.meshName))
+        Ogre::MeshManager::getSingleton().remove(batch.meshName);
+      continue;
+    }
+
+    // the batch stands for the first visual, which has the same
+    // attributes as all the others
+    batch.visibilityFlags = std::get<2>(key);
+    batch.item->getSubItem(0)->setDatablock(std::get<0>(key));
+    batch.item->setVisibilityFlags(batch.visibilityFlags);
+    batch.item->setCastShadows(std::get<3>(key));
+    batch.item->setRenderQueueGroup(std::get<4>(key));
+    batch.item->getUserObjectBindings().setUserAny(
+        Ogre::Any(parts[0].visualId));
+    batch.node = sceneManager->getRootSceneNode()->createChildSceneNode();
+    batch.node->attachObject(batch.item);
+
+    for (const auto &part : parts)
+    {
+      if (std::find(batch.members.begin(), batch.members.end(), part.item) ==
+          batch.members.end())
+      {
+        batch.members.push_back(part.item);
+        batch.visualIds.push_back(part.visualId);
+      }
+      batchedItems.insert(part.item);
+    }
+    this->batches.push_back(std::move(batch));
+  }
+
+  // hide the original items now that their submeshes are drawn by batches
+  for (Ogre::Item *item : batchedItems)
+  {
+    this->memberFlags[item] = item->getVisibilityFlags();
+    item->setVisibilityFlags(0u);
+  }
+  this->active = true;
+
+  return static_cast<unsigned int>(this->batches.size());
+}
+
+//////////////////////////////////////////////////
+void Ogre2StaticBatcher::Clear()
+{
+  std::vector<size_t> all(this->batches.size());
+  for (size_t i = 0u; i < all.size(); ++i)
+    all[i] = i;
+  this->RemoveBatches(all);
+}
+
+//////////////////////////////////////////////////
+void Ogre2StaticBatcher::RemoveVisual(unsigned int _visualId)
+{
+  std::vector<size_t> remove;
+  for (size_t i = 0u; i < this->batches.size(); ++i)
+  {
+    const auto &ids = this->batches[i].visualIds;
+    if (std::find(ids.begin(), ids.end(), _visualId) != ids.end())
+      remove.push_back(i);
+  }
+  this->RemoveBatches(remove);
+}
+
+//////////////////////////////////////////////////
+void Ogre2StaticBatcher::RemoveItem(Ogre::Item *_item)
+{
+  if (this->memberFlags.find(_item) == this->memberFlags.end())
+    return;
+
+  std::vector<size_t> remove;
+  for (size_t i = 0u; i < this->batches.size(); ++i)
+  {
+    const auto &members = this->batches[i].members;
+    if (std::find(members.begin(), members.end(), _item) != members.end())
+      remove.push_back(i);
+  }
+  this->RemoveBatches(remove);
+}
+
+//////////////////////////////////////////////////
+void Ogre2StaticBatcher::RemoveBatches(std::vector<size_t> _remove)
+{
+  if (_remove.empty())
+    return;
+
+  // an original item that is shown again must not also be drawn by
+  // another batch, so batches sharing its items are removed too
+  std::vector<bool> removed(this->batches.size(), false);
+  std::set<Ogre::Item *> restored;
+  while (!_remove.empty())
+  {
+    const size_t index = _remove.back();
+    _remove.pop_back();
+    if (removed[index])
+      continue;
+    removed[index] = true;
+
+    for (Ogre::Item *item : this->batches[index].members)
+    {
+      if (!restored.insert(item).second)
+        continue;
+      for (size_t i = 0u; i < this->batches.size(); ++i)
+      {
+        const auto &members = this->batches[i].members;
+        if (!removed[i] &&
+            std::find(members.begin(), members.end(), item) != members.end())
+        {
+          _remove.push_back(i);
+        }
+      }
+    }
+  }
+
+  for (Ogre::Item *item : restored)
+  {
+    auto it = this->memberFlags.find(item);
+    if (it == this->memberFlags.end())
+      continue;
+    item->setVisibilityFlags(it->second);
+    this->memberFlags.erase(it);
+  }
+
+  std::vector<Batch> kept;
+  for (size_t i = 0u; i < this->batches.size(); ++i)
+  {
+    if (removed[i])
+      this->DestroyBatch(this->batches[i]);
+    else
+      kept.push_back(std::move(this->batches[i]));
+  }
+  this->batches = std::move(kept);
+}
+
+//////////////////////////////////////////////////
+void Ogre2StaticBatcher::DestroyBatch(Batch &_batch)
+{
+  Ogre::SceneManager *sceneManager = this->scene->OgreSceneManager();
+  if (sceneManager)
+  {
+    if (_batch.item)
+      sceneManager->destroyItem(_batch.item);
+    if (_batch.node)
+      sceneManager->destroySceneNode(_batch.node);
+  }
+  _batch.item = nullptr;
+  _batch.node = nullptr;
+
+  if (Ogre::MeshManager::getSingleton().resourceExists(_batch.meshName))
+    Ogre::MeshManager::getSingleton().remove(_batch.meshName);
+}
+
+//////////////////////////////////////////////////
+void Ogre2StaticBatcher::SetActive(bool _active)
+{
+  if (this->active == _active)
+    return;
+  this->active = _active;
+
+  for (auto &batch : this->batches)
+    batch.item->setVisibilityFlags(_active ? batch.visibilityFlags : 0u);
+  for (auto &[item, flags] : this->memberFlags)
+    item->setVisibilityFlags(_active ? 0u : flags);
+}
+
+//////////////////////////////////////////////////
+size_t Ogre2StaticBatcher::BatchCount() const
+{
+  return this->batches.size();
+}
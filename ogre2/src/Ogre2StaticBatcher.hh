@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2STATICBATCHER_HH_
+#define GZ_RENDERING_OGRE2_OGRE2STATICBATCHER_HH_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gz/rendering/config.hh"
+
+namespace Ogre
+{
+  class Item;
+  class SceneNode;
+}
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    class Ogre2Scene;
+
+    /// \brief Merges the mesh items of static visuals into batches.
+    ///
+    /// Submeshes of static visuals that share a datablock, vertex layout,
+    /// visibility flags, shadow casting, render queue and the attributes
+    /// read by the thermal camera and GPU rays ("temperature" and
+    /// "laser_retro") are transformed to world space and merged into one
+    /// item per cell of a regular grid, so frustum culling still discards
+    /// distant batches. The original items stay in the scene with their
+    /// visibility flags cleared, so ray queries by intersection still
+    /// resolve to the original visuals.
+    ///
+    /// Sensors that need to tell visuals apart, such as picking,
+    /// segmentation and bounding box cameras, render the original items
+    /// by deactivating the batches with SetActive around their pass.
+    class Ogre2StaticBatcher
+    {
+      /// \brief Constructor
+      /// \param[in] _scene Scene whose visuals are batched
+      public: explicit Ogre2StaticBatcher(Ogre2Scene *_scene);
+
+      /// \brief Destructor. Destroys all batches.
+      public: ~Ogre2StaticBatcher();
+
+      /// \brief Destroy existing batches and batch the current static
+      /// visuals
+      /// \param[in] _cellSize Edge length of the grid cells in meters
+      /// \return Number of batches created
+      public: unsigned int Build(double _cellSize);
+
+      /// \brief Destroy all batches and show the original items again
+      public: void Clear();
+
+      /// \brief Destroy the batches that contain submeshes of a visual, and
+      /// of any visual batched together with it
+      /// \param[in] _visualId Id of the visual
+      public: void RemoveVisual(unsigned int _visualId);
+
+      /// \brief Destroy the batches that contain submeshes of an item, and
+      /// of any item batched together with it. Must be called before the
+      /// item is destroyed.
+      /// \param[in] _item Ogre item
+      public: void RemoveItem(Ogre::Item *_item);
+
+      /// \brief Render either the batches or the original items
+      /// \param[in] _active True to render the batches, false to render the
+      /// original items
+      public: void SetActive(bool _active);
+
+      /// \brief Get the number of batches
+      /// \return Number of batches
+      public: size_t BatchCount() const;
+
+      /// \brief A merged item
+      private: struct Batch
+      {
+        /// \brief Merged item
+        Ogre::Item *item = nullptr;
+
+        /// \brief Scene node the merged item is attached to
+        Ogre::SceneNode *node = nullptr;
+
+        /// \brief Name of the merged ogre mesh
+        std::string meshName;
+
+        /// \brief Visibility flags of the merged item
+        uint32_t visibilityFlags = 0u;
+
+        /// \brief Original items with submeshes in this batch
+        std::vector<Ogre::Item *> members;
+
+        /// \brief Ids of the visuals of the original items
+        std::vector<unsigned int> visualIds;
+      };
+
+      /// \brief Destroy the given batches, then the
+      /// batches that share an original item with a destroyed batch, and
+      /// show their original items again
+      /// \param[in] _remove Batch indices to destroy
+      private: void RemoveBatches(std::vector<size_t> _remove);
+
+      /// \brief Destroy the merged item and mesh of a batch
+      /// \param[in] _batch Batch to destroy
+      private: void DestroyBatch(Batch &_batch);
+
+      /// \brief Scene whose visuals are batched
+      private: Ogre2Scene *scene = nullptr;
+
+      /// \brief Batches
+      private: std::vector<Batch> batches;
+
+      /// \brief Original visibility flags of the hidden original items
+      private: std::unordered_map<Ogre::Item *, uint32_t> memberFlags;
+
+      /// \brief True if batches are rendered instead of the original items
+      private: bool active = true;
+
+      /// \brief Counter used to name merged meshes
+      private: unsigned int meshCounter = 0u;
+    };
+    }
+  }
+}
+
+#endif
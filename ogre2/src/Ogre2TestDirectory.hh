@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2TESTDIRECTORY_HH_
+#define GZ_RENDERING_OGRE2_OGRE2TESTDIRECTORY_HH_
+
+#include <fstream>
+#include <string>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/TempDirectory.hh>
+
+#include "gz/rendering/config.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Temporary directory of an ogre2 unit test, e.g. for disk
+    /// cache files and their sources. The directory name is unique to each
+    /// run, so tests running at the same time on one machine don't share
+    /// or delete each other's files. It is removed with the object.
+    class Ogre2TestDirectory
+    {
+      /// \brief Create the directory
+      /// \param[in] _prefix Prefix of the directory name
+      public: explicit Ogre2TestDirectory(const std::string &_prefix)
+        : dir(_prefix, "gz_rendering", true)
+      {
+      }
+
+      /// \brief Check if the directory was created
+      /// \return True if the directory exists
+      public: bool Valid() const
+      {
+        return this->dir.Valid();
+      }
+
+      /// \brief Get the path of the directory
+      /// \return Path of the directory
+      public: std::string Path() const
+      {
+        return this->dir.Path();
+      }
+
+      /// \brief Get the path of a file in the directory
+      /// \param[in] _name Name of the file
+      /// \return Path of the file
+      public: std::string Path(const std::string &_name) const
+      {
+        return common::joinPaths(this->dir.Path(), _name);
+      }
+
+      /// \brief Write a file in the directory, e.g. a fake cache source
+      /// \param[in] _name Name of the file
+      /// \param[in] _content Content of the file
+      /// \return Path of the file
+      public: std::string WriteFile(const std::string &_name,
+          const std::string &_content) const
+      {
+        const std::string path = this->Path(_name);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << _content;
+        return path;
+      }
+
+      /// \brief Unique temporary directory
+      private: common::TempDirectory dir;
+    };
+    }
+  }
+}
+#endif
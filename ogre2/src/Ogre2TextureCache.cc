@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+
+#include "Ogre2DiskCacheUtil.hh"
+#include "Ogre2TextureCache.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgrePixelFormatGpuUtils.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+/// \brief Identifies a texture cache file ("GZTX")
+const uint32_t kMagic = 0x58545a47u;
+
+/// \brief Version of the cache file layout. Increase it whenever the file
+/// layout or the conversion done by Ogre2TexturePipeline changes.
+const uint32_t kVersion = 1u;
+
+/// \brief Offset of the texture data in the file
+const uint64_t kDataOffset = 64u;
+
+/// \brief Header at the start of a cache file, padded to kDataOffset
+struct FileHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t sourceSize;
+  uint64_t sourceHash;
+  uint32_t format;
+  uint32_t width;
+  uint32_t height;
+  uint32_t mipmaps;
+  uint64_t dataSize;
+};
+
+static_assert(sizeof(FileHeader) <= kDataOffset,
+    "Texture cache header does not fit before the data");
+}
+
+//////////////////////////////////////////////////
+Ogre2TextureCache::Ogre2TextureCache(const std::string &_cacheDir,
+    const std::string &_sourcePath, const std::string &_variant)
+{
+  uint64_t hash = kFnvOffset;
+  if (!HashFile(_sourcePath, hash, this->sourceSize))
+    return;
+  this->sourceHash = hash;
+  this->sourceValid = true;
+
+  // entries are keyed by content, not by path
+  uint64_t key = Fnv1a(&this->sourceHash, sizeof(this->sourceHash));
+  key = Fnv1a(&this->sourceSize, sizeof(this->sourceSize), key);
+  key = Fnv1a(_variant.data(), _variant.size(), key);
+  this->cacheFile = common::joinPaths(_cacheDir,
+      CacheKeyString(key) + ".gztex");
+}
+
+//////////////////////////////////////////////////
+Ogre2TextureCache::~Ogre2TextureCache()
+{
+  this->Unmap();
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextureCache::Unmap()
+{
+#ifndef _WIN32
+  if (this->mapped && !this->fileData)
+  {
+    munmap(const_cast<uint8_t *>(this->mapped), this->mappedSize);
+  }
+#endif
+  this->fileData.reset();
+  this->mapped = nullptr;
+  this->mappedSize = 0u;
+}
+
+//////////////////////////////////////////////////
+uint64_t Ogre2TextureCache::DataSize(const Texture &_texture)
+{
+  uint64_t size = 0u;
+  for (uint8_t mip = 0u; mip < _texture.mipmaps; ++mip)
+  {
+    size += Ogre::PixelFormatGpuUtils::getSizeBytes(
+        std::max(_texture.width >> mip, 1u),
+        std::max(_texture.height >> mip, 1u),
+        1u, 1u, _texture.format, 4u);
+  }
+  return size;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2TextureCache::Read(Texture &_texture)
+{
+  _texture = Texture();
+  this->Unmap();
+
+  if (!this->sourceValid || !common::isFile(this->cacheFile))
+    return false;
+
+#ifndef _WIN32
+  int fd = open(this->cacheFile.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size <= 0)
+  {
+    close(fd);
+    return false;
+  }
+  void *addr = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+      MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED)
+    return false;
+  this->mapped = static_cast<const uint8_t *>(addr);
+  this->mappedSize = static_cast<size_t>(info.st_size);
+#else
+  std::ifstream file(this->cacheFile, std::ios::binary | std::ios::ate);
+  if (!file)
+    return false;
+  const std::streamoff size = file.tellg();
+  if (size <= 0)
+    return false;
+  this->fileData = std::make_unique<uint8_t[]>(static_cast<size_t>(size));
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char *>(this->fileData.get()), size))
+  {
+    this->fileData.reset();
+    return false;
+  }
+  this->mapped = this->fileData.get();
+  this->mappedSize = static_cast<size_t>(size);
+#endif
+
+  // the file may be truncated, from another version or, in the unlikely
+  // case of a key collision, of another image
+  FileHeader header;
+  if (this->mappedSize < kDataOffset)
+  {
+    this->Unmap();
+    return false;
+  }
+  memcpy(&header, this->mapped, sizeof(header));
+
+  Texture texture;
+  texture.format = static_cast<Ogre::PixelFormatGpu>(header.format);
+  texture.width = header.width;
+  texture.height = header.height;
+  texture.mipmaps = static_cast<uint8_t>(header.mipmaps);
+  if (header.magic != kMagic || header.version != kVersion ||
+      header.sourceSize != this->sourceSize ||
+      header.sourceHash != this->sourceHash ||
+      header.format == Ogre::PFG_UNKNOWN ||
+      header.format >= Ogre::PFG_COUNT ||
+      header.width == 0u || header.height == 0u ||
+      header.mipmaps == 0u || header.mipmaps > 16u ||
+      header.dataSize != DataSize(texture) ||
+      kDataOffset + header.dataSize > this->mappedSize)
+  {
+    this->Unmap();
+    return false;
+  }
+
+  texture.data = this->mapped + kDataOffset;
+  texture.size = header.dataSize;
+  _texture = texture;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2TextureCache::Write(const Texture &_texture) const
+{
+  if (!this->sourceValid)
+    return false;
+
+  if (!_texture.data || _texture.size != DataSize(_texture))
+  {
+    gzerr << "Invalid texture data for cache file [" << this->cacheFile
+          << "]" << std::endl;
+    return false;
+  }
+
+  const std::string dir = common::parentPath(this->cacheFile);
+  if (!common::isDirectory(dir) && !common::createDirectories(dir))
+  {
+    gzwarn << "Unable to create texture cache directory [" << dir << "]"
+           << std::endl;
+    return false;
+  }
+
+  FileHeader header{};
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.sourceSize = this->sourceSize;
+  header.sourceHash = this->sourceHash;
+  header.format = static_cast<uint32_t>(_texture.format);
+  header.width = _texture.width;
+  header.height = _texture.height;
+  header.mipmaps = _texture.mipmaps;
+  header.dataSize = _texture.size;
+
+  return WriteCacheFile(this->cacheFile, "texture", [&](std::ostream &_out)
+  {
+    char padded[kDataOffset] = {};
+    memcpy(padded, &header, sizeof(header));
+    _out.write(padded, static_cast<std::streamsize>(kDataOffset));
+    _out.write(static_cast<const char *>(_texture.data),
+        static_cast<std::streamsize>(_texture.size));
+  });
+}
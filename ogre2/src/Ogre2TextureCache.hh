@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2TEXTURECACHE_HH_
+#define GZ_RENDERING_OGRE2_OGRE2TEXTURECACHE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Export.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgrePixelFormatGpu.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Entry of the on-disk cache of GPU ready textures.
+    ///
+    /// An entry stores the whole mip chain of a texture in its final pixel
+    /// format, as produced by Ogre2TexturePipeline. It is keyed by the
+    /// content hash of the source image and a variant string, so identical
+    /// images found at different paths share one entry, and an edited
+    /// image gets a new entry.
+    ///
+    /// Cache files are memory mapped when read, so the mips are uploaded
+    /// straight from the mapping.
+    class GZ_RENDERING_OGRE2_VISIBLE Ogre2TextureCache
+    {
+      /// \brief GPU ready texture data
+      public: struct Texture
+      {
+        /// \brief Pixel format of the data
+        Ogre::PixelFormatGpu format = Ogre::PFG_UNKNOWN;
+
+        /// \brief Width of the first mip
+        uint32_t width = 0u;
+
+        /// \brief Height of the first mip
+        uint32_t height = 0u;
+
+        /// \brief Number of mips
+        uint8_t mipmaps = 1u;
+
+        /// \brief Data of all the mips, largest first, with rows aligned to
+        /// 4 bytes as expected by Ogre::Image2
+        const void *data = nullptr;
+
+        /// \brief Size of the data in bytes
+        uint64_t size = 0u;
+      };
+
+      /// \brief Constructor. Hashes the source file, which is much cheaper
+      /// than decoding it.
+      /// \param[in] _cacheDir Directory containing the cache files
+      /// \param[in] _sourcePath Path of the source image file
+      /// \param[in] _variant Conversion options that change the data, e.g.
+      /// the target pixel format
+      public: Ogre2TextureCache(const std::string &_cacheDir,
+                  const std::string &_sourcePath,
+                  const std::string &_variant);
+
+      /// \brief Destructor. Unmaps the cache file, which invalidates the
+      /// data pointer returned by Read.
+      public: ~Ogre2TextureCache();
+
+      /// \brief Map the cache file and read its texture
+      /// \param[out] _texture Texture data. The data pointer is valid until
+      /// this object is destroyed.
+      /// \return False if there is no valid cache file for the source
+      public: bool Read(Texture &_texture);
+
+      /// \brief Write the cache file. The file is written to a temporary
+      /// name and renamed, so concurrent readers never see a partial file.
+      /// \param[in] _texture Texture data
+      /// \return True if the file was written
+      public: bool Write(const Texture &_texture) const;
+
+      /// \brief Get the expected size of the data of a texture
+      /// \param[in] _texture Texture whose format, resolution and number of
+      /// mips are used
+      /// \return Size of the data of all the mips in bytes
+      public: static uint64_t DataSize(const Texture &_texture);
+
+      /// \brief Unmap the cache file if it is mapped
+      private: void Unmap();
+
+      /// \brief Path of the cache file
+      private: std::string cacheFile;
+
+      /// \brief True if the source file could be read and hashed
+      private: bool sourceValid = false;
+
+      /// \brief Size of the source file in bytes
+      private: uint64_t sourceSize = 0u;
+
+      /// \brief Content hash of the source file
+      private: uint64_t sourceHash = 0u;
+
+      /// \brief Start of the mapped cache file
+      private: const uint8_t *mapped = nullptr;
+
+      /// \brief Size of the mapped cache file
+      private: size_t mappedSize = 0u;
+
+      /// \brief Copy of the cache file on platforms without mmap
+      private: std::unique_ptr<uint8_t[]> fileData;
+    };
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gz/common/Filesystem.hh>
+
+#include "Ogre2TestDirectory.hh"
+#include "Ogre2TextureCache.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/////////////////////////////////////////////////
+TEST(Ogre2TextureCache, RoundTrip)
+{
+  Ogre2TestDirectory dir("ogre2_texture_cache");
+  ASSERT_TRUE(dir.Valid());
+
+  const std::string source = dir.WriteFile("source.png", "source image");
+  const std::string cacheDir = dir.Path("cache");
+
+  // 8x8 RGBA texture with 4 mips
+  Ogre2TextureCache::Texture texture;
+  texture.format = Ogre::PFG_RGBA8_UNORM;
+  texture.width = 8u;
+  texture.height = 8u;
+  texture.mipmaps = 4u;
+  texture.size = Ogre2TextureCache::DataSize(texture);
+  EXPECT_EQ((64u + 16u + 4u + 1u) * 4u, texture.size);
+  std::vector<uint8_t> data(static_cast<size_t>(texture.size));
+  for (size_t i = 0u; i < data.size(); ++i)
+    data[i] = static_cast<uint8_t>(i * 7u);
+  texture.data = data.data();
+
+  {
+    Ogre2TextureCache cache(cacheDir, source, "rgba");
+    Ogre2TextureCache::Texture read;
+    EXPECT_FALSE(cache.Read(read));
+    EXPECT_TRUE(cache.Write(texture));
+  }
+
+  {
+    Ogre2TextureCache cache(cacheDir, source, "rgba");
+    Ogre2TextureCache::Texture read;
+    ASSERT_TRUE(cache.Read(read));
+    EXPECT_EQ(texture.format, read.format);
+    EXPECT_EQ(texture.width, read.width);
+    EXPECT_EQ(texture.height, read.height);
+    EXPECT_EQ(texture.mipmaps, read.mipmaps);
+    ASSERT_EQ(texture.size, read.size);
+    ASSERT_NE(nullptr, read.data);
+    EXPECT_EQ(0, memcmp(data.data(), read.data, data.size()));
+  }
+
+  // other conversion options use another entry
+  {
+    Ogre2TextureCache cache(cacheDir, source, "bc1");
+    Ogre2TextureCache::Texture read;
+    EXPECT_FALSE(cache.Read(read));
+  }
+
+  // entries are keyed by content, so a copy of the source hits the cache
+  const std::string copy = dir.Path("copy.png");
+  ASSERT_TRUE(common::copyFile(source, copy));
+  {
+    Ogre2TextureCache cache(cacheDir, copy, "rgba");
+    Ogre2TextureCache::Texture read;
+    EXPECT_TRUE(cache.Read(read));
+  }
+
+  // an edited source misses the cache
+  dir.WriteFile("source.png", "edited source image");
+  {
+    Ogre2TextureCache cache(cacheDir, source, "rgba");
+    Ogre2TextureCache::Texture read;
+    EXPECT_FALSE(cache.Read(read));
+  }
+
+  // a source that can't be read is never cached
+  {
+    Ogre2TextureCache cache(cacheDir, dir.Path("missing"), "rgba");
+    Ogre2TextureCache::Texture read;
+    EXPECT_FALSE(cache.Write(texture));
+    EXPECT_FALSE(cache.Read(read));
+  }
+}
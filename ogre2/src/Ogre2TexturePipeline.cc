@@ -0,0 +1,420 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include <gz/common/Console.hh>
+
+#include "Ogre2TexturePipeline.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreImage2.h>
+#include <OgrePixelFormatGpuUtils.h>
+#include <OgreRenderSystem.h>
+#include <OgreRenderSystemCapabilities.h>
+#include <OgreResourceGroupManager.h>
+#include <OgreTextureGpuManager.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+/// \brief Pack a color to 5:6:5 bits
+/// \param[in] _rgb Color with 8 bit channels
+/// \return Packed color
+uint16_t To565(const int _rgb[3])
+{
+  const int r = (_rgb[0] * 31 + 127) / 255;
+  const int g = (_rgb[1] * 63 + 127) / 255;
+  const int b = (_rgb[2] * 31 + 127) / 255;
+  return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+/// \brief Unpack a 5:6:5 color to 8 bit channels
+/// \param[in] _color Packed color
+/// \param[out] _rgb Color with 8 bit channels
+void From565(uint16_t _color, int _rgb[3])
+{
+  const int r = (_color >> 11) & 0x1f;
+  const int g = (_color >> 5) & 0x3f;
+  const int b = _color & 0x1f;
+  _rgb[0] = (r << 3) | (r >> 2);
+  _rgb[1] = (g << 2) | (g >> 4);
+  _rgb[2] = (b << 3) | (b >> 2);
+}
+
+/// \brief Encode the color of a 4x4 block as a BC1 block, always in the
+/// four color mode so it can also be used in BC3 blocks.
+///
+/// The endpoints are the corners of the color bounding box, inset to
+/// reduce the error of the interpolated colors, along the diagonal that
+/// follows the correlation of the channels.
+/// \param[in] _block 16 RGBA pixels, row by row
+/// \param[out] _out 8 byte block
+void EncodeBc1(const uint8_t *_block, uint8_t *_out)
+{
+  int minColor[3] = {255, 255, 255};
+  int maxColor[3] = {0, 0, 0};
+  for (int i = 0; i < 16; ++i)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      minColor[c] = std::min(minColor[c], static_cast<int>(_block[i*4 + c]));
+      maxColor[c] = std::max(maxColor[c], static_cast<int>(_block[i*4 + c]));
+    }
+  }
+
+  for (int c = 0; c < 3; ++c)
+  {
+    const int inset = (maxColor[c] - minColor[c]) >> 4;
+    minColor[c] += inset;
+    maxColor[c] -= inset;
+  }
+
+  // flip green and blue if they decrease while red increases
+  int covariance[3] = {0, 0, 0};
+  for (int i = 0; i < 16; ++i)
+  {
+    const int r = 2 * _block[i*4] - minColor[0] - maxColor[0];
+    for (int c = 1; c < 3; ++c)
+      covariance[c] += r * (2 * _block[i*4 + c] - minColor[c] - maxColor[c]);
+  }
+  for (int c = 1; c < 3; ++c)
+  {
+    if (covariance[c] < 0)
+      std::swap(minColor[c], maxColor[c]);
+  }
+
+  uint16_t color0 = To565(maxColor);
+  uint16_t color1 = To565(minColor);
+  if (color0 < color1)
+    std::swap(color0, color1);
+
+  uint32_t indices = 0u;
+  if (color0 != color1)
+  {
+    int palette[4][3];
+    From565(color0, palette[0]);
+    From565(color1, palette[1]);
+    for (int c = 0; c < 3; ++c)
+    {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+      int best = 0;
+      int bestDistance = std::numeric_limits<int>::max();
+      for (int p = 0; p < 4; ++p)
+      {
+        int distance = 0;
+        for (int c = 0; c < 3; ++c)
+        {
+          const int d = _block[i*4 + c] - palette[p][c];
+          distance += d * d;
+        }
+        if (distance < bestDistance)
+        {
+          bestDistance = distance;
+          best = p;
+        }
+      }
+      indices |= static_cast<uint32_t>(best) << (2 * i);
+    }
+  }
+
+  _out[0] = static_cast<uint8_t>(color0 & 0xff);
+  _out[1] = static_cast<uint8_t>(color0 >> 8);
+  _out[2] = static_cast<uint8_t>(color1 & 0xff);
+  _out[3] = static_cast<uint8_t>(color1 >> 8);
+  for (int i = 0; i < 4; ++i)
+    _out[4 + i] = static_cast<uint8_t>((indices >> (8 * i)) & 0xff);
+}
+
+/// \brief Encode one channel of a 4x4 block as a BC4 block in the eight
+/// value mode. Values are unsigned bytes, or signed bytes for the SNORM
+/// variant.
+/// \param[in] _values 16 values, row by row
+/// \param[out] _out 8 byte block
+void EncodeBc4(const int *_values, uint8_t *_out)
+{
+  const int maxValue = *std::max_element(_values, _values + 16);
+  const int minValue = *std::min_element(_values, _values + 16);
+  _out[0] = static_cast<uint8_t>(maxValue & 0xff);
+  _out[1] = static_cast<uint8_t>(minValue & 0xff);
+
+  uint64_t indices = 0u;
+  if (maxValue != minValue)
+  {
+    int palette[8];
+    palette[0] = maxValue;
+    palette[1] = minValue;
+    for (int p = 2; p < 8; ++p)
+    {
+      palette[p] = static_cast<int>(std::lround(
+          ((8 - p) * maxValue + (p - 1) * minValue) / 7.0));
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+      int best = 0;
+      int bestDistance = std::numeric_limits<int>::max();
+      for (int p = 0; p < 8; ++p)
+      {
+        const int distance = std::abs(_values[i] - palette[p]);
+        if (distance < bestDistance)
+        {
+          bestDistance = distance;
+          best = p;
+        }
+      }
+      indices |= static_cast<uint64_t>(best) << (3 * i);
+    }
+  }
+
+  for (int i = 0; i < 6; ++i)
+    _out[2 + i] = static_cast<uint8_t>((indices >> (8 * i)) & 0xff);
+}
+
+/// \brief Copy a 4x4 block out of an RGBA mip, clamping at the edges of
+/// mips smaller than a block
+/// \param[in] _box RGBA mip
+/// \param[in] _x Left column of the block
+/// \param[in] _y Top row of the block
+/// \param[out] _block 16 RGBA pixels, row by row
+void FetchBlock(const Ogre::TextureBox &_box, uint32_t _x, uint32_t _y,
+    uint8_t *_block)
+{
+  for (uint32_t j = 0u; j < 4u; ++j)
+  {
+    const uint32_t y = std::min(_y + j, _box.height - 1u);
+    const uint8_t *row = static_cast<const uint8_t *>(_box.data) +
+        static_cast<size_t>(y) * _box.bytesPerRow;
+    for (uint32_t i = 0u; i < 4u; ++i)
+    {
+      const uint32_t x = std::min(_x + i, _box.width - 1u);
+      memcpy(_block + (j * 4u + i) * 4u, row + x * 4u, 4u);
+    }
+  }
+}
+}
+
+//////////////////////////////////////////////////
+bool Ogre2TexturePipeline::Convert(const common::Image &_image,
+    const Options &_options, std::vector<uint8_t> &_storage,
+    Ogre2TextureCache::Texture &_texture)
+{
+  if (!_image.Valid())
+    return false;
+
+  // channel expansion: grayscale, palette and RGB images all become RGBA
+  const uint32_t width = _image.Width();
+  const uint32_t height = _image.Height();
+  const std::vector<unsigned char> rgba = _image.RGBAData();
+  if (width == 0u || height == 0u ||
+      rgba.size() != static_cast<size_t>(width) * height * 4u)
+  {
+    return false;
+  }
+
+  const uint8_t mipmaps =
+      Ogre::PixelFormatGpuUtils::getMaxMipmapCount(std::max(width, height));
+  Ogre::Image2 image;
+  image.createEmptyImage(width, height, 1u, Ogre::TextureTypes::Type2D,
+      Ogre::PFG_RGBA8_UNORM, mipmaps);
+  Ogre::TextureBox top = image.getData(0u);
+  for (uint32_t y = 0u; y < height; ++y)
+  {
+    memcpy(static_cast<uint8_t *>(top.data) + y * top.bytesPerRow,
+        &rgba[static_cast<size_t>(y) * width * 4u], width * 4u);
+  }
+  if (mipmaps > 1u && !image.generateMipmaps(_options.srgb))
+    return false;
+
+  // block compressed formats need whole blocks in the first mip
+  const bool blocks = (width % 4u) == 0u && (height % 4u) == 0u;
+  bool alpha = false;
+  for (size_t i = 3u; i < rgba.size() && !alpha; i += 4u)
+    alpha = rgba[i] < 255u;
+
+  Ogre::PixelFormatGpu format = _options.srgb ?
+      Ogre::PFG_RGBA8_UNORM_SRGB : Ogre::PFG_RGBA8_UNORM;
+  if (_options.normalMap)
+  {
+    if (_options.compressNormals && blocks)
+      format = Ogre::PFG_BC5_SNORM;
+  }
+  else if (_options.compressColor && blocks)
+  {
+    if (alpha)
+      format = _options.srgb ? Ogre::PFG_BC3_UNORM_SRGB : Ogre::PFG_BC3_UNORM;
+    else
+      format = _options.srgb ? Ogre::PFG_BC1_UNORM_SRGB : Ogre::PFG_BC1_UNORM;
+  }
+
+  _texture = Ogre2TextureCache::Texture();
+  _texture.format = format;
+  _texture.width = width;
+  _texture.height = height;
+  _texture.mipmaps = mipmaps;
+  _texture.size = Ogre2TextureCache::DataSize(_texture);
+  _storage.assign(static_cast<size_t>(_texture.size), 0u);
+
+  const bool compressed = Ogre::PixelFormatGpuUtils::isCompressed(format);
+  uint8_t *out = _storage.data();
+  for (uint8_t mip = 0u; mip < mipmaps; ++mip)
+  {
+    const Ogre::TextureBox box = image.getData(mip);
+    if (!compressed)
+    {
+      for (uint32_t y = 0u; y < box.height; ++y)
+      {
+        memcpy(out, static_cast<const uint8_t *>(box.data) +
+            static_cast<size_t>(y) * box.bytesPerRow, box.width * 4u);
+        out += box.width * 4u;
+      }
+      continue;
+    }
+
+    uint8_t block[64];
+    for (uint32_t y = 0u; y < box.height; y += 4u)
+    {
+      for (uint32_t x = 0u; x < box.width; x += 4u)
+      {
+        FetchBlock(box, x, y, block);
+        if (format == Ogre::PFG_BC5_SNORM)
+        {
+          // normals are stored as signed x and y, z is rebuilt by the shader
+          for (int c = 0; c < 2; ++c)
+          {
+            int values[16];
+            for (int i = 0; i < 16; ++i)
+            {
+              values[i] = static_cast<int>(std::lround(
+                  block[i*4 + c] * (254.0 / 255.0) - 127.0));
+            }
+            EncodeBc4(values, out);
+            out += 8u;
+          }
+        }
+        else if (format == Ogre::PFG_BC3_UNORM ||
+                 format == Ogre::PFG_BC3_UNORM_SRGB)
+        {
+          int values[16];
+          for (int i = 0; i < 16; ++i)
+            values[i] = block[i*4 + 3];
+          EncodeBc4(values, out);
+          EncodeBc1(block, out + 8u);
+          out += 16u;
+        }
+        else
+        {
+          EncodeBc1(block, out);
+          out += 8u;
+        }
+      }
+    }
+  }
+
+  _texture.data = _storage.data();
+  return static_cast<uint64_t>(out - _storage.data()) == _texture.size;
+}
+
+//////////////////////////////////////////////////
+Ogre::TextureGpu *Ogre2TexturePipeline::Upload(
+    Ogre::TextureGpuManager *_textureMgr, const std::string &_name,
+    const Ogre2TextureCache::Texture &_texture)
+{
+  Ogre::TextureGpu *texture = _textureMgr->createOrRetrieveTexture(
+      _name,
+      Ogre::GpuPageOutStrategy::Discard,
+      Ogre::TextureFlags::AutomaticBatching |
+      Ogre::TextureFlags::ManualTexture,
+      Ogre::TextureTypes::Type2D,
+      Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME,
+      0u);
+
+  // Has to be loaded
+  if (texture->getWidth() == 0)
+  {
+    texture->setPixelFormat(_texture.format);
+    texture->setTextureType(Ogre::TextureTypes::Type2D);
+    texture->setNumMipmaps(_texture.mipmaps);
+    texture->setResolution(_texture.width, _texture.height);
+    texture->scheduleTransitionTo(Ogre::GpuResidency::Resident);
+    texture->waitForData();
+
+    // the image only wraps the data, which may be a mapped cache file
+    Ogre::Image2 image;
+    image.loadDynamicImage(const_cast<void *>(_texture.data),
+        _texture.width, _texture.height, 1u, Ogre::TextureTypes::Type2D,
+        _texture.format, false, _texture.mipmaps);
+    image.uploadTo(texture, 0u, static_cast<uint8_t>(_texture.mipmaps - 1u));
+  }
+  return texture;
+}
+
+//////////////////////////////////////////////////
+Ogre::TextureGpu *Ogre2TexturePipeline::Load(
+    Ogre::RenderSystem *_renderSystem, const std::string &_path,
+    const std::string &_name, const std::string &_cacheDir, Options _options)
+{
+  Ogre::TextureGpuManager *textureMgr = _renderSystem->getTextureGpuManager();
+  Ogre::TextureGpu *texture = textureMgr->findTextureNoThrow(_name);
+  if (texture)
+    return texture;
+
+  const Ogre::RenderSystemCapabilities *caps =
+      _renderSystem->getCapabilities();
+  _options.compressColor = _options.compressColor &&
+      caps->hasCapability(Ogre::RSC_TEXTURE_COMPRESSION_DXT);
+  _options.compressNormals = _options.compressNormals &&
+      caps->hasCapability(Ogre::RSC_TEXTURE_COMPRESSION_BC4_BC5);
+
+  std::string variant;
+  variant += _options.srgb ? "srgb\n" : "linear\n";
+  variant += _options.normalMap ? "normal\n" : "color\n";
+  variant += _options.compressColor ? "bc13\n" : "\n";
+  variant += _options.compressNormals ? "bc5\n" : "\n";
+  Ogre2TextureCache cache(_cacheDir, _path, variant);
+
+  Ogre2TextureCache::Texture converted;
+  if (cache.Read(converted))
+    return Upload(textureMgr, _name, converted);
+
+  common::Image image(_path);
+  std::vector<uint8_t> storage;
+  if (!Convert(image, _options, storage, converted))
+  {
+    gzerr << "Unable to convert texture [" << _path << "]" << std::endl;
+    return nullptr;
+  }
+  cache.Write(converted);
+  return Upload(textureMgr, _name, converted);
+}
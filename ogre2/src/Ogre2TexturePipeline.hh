@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2TEXTUREPIPELINE_HH_
+#define GZ_RENDERING_OGRE2_OGRE2TEXTUREPIPELINE_HH_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gz/common/Image.hh>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Export.hh"
+
+#include "Ogre2TextureCache.hh"
+
+namespace Ogre
+{
+  class RenderSystem;
+  class TextureGpu;
+  class TextureGpuManager;
+}
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Converts image files to GPU ready textures.
+    ///
+    /// Each source image is converted once: its channels are expanded to
+    /// RGBA, a full mip chain is generated on the CPU and, if the render
+    /// system supports it and the image size is a multiple of 4, the mips
+    /// are block compressed. Color textures become BC1, or BC3 if they have
+    /// transparent pixels, and normal maps become signed BC5. The result is
+    /// stored in the on-disk texture cache, so later loads upload the mips
+    /// straight from the cache file without decoding the image.
+    class GZ_RENDERING_OGRE2_VISIBLE Ogre2TexturePipeline
+    {
+      /// \brief Conversion options
+      public: struct Options
+      {
+        /// \brief True if the texture holds sRGB colors
+        bool srgb = false;
+
+        /// \brief True if the texture is a tangent space normal map
+        bool normalMap = false;
+
+        /// \brief Allow BC1 and BC3 compression of color textures
+        bool compressColor = false;
+
+        /// \brief Allow BC5 compression of normal maps
+        bool compressNormals = false;
+      };
+
+      /// \brief Load an image file as a manual texture, converting it or
+      /// reading it from the cache
+      /// \param[in] _renderSystem Render system, used to check which
+      /// compressed formats are supported
+      /// \param[in] _path Path of the image file
+      /// \param[in] _name Name of the texture to create
+      /// \param[in] _cacheDir Directory of the texture cache
+      /// \param[in] _options Conversion options. The compression flags are
+      /// cleared if the render system does not support the formats.
+      /// \return Texture ready to be used, null if the image could not be
+      /// loaded
+      public: static Ogre::TextureGpu *Load(
+                  Ogre::RenderSystem *_renderSystem,
+                  const std::string &_path,
+                  const std::string &_name,
+                  const std::string &_cacheDir,
+                  Options _options);
+
+      /// \brief Convert an image to GPU ready mips
+      /// \param[in] _image Source image
+      /// \param[in] _options Conversion options
+      /// \param[out] _storage Storage of the converted data
+      /// \param[out] _texture Converted texture, pointing to _storage
+      /// \return True if the image was converted
+      public: static bool Convert(const common::Image &_image,
+                  const Options &_options,
+                  std::vector<uint8_t> &_storage,
+                  Ogre2TextureCache::Texture &_texture);
+
+      /// \brief Upload GPU ready mips to a new manual texture. Nothing is
+      /// uploaded if a texture with the same name is already loaded.
+      /// \param[in] _textureMgr Texture manager
+      /// \param[in] _name Name of the texture
+      /// \param[in] _texture Mips to upload
+      /// \return The texture
+      public: static Ogre::TextureGpu *Upload(
+                  Ogre::TextureGpuManager *_textureMgr,
+                  const std::string &_name,
+                  const Ogre2TextureCache::Texture &_texture);
+    };
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gz/common/Image.hh>
+
+#include "Ogre2TexturePipeline.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+/// \brief Create an image
+/// \param[in] _width Width of the image
+/// \param[in] _height Height of the image
+/// \param[in] _alpha Alpha of all the pixels
+/// \return Image with a red gradient along x and a green gradient along y
+common::Image GradientImage(unsigned int _width, unsigned int _height,
+    unsigned char _alpha = 255u)
+{
+  std::vector<unsigned char> data;
+  for (unsigned int y = 0; y < _height; ++y)
+  {
+    for (unsigned int x = 0; x < _width; ++x)
+    {
+      data.push_back(static_cast<unsigned char>(x * 255u / _width));
+      data.push_back(static_cast<unsigned char>(y * 255u / _height));
+      data.push_back(128u);
+      data.push_back(_alpha);
+    }
+  }
+  common::Image image;
+  image.SetFromData(data.data(), _width, _height,
+      common::Image::RGBA_INT8);
+  return image;
+}
+
+/// \brief Decode the color of a BC1 block
+/// \param[in] _block 8 byte block
+/// \param[out] _rgb 16 RGB pixels, row by row
+void DecodeBc1(const uint8_t *_block, int _rgb[16][3])
+{
+  const uint16_t color0 = static_cast<uint16_t>(_block[0] | _block[1] << 8);
+  const uint16_t color1 = static_cast<uint16_t>(_block[2] | _block[3] << 8);
+  int palette[4][3];
+  const uint16_t colors[2] = {color0, color1};
+  for (int p = 0; p < 2; ++p)
+  {
+    const int r = (colors[p] >> 11) & 0x1f;
+    const int g = (colors[p] >> 5) & 0x3f;
+    const int b = colors[p] & 0x1f;
+    palette[p][0] = (r << 3) | (r >> 2);
+    palette[p][1] = (g << 2) | (g >> 4);
+    palette[p][2] = (b << 3) | (b >> 2);
+  }
+  for (int c = 0; c < 3; ++c)
+  {
+    if (color0 > color1)
+    {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+    else
+    {
+      palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+      palette[3][c] = 0;
+    }
+  }
+
+  const uint32_t indices = static_cast<uint32_t>(_block[4]) |
+      static_cast<uint32_t>(_block[5]) << 8 |
+      static_cast<uint32_t>(_block[6]) << 16 |
+      static_cast<uint32_t>(_block[7]) << 24;
+  for (int i = 0; i < 16; ++i)
+  {
+    for (int c = 0; c < 3; ++c)
+      _rgb[i][c] = palette[(indices >> (2 * i)) & 0x3][c];
+  }
+}
+}
+
+/////////////////////////////////////////////////
+TEST(Ogre2TexturePipeline, ConvertUncompressed)
+{
+  Ogre2TexturePipeline::Options options;
+  options.srgb = true;
+
+  std::vector<uint8_t> storage;
+  Ogre2TextureCache::Texture texture;
+  ASSERT_TRUE(Ogre2TexturePipeline::Convert(GradientImage(64u, 64u),
+      options, storage, texture));
+  EXPECT_EQ(Ogre::PFG_RGBA8_UNORM_SRGB, texture.format);
+  EXPECT_EQ(64u, texture.width);
+  EXPECT_EQ(64u, texture.height);
+
+  // 64, 32, 16, 8, 4, 2 and 1 pixels wide
+  EXPECT_EQ(7u, texture.mipmaps);
+  uint64_t size = 0u;
+  for (uint64_t side = 64u; side > 0u; side /= 2u)
+    size += side * side * 4u;
+  EXPECT_EQ(size, texture.size);
+  EXPECT_EQ(size, storage.size());
+  EXPECT_EQ(storage.data(), texture.data);
+
+  // the first mip is the image itself
+  const common::Image image = GradientImage(64u, 64u);
+  const std::vector<unsigned char> rgba = image.RGBAData();
+  EXPECT_TRUE(std::equal(rgba.begin(), rgba.end(), storage.begin()));
+}
+
+/////////////////////////////////////////////////
+TEST(Ogre2TexturePipeline, ConvertFormats)
+{
+  std::vector<uint8_t> storage;
+  Ogre2TextureCache::Texture texture;
+
+  Ogre2TexturePipeline::Options options;
+  options.compressColor = true;
+  options.compressNormals = true;
+
+  ASSERT_TRUE(Ogre2TexturePipeline::Convert(GradientImage(64u, 64u),
+      options, storage, texture));
+  EXPECT_EQ(Ogre::PFG_BC1_UNORM, texture.format);
+
+  // transparent pixels need BC3
+  ASSERT_TRUE(Ogre2TexturePipeline::Convert(GradientImage(64u, 64u, 100u),
+      options, storage, texture));
+  EXPECT_EQ(Ogre::PFG_BC3_UNORM, texture.format);
+
+  options.srgb = true;
+  ASSERT_TRUE(Ogre2TexturePipeline::Convert(GradientImage(64u, 64u),
+      options, storage, texture));
+  EXPECT_EQ(Ogre::PFG_BC1_UNORM_SRGB, texture.format);
+
+  options.srgb = false;
+  options.normalMap = true;
+  ASSERT_TRUE(Ogre2TexturePipeline::Convert(GradientImage(64u, 64u),
+      options, storage, texture));
+  EXPECT_EQ(Ogre::PFG_BC5_SNORM, texture.format);
+
+  // normal maps are not compressed as colors
+  options.compressNormals = false;
+  ASSERT_TRUE(Ogre2TexturePipeline::Convert(GradientImage(64u, 64u),
+      options, storage, texture));
+  EXPECT_EQ(Ogre::PFG_RGBA8_UNORM, texture.format);
+
+  // invalid image
+  EXPECT_FALSE(Ogre2TexturePipeline::Convert(common::Image(), options,
+      storage, texture));
+}
+
+/////////////////////////////////////////////////
+TEST(Ogre2TexturePipeline, ConvertBlockSizes)
+{
+  Ogre2TexturePipeline::Options options;
+  options.compressColor = true;
+
+  std::vector<uint8_t> storage;
+  Ogre2TextureCache::Texture texture;
+
+  // mips smaller than a block still take a whole 8 byte block
+  ASSERT_TRUE(Ogre2TexturePipeline::Convert(GradientImage(64u, 64u),
+      options, storage, texture));
+  EXPECT_EQ(Ogre::PFG_BC1_UNORM, texture.format);
+  EXPECT_EQ(7u, texture.mipmaps);
+  EXPECT_EQ((256u + 64u + 16u + 4u + 1u + 1u + 1u) * 8u, texture.size);
+  EXPECT_EQ(texture.size, storage.size());
+
+  // 20x12, 10x6, 5x3, 2x1 and 1x1 pixels, the partial blocks of the
+  // smaller mips are rounded up
+  ASSERT_TRUE(Ogre2TexturePipeline::Convert(GradientImage(20u, 12u),
+      options, storage, texture));
+  EXPECT_EQ(Ogre::PFG_BC1_UNORM, texture.format);
+  EXPECT_EQ(5u, texture.mipmaps);
+  EXPECT_EQ((15u + 6u + 2u + 1u + 1u) * 8u, texture.size);
+
+  // the first mip needs whole blocks to be compressed
+  ASSERT_TRUE(Ogre2TexturePipeline::Convert(GradientImage(30u, 30u),
+      options, storage, texture));
+  EXPECT_EQ(Ogre::PFG_RGBA8_UNORM, texture.format);
+  EXPECT_EQ(5u, texture.mipmaps);
+  EXPECT_EQ((30u * 30u + 15u * 15u + 7u * 7u + 3u * 3u + 1u) * 4u,
+      texture.size);
+  EXPECT_EQ(texture.size, storage.size());
+}
+
+/////////////////////////////////////////////////
+TEST(Ogre2TexturePipeline, ConvertBc1Error)
+{
+  Ogre2TexturePipeline::Options options;
+  options.compressColor = true;
+
+  const common::Image image = GradientImage(64u, 64u);
+  std::vector<uint8_t> storage;
+  Ogre2TextureCache::Texture texture;
+  ASSERT_TRUE(Ogre2TexturePipeline::Convert(image, options, storage,
+      texture));
+  ASSERT_EQ(Ogre::PFG_BC1_UNORM, texture.format);
+
+  // decode the first mip and compare it with the image
+  const std::vector<unsigned char> rgba = image.RGBAData();
+  int maxError = 0;
+  uint64_t totalError = 0u;
+  for (unsigned int by = 0u; by < 16u; ++by)
+  {
+    for (unsigned int bx = 0u; bx < 16u; ++bx)
+    {
+      int decoded[16][3];
+      DecodeBc1(storage.data() + (by * 16u + bx) * 8u, decoded);
+      for (unsigned int i = 0u; i < 16u; ++i)
+      {
+        const unsigned int x = bx * 4u + i % 4u;
+        const unsigned int y = by * 4u + i / 4u;
+        for (unsigned int c = 0u; c < 3u; ++c)
+        {
+          const int error = std::abs(decoded[i][c] -
+              static_cast<int>(rgba[(y * 64u + x) * 4u + c]));
+          maxError = std::max(maxError, error);
+          totalError += static_cast<uint64_t>(error);
+        }
+      }
+    }
+  }
+
+  // a smooth gradient is close to the end points of each block
+  EXPECT_LE(maxError, 12);
+  EXPECT_LE(static_cast<double>(totalError) / (64.0 * 64.0 * 3.0), 4.0);
+}
@@ -250,6 +250,8 @@ void Ogre2ThermalCameraMaterialSwitcher::cameraPreRenderScene(
     hlmsManager->getBlendblock(Ogre::HlmsBlendblock());
 
   const std::string tempKey = "temperature";
+  const unsigned int tempHandle =
+      this->scene->InternAttribute(tempKey, NodeAttributeType::FLOAT);
 
   auto itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
       Ogre::ItemFactory::FACTORY_TYPE_NAME);
@@ -262,55 +264,42 @@ void Ogre2ThermalCameraMaterialSwitcher::cameraPreRenderScene(
     Ogre::Any userAny = item->getUserObjectBindings().getUserAny();
     if (!userAny.isEmpty() && userAny.getType() == typeid(unsigned int))
     {
-      VisualPtr result;
-      try
-      {
-        result = this->scene->VisualById(Ogre::any_cast<unsigned int>(userAny));
-      }
-      catch(Ogre::Exception &e)
-      {
-        gzerr << "Ogre Error:" << e.getFullDescription() << "\n";
-      }
-      Ogre2VisualPtr ogreVisual =
-          std::dynamic_pointer_cast<Ogre2Visual>(result);
+      const unsigned int visualId = Ogre::any_cast<unsigned int>(userAny);
 
-      // get temperature
-      Variant tempAny = ogreVisual->UserData(tempKey);
-      if (tempAny.index() != 0 && !std::holds_alternative<std::string>(tempAny))
+      // get temperature. Numeric temperatures are read from the interned
+      // attribute storage; only heat signatures need the visual itself
+      float temp = -1.0;
+      const bool foundTemp =
+          this->scene->FloatAttribute(tempHandle, visualId, temp);
+
+      Ogre2VisualPtr ogreVisual;
+      Variant tempAny;
+      if (!foundTemp)
       {
-        float temp = -1.0;
-        bool foundTemp = true;
+        VisualPtr result;
         try
         {
-          temp = std::get<float>(tempAny);
+          result = this->scene->VisualById(visualId);
         }
-        catch(...)
+        catch(Ogre::Exception &e)
         {
-          try
-          {
-            temp = static_cast<float>(std::get<double>(tempAny));
-          }
-          catch(...)
-          {
-            try
-            {
-              temp = static_cast<float>(std::get<int>(tempAny));
-            }
-            catch(std::bad_variant_access &e)
-            {
-              gzerr << "Error casting user data: " << e.what() << "\n";
-              temp = -1.0;
-              foundTemp = false;
-            }
-          }
+          gzerr << "Ogre Error:" << e.getFullDescription() << "\n";
         }
+        ogreVisual = std::dynamic_pointer_cast<Ogre2Visual>(result);
+        if (ogreVisual)
+          tempAny = ogreVisual->UserData(tempKey);
+      }
 
+      if (foundTemp)
+      {
         // if a non-positive temperature was given, clamp it to 0
-        if (foundTemp && temp < 0.0)
+        if (temp < 0.0)
         {
           temp = 0.0;
+          VisualPtr visual = this->scene->VisualById(visualId);
           gzwarn << "Unable to set negatve temperature for: "
-              << ogreVisual->Name() << ". Value cannot be lower than absolute "
+              << (visual ? visual->Name() : std::to_string(visualId))
+              << ". Value cannot be lower than absolute "
               << "zero. Clamping temperature to 0 degrees Kelvin."
               << std::endl;
         }
@@ -554,38 +543,17 @@ void Ogre2ThermalCameraMaterialSwitcher::cameraPreRenderScene(
       VisualPtr visual = heightmap->Parent();
 
       // get temperature
-      Variant tempAny = visual->UserData(tempKey);
-      if (tempAny.index() != 0 && !std::holds_alternative<std::string>(tempAny))
+      float temp = -1.0;
+      const bool foundTemp =
+          this->scene->FloatAttribute(tempHandle, visual->Id(), temp);
+      Variant tempAny;
+      if (!foundTemp)
+        tempAny = visual->UserData(tempKey);
+
+      if (foundTemp)
       {
-        float temp = -1.0;
-        bool foundTemp = true;
-        try
-        {
-          temp = std::get<float>(tempAny);
-        }
-        catch (...)
-        {
-          try
-          {
-            temp = static_cast<float>(std::get<double>(tempAny));
-          }
-          catch (...)
-          {
-            try
-            {
-              temp = static_cast<float>(std::get<int>(tempAny));
-            }
-            catch (std::bad_variant_access &e)
-            {
-              gzerr << "Error casting user data: " << e.what() << "\n";
-              temp = -1.0;
-              foundTemp = false;
-            }
-          }
-        }
-
         // if a non-positive temperature was given, clamp it to 0
-        if (foundTemp && temp < 0.0)
+        if (temp < 0.0)
         {
           temp = 0.0;
           gzwarn << "Unable to set negatve temperature for: " << visual->Name()
@@ -598,7 +566,7 @@ void Ogre2ThermalCameraMaterialSwitcher::cameraPreRenderScene(
         const float color = static_cast<float>((temp / this->resolution) /
                                                ((1 << bitDepth) - 1.0));
 
-        heightmap->Terra()->SetSolidColor(1u, Ogre::Vector4(color, 0, 0, 0.0));
+        heightmap->SetSolidColor(1u, Ogre::Vector4(color, 0, 0, 0.0));
         // TODO(anyone): Retrieve datablock and make sure it's not blending
         // like we do with Items (it should be impossible?)
       }
@@ -615,8 +583,8 @@ void Ogre2ThermalCameraMaterialSwitcher::cameraPreRenderScene(
 
         // TODO(anyone): Retrieve datablock and get diffuse color
         // (it's likely gonna be 1 1 1 1 anyway... Does it matter?).
-        heightmap->Terra()->SetSolidColor(1u,
-                                          Ogre::Vector4(1.0, 1.0, 1.0, 1.0));
+        heightmap->SetSolidColor(1u,
+            Ogre::Vector4(1.0, 1.0, 1.0, 1.0));
         // TODO(anyone): Retrieve datablock and make sure it's not blending
         // like we do with Items (it should be impossible?)
       }
@@ -680,7 +648,7 @@ void Ogre2ThermalCameraMaterialSwitcher::cameraPostRenderScene(
   {
     auto heightmap = h.lock();
     if (heightmap)
-      heightmap->Terra()->UnsetSolidColors();
+      heightmap->UnsetSolidColors();
   }
 
   // restore item to use pbs hlms material
@@ -1106,6 +1074,8 @@ void Ogre2ThermalCamera::Render()
   const bool bOldDepthClamp = this->ogreCamera->getNeedsDepthClamp();
   this->ogreCamera->_setNeedsDepthClamp(true);
 
+  this->UpdateLodBias(this->ogreCamera, this->ImageHeight());
+
   // update the compositors
   this->scene->StartRendering(this->ogreCamera);
 
@@ -21,6 +21,7 @@
 #include "gz/rendering/ogre2/Ogre2Geometry.hh"
 #include "gz/rendering/ogre2/Ogre2ParticleEmitter.hh"
 #include "gz/rendering/ogre2/Ogre2RenderTypes.hh"
+#include "gz/rendering/ogre2/Ogre2Scene.hh"
 #include "gz/rendering/ogre2/Ogre2Storage.hh"
 #include "gz/rendering/ogre2/Ogre2Visual.hh"
 #include "gz/rendering/Utils.hh"
@@ -48,6 +49,7 @@ Ogre2Visual::Ogre2Visual()
   : dataPtr(new Ogre2VisualPrivate)
 {
   this->dataPtr->wireframe = false;
+  this->recyclable = true;
 }
 
 //////////////////////////////////////////////////
@@ -102,12 +104,50 @@ void Ogre2Visual::SetVisible(bool _visible)
   if (!this->ogreNode)
     return;
 
+  // batches would keep drawing the visual, or would not draw it again.
+  // Visibility cascades to the descendants, but the batches do not hang
+  // off this node.
+  this->RemoveTreeFromStaticBatches();
+
   this->ogreNode->setVisible(_visible);
+  this->RecordChange(SceneChangeType::VISIBILITY_CHANGED, this->Id());
+}
+
+//////////////////////////////////////////////////
+void Ogre2Visual::RemoveTreeFromStaticBatches()
+{
+  if (!this->scene || this->scene->StaticBatchCount() == 0u)
+    return;
+
+  if (this->Static())
+    this->scene->RemoveFromStaticBatches(this->Id());
+
+  for (unsigned int i = 0; i < this->ChildCount(); ++i)
+  {
+    Ogre2VisualPtr child =
+        std::dynamic_pointer_cast<Ogre2Visual>(this->ChildByIndex(i));
+    if (child)
+      child->RemoveTreeFromStaticBatches();
+  }
+}
+
+//////////////////////////////////////////////////
+bool Ogre2Visual::DetachChild(NodePtr _child)
+{
+  // the batches would keep drawing a subtree that left the scene graph
+  Ogre2VisualPtr child = std::dynamic_pointer_cast<Ogre2Visual>(_child);
+  if (child)
+    child->RemoveTreeFromStaticBatches();
+
+  return Ogre2Node::DetachChild(_child);
 }
 
 //////////////////////////////////////////////////
 void Ogre2Visual::SetVisibilityFlags(uint32_t _flags)
 {
+  if (this->Static() && this->scene)
+    this->scene->RemoveFromStaticBatches(this->Id());
+
   BaseVisual::SetVisibilityFlags(_flags);
 
   if (!this->ogreNode)
@@ -120,6 +160,15 @@ void Ogre2Visual::SetVisibilityFlags(uint32_t _flags)
   }
 }
 
+//////////////////////////////////////////////////
+void Ogre2Visual::SetStatic(bool _static)
+{
+  if (!_static && this->Static() && this->scene)
+    this->scene->RemoveFromStaticBatches(this->Id());
+
+  BaseVisual::SetStatic(_static);
+}
+
 //////////////////////////////////////////////////
 GeometryStorePtr Ogre2Visual::Geometries() const
 {
@@ -300,7 +349,7 @@ void Ogre2Visual::BoundsHelper(gz::math::AxisAlignedBox &_box,
 void Ogre2Visual::Init()
 {
   BaseVisual::Init();
-  this->geometries = Ogre2GeometryStorePtr(new Ogre2GeometryStore);
+  this->geometries = std::make_shared<Ogre2GeometryStore>();
 }
 
 //////////////////////////////////////////////////
@@ -115,6 +115,8 @@ namespace Ogre
         Vector4 mSolidColor[2];
         /// See GORM_SOLID_COLOR and GORM_SOLID_THERMAL_COLOR_TEXTURED
         bool mSolidColorSet[2];
+        /// See setFrustumCulling
+        bool mFrustumCulling;
         // GZ CUSTOMIZE END
 
         /// Converts value from Y-up to whatever the user up vector is (see m_zUp)
@@ -212,6 +214,17 @@ namespace Ogre
         /// Marks all SetSolidColor as unset so that SolidColor throws
         /// if used again without setting.
         void UnsetSolidColors();
+
+        /// \brief Whether update() skips the cells outside the camera
+        /// frustum. Disable it to update once for cameras sharing the same
+        /// position but looking in different directions, e.g. the faces of
+        /// a cube map.
+        /// \param[in] _enabled True to cull cells, the default
+        void setFrustumCulling(bool _enabled) { mFrustumCulling = _enabled; }
+
+        /// \brief See setFrustumCulling
+        /// \return True if update() culls cells outside the camera frustum
+        bool getFrustumCulling() const { return mFrustumCulling; }
         // GZ CUSTOMIZE END
 
         /** Must be called every frame so we can check the camera's position
@@ -101,6 +101,7 @@ namespace Ogre
         mSolidColor[i] = Vector4::ZERO;
         mSolidColorSet[i] = false;
       }
+      mFrustumCulling = true;
       // GZ CUSTOMIZE END
     }
     //-----------------------------------------------------------------------------------
@@ -460,6 +461,11 @@ namespace Ogre
 
 //        return true;
 
+        // GZ CUSTOMIZE BEGIN
+        if( !mFrustumCulling )
+            return true;
+        // GZ CUSTOMIZE END
+
         const Vector2 cellPos = gridToWorld( gPos );
         const Vector2 cellSize( (gSize.x + 1u) * m_xzRelativeSize.x,
                                 (gSize.z + 1u) * m_xzRelativeSize.y );
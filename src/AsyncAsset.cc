@@ -0,0 +1,545 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gz/common/ColladaLoader.hh>
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Mesh.hh>
+#include <gz/common/MeshManager.hh>
+#include <gz/common/OBJLoader.hh>
+#include <gz/common/STLLoader.hh>
+#include <gz/common/StringUtils.hh>
+#include <gz/common/Util.hh>
+
+#include "gz/rendering/AsyncAsset.hh"
+
+/// \brief Private data for the AsyncAsset class
+class gz::rendering::AsyncAssetPrivate
+{
+  /// \brief Kind of asset
+  public: AsyncAssetType type = AsyncAssetType::MESH;
+
+  /// \brief Mesh or image file name
+  public: std::string name;
+
+  /// \brief Resolved path of the file decoded by the workers
+  public: std::string path;
+
+  /// \brief Loading state, read from any thread
+  public: std::atomic<AsyncAssetState> state{AsyncAssetState::PENDING};
+
+  /// \brief Descriptor of a mesh asset
+  public: MeshDescriptor desc;
+
+  /// \brief Mesh decoded by a worker, owned until it is registered with
+  /// the mesh manager
+  public: common::Mesh *decodedMesh = nullptr;
+
+  /// \brief Mesh created on the render thread
+  public: MeshPtr mesh;
+
+  /// \brief Decoded image
+  public: std::shared_ptr<common::Image> image;
+};
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+/// \brief Assets of a loader that are decoded and wait for their upload.
+/// Workers hold it while they decode, so it may outlive its loader.
+class AsyncAssetQueue
+{
+  /// \brief Decoded assets waiting for their upload
+  public: std::deque<AsyncAssetPtr> decoded;
+
+  /// \brief Number of assets of the loader queued or being decoded
+  public: unsigned int inFlight = 0u;
+
+  /// \brief True once the loader is destroyed. Assets decoded afterwards
+  /// are failed.
+  public: bool closed = false;
+
+  /// \brief Protects the queue
+  public: std::mutex mutex;
+
+  /// \brief Signals the render thread that an asset was decoded
+  public: std::condition_variable doneCondition;
+};
+
+/// \brief Asset waiting for a worker
+class AsyncAssetJob
+{
+  /// \brief Asset to decode
+  public: AsyncAssetPtr asset;
+
+  /// \brief Queue of the loader of the asset
+  public: std::shared_ptr<AsyncAssetQueue> queue;
+};
+
+/// \brief Worker threads shared by the loaders of all scenes, so each
+/// scene does not start its own pool. Started with the first loader and
+/// stopped with the last one.
+class AsyncAssetWorkers
+{
+  /// \brief Constructor. Starts one less worker than the number of
+  /// hardware threads.
+  public: AsyncAssetWorkers();
+
+  /// \brief Destructor. Stops the workers.
+  public: ~AsyncAssetWorkers();
+
+  /// \brief Get the workers, starting them if no loader uses them
+  /// \return The workers
+  public: static std::shared_ptr<AsyncAssetWorkers> Instance();
+
+  /// \brief Queue an asset for decoding
+  /// \param[in] _job Asset and queue of its loader
+  public: void Push(AsyncAssetJob _job);
+
+  /// \brief Fail the assets of a loader that wait for a worker
+  /// \param[in] _queue Queue of the loader
+  public: void Cancel(const std::shared_ptr<AsyncAssetQueue> &_queue);
+
+  /// \brief Main loop of the worker threads
+  private: void Work();
+
+  /// \brief Worker threads
+  private: std::vector<std::thread> threads;
+
+  /// \brief Assets waiting for a worker
+  private: std::deque<AsyncAssetJob> jobs;
+
+  /// \brief True when the workers must exit
+  private: bool stop = false;
+
+  /// \brief Protects the jobs
+  private: std::mutex mutex;
+
+  /// \brief Signals the workers that a job was queued
+  private: std::condition_variable jobCondition;
+};
+}
+
+/// \brief Private data for the AsyncAssetLoader class
+class gz::rendering::AsyncAssetLoaderPrivate
+{
+  /// \brief Decode the file of an asset on a worker thread
+  /// \param[in] _asset Asset to decode
+  /// \return True if the asset was decoded
+  public: static bool Decode(AsyncAsset &_asset);
+
+  /// \brief Queue an asset that needs no decoding for its upload
+  /// \param[in] _asset Asset to queue
+  public: void Queue(const AsyncAssetPtr &_asset);
+
+  /// \brief Queue an asset for decoding
+  /// \param[in] _asset Asset to decode
+  public: void Push(const AsyncAssetPtr &_asset);
+
+  /// \brief Decoded assets waiting for their upload
+  public: std::shared_ptr<AsyncAssetQueue> queue =
+      std::make_shared<AsyncAssetQueue>();
+
+  /// \brief Shared worker threads
+  public: std::shared_ptr<AsyncAssetWorkers> workers =
+      AsyncAssetWorkers::Instance();
+};
+
+//////////////////////////////////////////////////
+AsyncAsset::AsyncAsset(AsyncAssetType _type, const std::string &_name)
+  : dataPtr(std::make_unique<AsyncAssetPrivate>())
+{
+  this->dataPtr->type = _type;
+  this->dataPtr->name = _name;
+}
+
+//////////////////////////////////////////////////
+AsyncAsset::~AsyncAsset()
+{
+  delete this->dataPtr->decodedMesh;
+}
+
+//////////////////////////////////////////////////
+AsyncAssetType AsyncAsset::Type() const
+{
+  return this->dataPtr->type;
+}
+
+//////////////////////////////////////////////////
+std::string AsyncAsset::Name() const
+{
+  return this->dataPtr->name;
+}
+
+//////////////////////////////////////////////////
+AsyncAssetState AsyncAsset::State() const
+{
+  return this->dataPtr->state.load();
+}
+
+//////////////////////////////////////////////////
+MeshPtr AsyncAsset::Mesh() const
+{
+  if (this->State() != AsyncAssetState::READY)
+    return MeshPtr();
+  return this->dataPtr->mesh;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const common::Image> AsyncAsset::Image() const
+{
+  if (this->State() != AsyncAssetState::READY)
+    return nullptr;
+  return this->dataPtr->image;
+}
+
+//////////////////////////////////////////////////
+MeshDescriptor &AsyncAsset::Descriptor()
+{
+  return this->dataPtr->desc;
+}
+
+//////////////////////////////////////////////////
+common::Mesh *AsyncAsset::TakeDecodedMesh()
+{
+  common::Mesh *mesh = this->dataPtr->decodedMesh;
+  this->dataPtr->decodedMesh = nullptr;
+  return mesh;
+}
+
+//////////////////////////////////////////////////
+void AsyncAsset::SetReady(MeshPtr _mesh)
+{
+  this->dataPtr->mesh = _mesh;
+  this->dataPtr->state = AsyncAssetState::READY;
+}
+
+//////////////////////////////////////////////////
+void AsyncAsset::SetFailed()
+{
+  this->dataPtr->mesh.reset();
+  this->dataPtr->image.reset();
+  this->dataPtr->state = AsyncAssetState::FAILED;
+}
+
+//////////////////////////////////////////////////
+AsyncAssetLoader::AsyncAssetLoader()
+  : dataPtr(std::make_unique<AsyncAssetLoaderPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+AsyncAssetLoader::~AsyncAssetLoader()
+{
+  this->dataPtr->workers->Cancel(this->dataPtr->queue);
+
+  // assets being decoded are failed by their worker
+  std::lock_guard<std::mutex> lock(this->dataPtr->queue->mutex);
+  this->dataPtr->queue->closed = true;
+  for (auto &asset : this->dataPtr->queue->decoded)
+    asset->SetFailed();
+  this->dataPtr->queue->decoded.clear();
+}
+
+//////////////////////////////////////////////////
+AsyncAssetPtr AsyncAssetLoader::LoadMesh(const MeshDescriptor &_desc)
+{
+  auto asset = std::make_shared<AsyncAsset>(AsyncAssetType::MESH,
+      _desc.meshName);
+  asset->dataPtr->desc = _desc;
+
+  // meshes given as data or already known by the mesh manager only need
+  // their upload
+  if (_desc.mesh || common::MeshManager::Instance()->HasMesh(_desc.meshName))
+  {
+    this->dataPtr->Queue(asset);
+    return asset;
+  }
+
+  std::string path = _desc.meshName;
+  if (!common::exists(path))
+    path = common::findFile(path);
+  if (path.empty())
+  {
+    gzerr << "Unable to find mesh file [" << _desc.meshName << "]"
+          << std::endl;
+    asset->SetFailed();
+    return asset;
+  }
+  asset->dataPtr->path = path;
+
+  // other formats are loaded by the mesh manager on the render thread
+  const std::string extension = common::lowercase(
+      path.substr(path.find_last_of('.') + 1u));
+  if (extension != "dae" && extension != "obj" && extension != "stl")
+  {
+    this->dataPtr->Queue(asset);
+    return asset;
+  }
+
+  this->dataPtr->Push(asset);
+  return asset;
+}
+
+//////////////////////////////////////////////////
+AsyncAssetPtr AsyncAssetLoader::LoadTexture(const std::string &_texture)
+{
+  auto asset = std::make_shared<AsyncAsset>(AsyncAssetType::TEXTURE,
+      _texture);
+
+  std::string path = _texture;
+  if (!common::exists(path))
+    path = common::findFile(path);
+  if (path.empty())
+  {
+    gzerr << "Unable to find texture file [" << _texture << "]"
+          << std::endl;
+    asset->SetFailed();
+    return asset;
+  }
+  asset->dataPtr->path = path;
+
+  // images are created here so the image library is initialized on this
+  // thread before workers decode
+  asset->dataPtr->image = std::make_shared<common::Image>();
+
+  this->dataPtr->Push(asset);
+  return asset;
+}
+
+//////////////////////////////////////////////////
+AsyncAssetPtr AsyncAssetLoader::NextDecoded()
+{
+  AsyncAssetQueue &queue = *this->dataPtr->queue;
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.decoded.empty())
+    return AsyncAssetPtr();
+
+  AsyncAssetPtr asset = queue.decoded.front();
+  queue.decoded.pop_front();
+  return asset;
+}
+
+//////////////////////////////////////////////////
+AsyncAssetPtr AsyncAssetLoader::WaitForDecoded(
+    const std::vector<AsyncAssetPtr> &_assets)
+{
+  AsyncAssetQueue &queue = *this->dataPtr->queue;
+  std::unique_lock<std::mutex> lock(queue.mutex);
+  auto found = queue.decoded.end();
+  queue.doneCondition.wait(lock, [&]
+  {
+    found = std::find_first_of(queue.decoded.begin(), queue.decoded.end(),
+        _assets.begin(), _assets.end());
+    return found != queue.decoded.end() || queue.inFlight == 0u;
+  });
+  if (found == queue.decoded.end())
+    return AsyncAssetPtr();
+
+  AsyncAssetPtr asset = *found;
+  queue.decoded.erase(found);
+  return asset;
+}
+
+//////////////////////////////////////////////////
+void AsyncAssetLoaderPrivate::Queue(const AsyncAssetPtr &_asset)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->queue->mutex);
+    this->queue->decoded.push_back(_asset);
+  }
+  this->queue->doneCondition.notify_all();
+}
+
+//////////////////////////////////////////////////
+void AsyncAssetLoaderPrivate::Push(const AsyncAssetPtr &_asset)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->queue->mutex);
+    ++this->queue->inFlight;
+  }
+  this->workers->Push({_asset, this->queue});
+}
+
+//////////////////////////////////////////////////
+AsyncAssetWorkers::AsyncAssetWorkers()
+{
+  const unsigned int threadCount =
+      std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+  for (unsigned int i = 0u; i < threadCount; ++i)
+    this->threads.emplace_back(&AsyncAssetWorkers::Work, this);
+}
+
+//////////////////////////////////////////////////
+AsyncAssetWorkers::~AsyncAssetWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stop = true;
+  }
+  this->jobCondition.notify_all();
+  for (auto &thread : this->threads)
+    thread.join();
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<AsyncAssetWorkers> AsyncAssetWorkers::Instance()
+{
+  static std::mutex instanceMutex;
+  static std::weak_ptr<AsyncAssetWorkers> instance;
+
+  std::lock_guard<std::mutex> lock(instanceMutex);
+  std::shared_ptr<AsyncAssetWorkers> workers = instance.lock();
+  if (!workers)
+  {
+    workers = std::make_shared<AsyncAssetWorkers>();
+    instance = workers;
+  }
+  return workers;
+}
+
+//////////////////////////////////////////////////
+void AsyncAssetWorkers::Push(AsyncAssetJob _job)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->jobs.push_back(std::move(_job));
+  }
+  this->jobCondition.notify_one();
+}
+
+//////////////////////////////////////////////////
+void AsyncAssetWorkers::Cancel(const std::shared_ptr<AsyncAssetQueue> &_queue)
+{
+  std::vector<AsyncAssetPtr> cancelled;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto it = this->jobs.begin();
+    while (it != this->jobs.end())
+    {
+      if (it->queue == _queue)
+      {
+        cancelled.push_back(it->asset);
+        it = this->jobs.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+  if (cancelled.empty())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(_queue->mutex);
+    for (auto &asset : cancelled)
+      asset->SetFailed();
+    _queue->inFlight -= static_cast<unsigned int>(cancelled.size());
+  }
+  _queue->doneCondition.notify_all();
+}
+
+//////////////////////////////////////////////////
+void AsyncAssetWorkers::Work()
+{
+  while (true)
+  {
+    AsyncAssetJob job;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->jobCondition.wait(lock, [this]
+      {
+        return this->stop || !this->jobs.empty();
+      });
+      if (this->stop)
+        return;
+      job = std::move(this->jobs.front());
+      this->jobs.pop_front();
+    }
+
+    const bool decodedOk = AsyncAssetLoaderPrivate::Decode(*job.asset);
+    {
+      std::lock_guard<std::mutex> lock(job.queue->mutex);
+      if (decodedOk && !job.queue->closed)
+        job.queue->decoded.push_back(job.asset);
+      else
+        job.asset->SetFailed();
+      --job.queue->inFlight;
+    }
+    job.queue->doneCondition.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////
+bool AsyncAssetLoaderPrivate::Decode(AsyncAsset &_asset)
+{
+  AsyncAssetPrivate &asset = *_asset.dataPtr;
+  if (asset.type == AsyncAssetType::TEXTURE)
+  {
+    asset.image->Load(asset.path);
+    if (!asset.image->Valid())
+    {
+      gzerr << "Unable to decode texture [" << asset.name << "]"
+            << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  const std::string extension = common::lowercase(
+      asset.path.substr(asset.path.find_last_of('.') + 1u));
+  common::Mesh *mesh = nullptr;
+  if (extension == "dae")
+  {
+    common::ColladaLoader loader;
+    mesh = loader.Load(asset.path);
+  }
+  else if (extension == "obj")
+  {
+    common::OBJLoader loader;
+    mesh = loader.Load(asset.path);
+  }
+  else
+  {
+    common::STLLoader loader;
+    mesh = loader.Load(asset.path);
+  }
+
+  if (!mesh)
+  {
+    gzerr << "Unable to decode mesh [" << asset.name << "]" << std::endl;
+    return false;
+  }
+
+  // the mesh manager knows meshes by the name they were requested with
+  mesh->SetName(asset.name);
+  asset.decodedMesh = mesh;
+  return true;
+}
@@ -65,6 +65,12 @@ class gz::rendering::HeightmapDescriptorPrivate
   /// \brief Number of samples per heightmap datum.
   public: unsigned int sampling{1u};
 
+  /// \brief Number of samples along each side of a tile, 0 if not tiled.
+  public: unsigned int tileSize{0u};
+
+  /// \brief Distance from a camera within which tiles are loaded.
+  public: double tileLoadDistance{1000.0};
+
   /// \brief Textures in this heightmap, in height order.
   public: std::vector<HeightmapTexture> textures;
 
@@ -313,6 +319,30 @@ void HeightmapDescriptor::SetSampling(unsigned int _sampling)
   this->dataPtr->sampling = _sampling;
 }
 
+//////////////////////////////////////////////////
+unsigned int HeightmapDescriptor::TileSize() const
+{
+  return this->dataPtr->tileSize;
+}
+
+//////////////////////////////////////////////////
+void HeightmapDescriptor::SetTileSize(unsigned int _size)
+{
+  this->dataPtr->tileSize = _size;
+}
+
+//////////////////////////////////////////////////
+double HeightmapDescriptor::TileLoadDistance() const
+{
+  return this->dataPtr->tileLoadDistance;
+}
+
+//////////////////////////////////////////////////
+void HeightmapDescriptor::SetTileLoadDistance(double _distance)
+{
+  this->dataPtr->tileLoadDistance = _distance;
+}
+
 /////////////////////////////////////////////////
 uint64_t HeightmapDescriptor::TextureCount() const
 {
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <gz/common/Console.hh>
+
+#include "gz/rendering/StartupTimeline.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+/// \brief Escape a string for use in a JSON string literal
+/// \param[in] _str String to escape
+/// \return Escaped string
+std::string JsonEscape(const std::string &_str)
+{
+  std::ostringstream out;
+  for (char c : _str)
+  {
+    switch (c)
+    {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      case '\n':
+        out << "\\n";
+        break;
+      case '\t':
+        out << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20u)
+          out << ' ';
+        else
+          out << c;
+    }
+  }
+  return out.str();
+}
+
+/// \brief Convert a duration to whole microseconds, the unit of Chrome
+/// trace timestamps
+/// \param[in] _duration Duration to convert
+/// \return Microseconds
+int64_t Micros(std::chrono::steady_clock::duration _duration)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      _duration).count();
+}
+}
+
+//////////////////////////////////////////////////
+std::chrono::steady_clock::duration StartupTimeline::Total() const
+{
+  if (this->phases.empty())
+    return std::chrono::steady_clock::duration::zero();
+
+  auto begin = this->phases.front().start;
+  auto end = begin;
+  for (const auto &phase : this->phases)
+  {
+    begin = std::min(begin, phase.start);
+    end = std::max(end, phase.start + phase.duration);
+  }
+  return end - begin;
+}
+
+//////////////////////////////////////////////////
+std::string StartupTimeline::ChromeTrace(
+    const std::string &_processName) const
+{
+  std::ostringstream out;
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,"
+      << "\"args\":{\"name\":\"" << JsonEscape(_processName) << "\"}}";
+
+  // complete events, nested phases show up below their parent
+  for (const auto &phase : this->phases)
+  {
+    out << ",{\"name\":\"" << JsonEscape(phase.name) << "\","
+        << "\"cat\":\"startup\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+        << "\"ts\":" << Micros(phase.start) << ","
+        << "\"dur\":" << Micros(phase.duration) << ","
+        << "\"args\":{\"resources\":" << phase.resourceCount << ","
+        << "\"shaders\":" << phase.shaderCount << "}}";
+  }
+  out << "]}";
+  return out.str();
+}
+
+//////////////////////////////////////////////////
+bool StartupTimeline::WriteChromeTrace(const std::string &_path) const
+{
+  std::ofstream file(_path, std::ios::trunc);
+  if (!file)
+  {
+    gzerr << "Unable to open startup trace file [" << _path << "]"
+          << std::endl;
+    return false;
+  }
+  file << this->ChromeTrace() << std::endl;
+  return static_cast<bool>(file);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include "gz/rendering/StartupTimeline.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/////////////////////////////////////////////////
+TEST(StartupTimeline, Total)
+{
+  StartupTimeline timeline;
+  EXPECT_EQ(std::chrono::steady_clock::duration::zero(), timeline.Total());
+
+  StartupPhase load;
+  load.name = "Load";
+  load.start = std::chrono::milliseconds(0);
+  load.duration = std::chrono::milliseconds(30);
+  timeline.phases.push_back(load);
+
+  // nested in Load
+  StartupPhase plugins;
+  plugins.name = "LoadPlugins";
+  plugins.start = std::chrono::milliseconds(5);
+  plugins.duration = std::chrono::milliseconds(10);
+  timeline.phases.push_back(plugins);
+
+  StartupPhase init;
+  init.name = "Init";
+  init.start = std::chrono::milliseconds(40);
+  init.duration = std::chrono::milliseconds(20);
+  timeline.phases.push_back(init);
+
+  EXPECT_EQ(std::chrono::milliseconds(60), timeline.Total());
+}
+
+/////////////////////////////////////////////////
+TEST(StartupTimeline, ChromeTrace)
+{
+  StartupTimeline timeline;
+  StartupPhase phase;
+  phase.name = "Create \"Resources\"";
+  phase.start = std::chrono::microseconds(1500);
+  phase.duration = std::chrono::microseconds(250);
+  phase.resourceCount = 12u;
+  phase.shaderCount = 3u;
+  timeline.phases.push_back(phase);
+
+  const std::string trace = timeline.ChromeTrace("test");
+  EXPECT_EQ(0u, trace.find("{\"displayTimeUnit\":\"ms\""));
+  EXPECT_NE(std::string::npos, trace.find("\"name\":\"test\""));
+  EXPECT_NE(std::string::npos,
+      trace.find("\"name\":\"Create \\\"Resources\\\"\""));
+  EXPECT_NE(std::string::npos, trace.find("\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, trace.find("\"ts\":1500,\"dur\":250"));
+  EXPECT_NE(std::string::npos,
+      trace.find("\"args\":{\"resources\":12,\"shaders\":3}"));
+  EXPECT_EQ('}', trace.back());
+
+  EXPECT_FALSE(timeline.WriteChromeTrace(""));
+}
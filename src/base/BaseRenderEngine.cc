@@ -15,6 +15,9 @@
  *
  */
 
+#include <algorithm>
+#include <cstdlib>
+
 #include <gz/common/Console.hh>
 
 #include "gz/rendering/RenderPassSystem.hh"
@@ -43,7 +46,27 @@ bool BaseRenderEngine::Load(const std::map<std::string, std::string> &_params)
     return true;
   }
 
+  this->startupTimeline = StartupTimeline();
+  this->startupBegin = std::chrono::steady_clock::now();
+
+  auto it = _params.find("startupTracePath");
+  if (it != _params.end())
+  {
+    this->startupTracePath = it->second;
+  }
+  else
+  {
+    const char *env = std::getenv("GZ_RENDERING_STARTUP_TRACE");
+    if (env)
+      this->startupTracePath = env;
+  }
+
   this->loaded = this->LoadImpl(_params);
+  this->RecordStartupPhase("Load", this->startupBegin);
+
+  // write what was recorded so far, as a failed load is never initialized
+  if (!this->loaded && !this->startupTracePath.empty())
+    this->startupTimeline.WriteChromeTrace(this->startupTracePath);
   return this->loaded;
 }
 
@@ -62,7 +85,12 @@ bool BaseRenderEngine::Init()
     return true;
   }
 
+  const auto start = std::chrono::steady_clock::now();
   this->initialized = this->InitImpl();
+  this->RecordStartupPhase("Init", start);
+
+  if (!this->startupTracePath.empty())
+    this->startupTimeline.WriteChromeTrace(this->startupTracePath);
   return this->initialized;
 }
 
@@ -247,6 +275,34 @@ void BaseRenderEngine::AddResourcePath(const std::string &_path)
   this->resourcePaths.push_back(_path);
 }
 
+//////////////////////////////////////////////////
+const StartupTimeline &BaseRenderEngine::StartupTimings() const
+{
+  return this->startupTimeline;
+}
+
+//////////////////////////////////////////////////
+void BaseRenderEngine::RecordStartupPhase(const std::string &_name,
+    std::chrono::steady_clock::time_point _start, uint64_t _resourceCount,
+    uint64_t _shaderCount)
+{
+  StartupPhase phase;
+  phase.name = _name;
+  phase.start = _start - this->startupBegin;
+  phase.duration = std::chrono::steady_clock::now() - _start;
+  phase.resourceCount = _resourceCount;
+  phase.shaderCount = _shaderCount;
+
+  // enclosing phases end last but are listed before the phases they contain
+  auto &phases = this->startupTimeline.phases;
+  auto pos = std::lower_bound(phases.begin(), phases.end(), phase,
+      [](const StartupPhase &_a, const StartupPhase &_b)
+      {
+        return _a.start < _b.start;
+      });
+  phases.insert(pos, phase);
+}
+
 //////////////////////////////////////////////////
 void BaseRenderEngine::SetHeadless(bool _headless)
 {
@@ -15,7 +15,12 @@
  *
  */
 
+#include <array>
+#include <map>
+#include <set>
 #include <sstream>
+#include <variant>
+#include <vector>
 
 #include <gz/math/Helpers.hh>
 
@@ -90,6 +95,11 @@ void BaseScene::Init()
 
   if (!this->initialized)
   {
+    // attributes read by the built-in material switchers
+    this->InternAttribute("temperature", NodeAttributeType::FLOAT);
+    this->InternAttribute("laser_retro", NodeAttributeType::FLOAT);
+    this->InternAttribute("label", NodeAttributeType::INT);
+
     this->initialized = this->InitImpl();
     this->CreateNodeStore();
     this->CreateMaterials();
@@ -934,6 +944,108 @@ VisualPtr BaseScene::CreateVisual(unsigned int _id, const std::string &_name)
   return (result) ? visual : nullptr;
 }
 
+//////////////////////////////////////////////////
+std::vector<VisualPtr> BaseScene::CreateVisuals(
+    const std::vector<VisualDescriptor> &_batch, VisualPtr _parent)
+{
+  // validate the whole batch before creating anything
+  std::set<std::string> batchNames;
+  for (size_t i = 0; i < _batch.size(); ++i)
+  {
+    const VisualDescriptor &desc = _batch[i];
+    if (desc.parentIndex >= static_cast<int>(i))
+    {
+      gzerr << "Invalid parent index [" << desc.parentIndex
+            << "] in visual descriptor [" << i << "]. Parents must appear "
+            << "before their children in the batch" << std::endl;
+      return {};
+    }
+
+    if (desc.name.empty())
+      continue;
+
+    if (!batchNames.insert(desc.name).second ||
+        this->HasVisualName(desc.name))
+    {
+      gzerr << "Another visual already exists with name: " << desc.name
+            << std::endl;
+      return {};
+    }
+  }
+
+  // create all visuals, then register them in a single pass
+  std::vector<VisualPtr> visuals(_batch.size());
+  for (size_t i = 0; i < _batch.size(); ++i)
+  {
+    unsigned int objId = this->CreateObjectId();
+    std::string objName = _batch[i].name.empty() ?
+        this->CreateObjectName(objId, "Visual") : _batch[i].name;
+    visuals[i] = this->CreateVisualImpl(objId, objName);
+  }
+
+  for (auto &visual : visuals)
+  {
+    if (visual && !this->RegisterVisual(visual))
+    {
+      visual->Destroy();
+      visual.reset();
+    }
+  }
+
+  // resolve each distinct mesh only once
+  std::map<std::string, MeshDescriptor> meshes;
+
+  for (size_t i = 0; i < _batch.size(); ++i)
+  {
+    const VisualDescriptor &desc = _batch[i];
+    VisualPtr visual = visuals[i];
+    if (!visual)
+    {
+      gzerr << "Failed to create visual for descriptor [" << i << "]"
+            << std::endl;
+      continue;
+    }
+
+    if (desc.mesh.mesh || !desc.mesh.meshName.empty())
+    {
+      std::string meshKey = ((desc.mesh.mesh) ?
+          desc.mesh.mesh->Name() : desc.mesh.meshName) + "::" +
+          desc.mesh.subMeshName + "::" +
+          ((desc.mesh.centerSubMesh) ? "CENTERED" : "ORIGINAL");
+
+      auto meshIt = meshes.find(meshKey);
+      if (meshIt == meshes.end())
+      {
+        MeshDescriptor meshDesc = desc.mesh;
+        meshDesc.Load();
+        meshIt = meshes.emplace(meshKey, meshDesc).first;
+      }
+
+      MeshPtr mesh = this->CreateMesh(meshIt->second);
+      if (mesh)
+        visual->AddGeometry(mesh);
+      else
+        gzerr << "Failed to create mesh for descriptor [" << i << "]"
+              << std::endl;
+    }
+
+    if (desc.material)
+      visual->SetMaterial(desc.material, false);
+
+    visual->SetLocalPose(desc.localPose);
+    visual->SetLocalScale(desc.localScale);
+    if (!desc.visible)
+      visual->SetVisible(false);
+
+    VisualPtr parent = (desc.parentIndex < 0) ?
+        _parent : visuals[desc.parentIndex];
+    if (parent)
+      parent->AddChild(visual);
+  }
+
+  return visuals;
+}
+
 //////////////////////////////////////////////////
 ArrowVisualPtr BaseScene::CreateArrowVisual()
 {
@@ -1294,6 +1406,19 @@ FrustumVisualPtr BaseScene::CreateFrustumVisual(unsigned int _id,
   return (result) ? frustum : nullptr;
 }
 
+//////////////////////////////////////////////////
+InstancedVisualPtr BaseScene::CreateInstancedVisual(
+    const MeshDescriptor &_desc, MaterialPtr _material,
+    unsigned int _capacity)
+{
+  unsigned int objId = this->CreateObjectId();
+  std::string objName = this->CreateObjectName(objId, "InstancedVisual");
+  InstancedVisualPtr visual = this->CreateInstancedVisualImpl(objId, objName,
+      _desc, _material, _capacity);
+  bool result = this->RegisterVisual(visual);
+  return (result) ? visual : nullptr;
+}
+
 //////////////////////////////////////////////////
 WireBoxPtr BaseScene::CreateWireBox()
 {
@@ -1452,6 +1577,9 @@ bool BaseScene::SkyEnabled() const
 //////////////////////////////////////////////////
 void BaseScene::PreRender()
 {
+  if (this->assetLoader)
+    this->UploadAssets(this->assetUploadBudget);
+
   this->RootVisual()->PreRender();
 }
 
@@ -1477,6 +1605,438 @@ bool BaseScene::LegacyAutoGpuFlush() const
   return true;
 }
 
+//////////////////////////////////////////////////
+void BaseScene::SetObjectPoolingEnabled(bool /*_enabled*/)
+{
+}
+
+//////////////////////////////////////////////////
+bool BaseScene::ObjectPoolingEnabled() const
+{
+  return false;
+}
+
+//////////////////////////////////////////////////
+void BaseScene::SetMeshLodEnabled(bool /*_enabled*/)
+{
+}
+
+//////////////////////////////////////////////////
+bool BaseScene::MeshLodEnabled() const
+{
+  return false;
+}
+
+//////////////////////////////////////////////////
+void BaseScene::SetMeshQuantizationEnabled(bool /*_enabled*/)
+{
+}
+
+//////////////////////////////////////////////////
+bool BaseScene::MeshQuantizationEnabled() const
+{
+  return false;
+}
+
+//////////////////////////////////////////////////
+unsigned int BaseScene::BuildStaticBatches(double /*_cellSize*/)
+{
+  return 0u;
+}
+
+//////////////////////////////////////////////////
+void BaseScene::ClearStaticBatches()
+{
+}
+
+//////////////////////////////////////////////////
+unsigned int BaseScene::StaticBatchCount() const
+{
+  return 0u;
+}
+
+//////////////////////////////////////////////////
+AsyncAssetPtr BaseScene::LoadMeshAsync(const MeshDescriptor &_desc)
+{
+  if (!this->assetLoader)
+    this->assetLoader = std::make_unique<AsyncAssetLoader>();
+  return this->assetLoader->LoadMesh(_desc);
+}
+
+//////////////////////////////////////////////////
+AsyncAssetPtr BaseScene::LoadTextureAsync(const std::string &_texture)
+{
+  if (!this->assetLoader)
+    this->assetLoader = std::make_unique<AsyncAssetLoader>();
+  return this->assetLoader->LoadTexture(_texture);
+}
+
+//////////////////////////////////////////////////
+bool BaseScene::WaitForAssets(const std::vector<AsyncAssetPtr> &_assets)
+{
+  auto pending = [&_assets]()
+  {
+    for (const auto &asset : _assets)
+    {
+      if (asset && asset->State() == AsyncAssetState::PENDING)
+        return true;
+    }
+    return false;
+  };
+
+  // only the given assets are uploaded, the others are left to the budgeted
+  // uploads of PreRender
+  while (this->assetLoader && pending())
+  {
+    AsyncAssetPtr asset = this->assetLoader->WaitForDecoded(_assets);
+
+    // nothing left to decode, the assets belong to another scene
+    if (!asset)
+    {
+      gzerr << "Waiting for assets that are not loaded by scene ["
+            << this->Name() << "]" << std::endl;
+      break;
+    }
+    this->UploadAsset(asset);
+  }
+
+  for (const auto &asset : _assets)
+  {
+    if (!asset || asset->State() != AsyncAssetState::READY)
+      return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void BaseScene::SetAssetUploadBudget(
+    std::chrono::steady_clock::duration _budget)
+{
+  this->assetUploadBudget = _budget;
+}
+
+//////////////////////////////////////////////////
+std::chrono::steady_clock::duration BaseScene::AssetUploadBudget() const
+{
+  return this->assetUploadBudget;
+}
+
+//////////////////////////////////////////////////
+unsigned int BaseScene::WarmUp(const WarmUpOptions &_options)
+{
+  std::vector<CameraPtr> cameras;
+  for (unsigned int i = 0u; i < this->SensorCount(); ++i)
+  {
+    CameraPtr camera =
+        std::dynamic_pointer_cast<Camera>(this->SensorByIndex(i));
+    if (camera)
+      cameras.push_back(camera);
+  }
+  if (cameras.empty())
+    return 0u;
+
+  // camera frame is x forward, so these look along +x, -x, +y, -y, +z, -z
+  const std::array<math::Quaterniond, 6> directions = {
+      math::Quaterniond(0, 0, 0),
+      math::Quaterniond(0, 0, GZ_PI),
+      math::Quaterniond(0, 0, GZ_PI * 0.5),
+      math::Quaterniond(0, 0, -GZ_PI * 0.5),
+      math::Quaterniond(0, -GZ_PI * 0.5, 0),
+      math::Quaterniond(0, GZ_PI * 0.5, 0)};
+
+  // cameras are rendered without PostRender so their images are not
+  // copied and no new frame events are emitted
+  this->PreRender();
+  for (auto &camera : cameras)
+  {
+    camera->PreRender();
+    camera->Render();
+
+    if (!_options.allDirections)
+      continue;
+
+    const math::Quaterniond rotation = camera->LocalRotation();
+    for (const auto &direction : directions)
+    {
+      camera->SetWorldRotation(direction);
+      camera->Render();
+    }
+    camera->SetLocalRotation(rotation);
+  }
+  if (!this->LegacyAutoGpuFlush())
+    this->PostRender();
+
+  return static_cast<unsigned int>(cameras.size());
+}
+
+//////////////////////////////////////////////////
+void BaseScene::UploadAssets(std::chrono::steady_clock::duration _budget)
+{
+  const auto start = std::chrono::steady_clock::now();
+  while (AsyncAssetPtr asset = this->assetLoader->NextDecoded())
+  {
+    this->UploadAsset(asset);
+    if (std::chrono::steady_clock::now() - start >= _budget)
+      break;
+  }
+}
+
+//////////////////////////////////////////////////
+void BaseScene::UploadAsset(const AsyncAssetPtr &_asset)
+{
+  if (_asset->Type() == AsyncAssetType::TEXTURE)
+  {
+    // the GPU upload happens when the image is set on a material, which
+    // picks the texture format from the map type
+    _asset->SetReady(nullptr);
+    return;
+  }
+
+  MeshDescriptor &desc = _asset->Descriptor();
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  common::Mesh *decoded = _asset->TakeDecodedMesh();
+  if (decoded)
+  {
+    // another request may have registered the same file meanwhile
+    if (meshManager->HasMesh(decoded->Name()))
+      delete decoded;
+    else
+      meshManager->AddMesh(decoded);
+  }
+  else if (!desc.mesh && !meshManager->HasMesh(desc.meshName))
+  {
+    meshManager->Load(desc.meshName);
+  }
+
+  MeshPtr mesh = this->CreateMesh(desc);
+  if (mesh)
+    _asset->SetReady(mesh);
+  else
+    _asset->SetFailed();
+}
+
+//////////////////////////////////////////////////
+void BaseScene::SetChangeJournalEnabled(bool _enabled)
+{
+  this->changeJournalEnabled = _enabled;
+  if (!_enabled)
+  {
+    this->changes.clear();
+    this->pendingChanges.clear();
+  }
+}
+
+//////////////////////////////////////////////////
+bool BaseScene::ChangeJournalEnabled() const
+{
+  return this->changeJournalEnabled;
+}
+
+//////////////////////////////////////////////////
+std::vector<SceneChange> BaseScene::DrainChanges()
+{
+  std::vector<SceneChange> result;
+  result.swap(this->changes);
+  this->pendingChanges.clear();
+  return result;
+}
+
+//////////////////////////////////////////////////
+void BaseScene::RecordChange(const SceneChange &_change)
+{
+  if (!this->changeJournalEnabled)
+    return;
+
+  // coalesce repeated property changes of the same node
+  if (_change.type == SceneChangeType::POSE_CHANGED ||
+      _change.type == SceneChangeType::MATERIAL_CHANGED ||
+      _change.type == SceneChangeType::VISIBILITY_CHANGED)
+  {
+    if (!this->pendingChanges.insert({_change.type, _change.nodeId}).second)
+      return;
+  }
+
+  this->changes.push_back(_change);
+}
+
+//////////////////////////////////////////////////
+unsigned int BaseScene::InternAttribute(const std::string &_key,
+    NodeAttributeType _type)
+{
+  if (_key.empty())
+  {
+    gzerr << "Cannot intern attribute with empty key" << std::endl;
+    return 0u;
+  }
+
+  auto it = this->attributeHandles.find(_key);
+  if (it != this->attributeHandles.end())
+  {
+    if (this->attributes[it->second - 1u].type != _type)
+    {
+      gzerr << "Attribute already interned with a different type: "
+            << _key << std::endl;
+      return 0u;
+    }
+    return it->second;
+  }
+
+  AttributeColumn column;
+  column.type = _type;
+  this->attributes.push_back(column);
+  unsigned int handle = static_cast<unsigned int>(this->attributes.size());
+  this->attributeHandles[_key] = handle;
+
+  // mirror user data that was set before the key was interned
+  VisualStorePtr visualStore = this->Visuals();
+  if (visualStore)
+  {
+    for (unsigned int i = 0; i < visualStore->Size(); ++i)
+    {
+      VisualPtr visual = visualStore->GetByIndex(i);
+      if (visual && visual->HasUserData(_key))
+        this->SetAttribute(handle, visual->Id(), visual->UserData(_key));
+    }
+  }
+
+  return handle;
+}
+
+//////////////////////////////////////////////////
+unsigned int BaseScene::AttributeHandle(const std::string &_key) const
+{
+  auto it = this->attributeHandles.find(_key);
+  return (it != this->attributeHandles.end()) ? it->second : 0u;
+}
+
+//////////////////////////////////////////////////
+bool BaseScene::FloatAttribute(unsigned int _handle, unsigned int _nodeId,
+    float &_value) const
+{
+  if (_handle == 0u || _handle > this->attributes.size())
+    return false;
+
+  const AttributeColumn &column = this->attributes[_handle - 1u];
+  if (column.type != NodeAttributeType::FLOAT)
+    return false;
+
+  auto it = column.slots.find(_nodeId);
+  if (it == column.slots.end())
+    return false;
+
+  _value = column.floatValues[it->second];
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool BaseScene::IntAttribute(unsigned int _handle, unsigned int _nodeId,
+    int &_value) const
+{
+  if (_handle == 0u || _handle > this->attributes.size())
+    return false;
+
+  const AttributeColumn &column = this->attributes[_handle - 1u];
+  if (column.type != NodeAttributeType::INT)
+    return false;
+
+  auto it = column.slots.find(_nodeId);
+  if (it == column.slots.end())
+    return false;
+
+  _value = column.intValues[it->second];
+  return true;
+}
+
+//////////////////////////////////////////////////
+void BaseScene::SetAttribute(unsigned int _handle, unsigned int _nodeId,
+    const Variant &_value)
+{
+  if (_handle == 0u || _handle > this->attributes.size())
+    return;
+
+  AttributeColumn &column = this->attributes[_handle - 1u];
+
+  float floatValue = 0.0f;
+  int intValue = 0;
+  bool valid = true;
+  if (column.type == NodeAttributeType::FLOAT)
+  {
+    if (const float *f = std::get_if<float>(&_value))
+      floatValue = *f;
+    else if (const double *d = std::get_if<double>(&_value))
+      floatValue = static_cast<float>(*d);
+    else if (const int *i = std::get_if<int>(&_value))
+      floatValue = static_cast<float>(*i);
+    else
+      valid = false;
+  }
+  else
+  {
+    if (const int *i = std::get_if<int>(&_value))
+      intValue = *i;
+    else
+      valid = false;
+  }
+
+  if (!valid)
+  {
+    RemoveAttributeValue(column, _nodeId);
+    return;
+  }
+
+  auto it = column.slots.find(_nodeId);
+  if (it == column.slots.end())
+  {
+    it = column.slots.emplace(_nodeId, column.nodeIds.size()).first;
+    column.nodeIds.push_back(_nodeId);
+    if (column.type == NodeAttributeType::FLOAT)
+      column.floatValues.push_back(floatValue);
+    else
+      column.intValues.push_back(intValue);
+    return;
+  }
+
+  if (column.type == NodeAttributeType::FLOAT)
+    column.floatValues[it->second] = floatValue;
+  else
+    column.intValues[it->second] = intValue;
+}
+
+//////////////////////////////////////////////////
+void BaseScene::RemoveAttributes(unsigned int _nodeId)
+{
+  for (auto &column : this->attributes)
+    RemoveAttributeValue(column, _nodeId);
+}
+
+//////////////////////////////////////////////////
+void BaseScene::RemoveAttributeValue(AttributeColumn &_column,
+    unsigned int _nodeId)
+{
+  auto it = _column.slots.find(_nodeId);
+  if (it == _column.slots.end())
+    return;
+
+  // keep values packed by moving the last value into the freed slot
+  std::size_t slot = it->second;
+  std::size_t last = _column.nodeIds.size() - 1u;
+  _column.slots.erase(it);
+  if (slot != last)
+  {
+    _column.nodeIds[slot] = _column.nodeIds[last];
+    _column.slots[_column.nodeIds[slot]] = slot;
+    if (_column.type == NodeAttributeType::FLOAT)
+      _column.floatValues[slot] = _column.floatValues[last];
+    else
+      _column.intValues[slot] = _column.intValues[last];
+  }
+  _column.nodeIds.pop_back();
+  if (_column.type == NodeAttributeType::FLOAT)
+    _column.floatValues.pop_back();
+  else
+    _column.intValues.pop_back();
+}
+
 //////////////////////////////////////////////////
 void BaseScene::Clear()
 {
@@ -1495,7 +2055,17 @@ void BaseScene::Clear()
 void BaseScene::Destroy()
 {
   // TODO(anyone): destroy context
+  this->assetLoader.reset();
   this->Clear();
+  this->changes.clear();
+  this->pendingChanges.clear();
+  for (auto &column : this->attributes)
+  {
+    column.nodeIds.clear();
+    column.floatValues.clear();
+    column.intValues.clear();
+    column.slots.clear();
+  }
   this->loaded = false;
   this->initialized = false;
 }
@@ -1519,19 +2089,31 @@ std::string BaseScene::CreateObjectName(unsigned int _id,
 //////////////////////////////////////////////////
 bool BaseScene::RegisterLight(LightPtr _light)
 {
-  return (_light) ? this->Lights()->Add(_light) : false;
+  if (!_light || !this->Lights()->Add(_light))
+    return false;
+
+  this->RecordChange({SceneChangeType::NODE_CREATED, _light->Id(), 0u});
+  return true;
 }
 
 //////////////////////////////////////////////////
 bool BaseScene::RegisterSensor(SensorPtr _sensor)
 {
-  return (_sensor) ? this->Sensors()->Add(_sensor) : false;
+  if (!_sensor || !this->Sensors()->Add(_sensor))
+    return false;
+
+  this->RecordChange({SceneChangeType::NODE_CREATED, _sensor->Id(), 0u});
+  return true;
 }
 
 //////////////////////////////////////////////////
 bool BaseScene::RegisterVisual(VisualPtr _visual)
 {
-  return (_visual) ? this->Visuals()->Add(_visual) : false;
+  if (!_visual || !this->Visuals()->Add(_visual))
+    return false;
+
+  this->RecordChange({SceneChangeType::NODE_CREATED, _visual->Id(), 0u});
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -300,6 +300,61 @@ TEST_F(CameraTest, VisibilityMask)
   engine->DestroyScene(scene);
 }
 
+/////////////////////////////////////////////////
+TEST_F(CameraTest, LodBias)
+{
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  CameraPtr camera = scene->CreateCamera();
+  EXPECT_TRUE(camera != nullptr);
+
+  // check initial value
+  EXPECT_DOUBLE_EQ(1.0, camera->LodBias());
+
+  // check setting new values
+  camera->SetLodBias(0.25);
+  EXPECT_DOUBLE_EQ(0.25, camera->LodBias());
+
+  // non-positive values are rejected
+  camera->SetLodBias(0.0);
+  EXPECT_DOUBLE_EQ(0.25, camera->LodBias());
+  camera->SetLodBias(-2.0);
+  EXPECT_DOUBLE_EQ(0.25, camera->LodBias());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CameraTest, AllowPlaceholderTextures)
+{
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(64);
+  camera->SetImageHeight(64);
+  scene->RootVisual()->AddChild(camera);
+
+  // cameras wait for pending textures by default
+  EXPECT_FALSE(camera->AllowPlaceholderTextures());
+
+  camera->SetAllowPlaceholderTextures(true);
+  EXPECT_TRUE(camera->AllowPlaceholderTextures());
+
+  // render with and without waiting for textures
+  camera->Update();
+
+  camera->SetAllowPlaceholderTextures(false);
+  EXPECT_FALSE(camera->AllowPlaceholderTextures());
+  camera->Update();
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
 /////////////////////////////////////////////////
 TEST_F(CameraTest, IntrinsicMatrix)
 {
@@ -183,12 +183,16 @@ TEST_F(HeightmapTest, CopyConstructor)
   descriptor.SetPosition({0.5, 0.6, 0.7});
   descriptor.SetUseTerrainPaging(true);
   descriptor.SetSampling(123u);
+  descriptor.SetTileSize(256u);
+  descriptor.SetTileLoadDistance(250.0);
 
   HeightmapDescriptor descriptor2(descriptor);
   EXPECT_EQ(gz::math::Vector3d(0.1, 0.2, 0.3), descriptor2.Size());
   EXPECT_EQ(gz::math::Vector3d(0.5, 0.6, 0.7), descriptor2.Position());
   EXPECT_TRUE(descriptor2.UseTerrainPaging());
   EXPECT_EQ(123u, descriptor2.Sampling());
+  EXPECT_EQ(256u, descriptor2.TileSize());
+  EXPECT_DOUBLE_EQ(250.0, descriptor2.TileLoadDistance());
 
   HeightmapTexture texture;
   texture.SetSize(123.456);
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "CommonRenderingTest.hh"
+
+#include "gz/rendering/Camera.hh"
+#include "gz/rendering/InstancedVisual.hh"
+#include "gz/rendering/Material.hh"
+#include "gz/rendering/MeshDescriptor.hh"
+#include "gz/rendering/Scene.hh"
+
+using namespace gz;
+using namespace rendering;
+
+class InstancedVisualTest : public CommonRenderingTest
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(InstancedVisualTest, InstancedVisual)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  MaterialPtr material = scene->CreateMaterial();
+  material->SetDiffuse(0.5, 0.5, 0.5);
+
+  MeshDescriptor desc("unit_box");
+  InstancedVisualPtr visual =
+      scene->CreateInstancedVisual(desc, material, 100u);
+  ASSERT_NE(nullptr, visual);
+  scene->RootVisual()->AddChild(visual);
+  EXPECT_TRUE(scene->HasVisual(visual));
+
+  // check initial values
+  EXPECT_EQ(100u, visual->Capacity());
+  EXPECT_EQ(math::Pose3d::Zero, visual->InstancePose(0u));
+  EXPECT_EQ(math::Vector3d::One, visual->InstanceScale(0u));
+  EXPECT_TRUE(visual->InstanceVisible(0u));
+  EXPECT_EQ(math::Color::White, visual->InstanceColor(0u));
+
+  // lay out instances on a grid
+  for (unsigned int i = 0u; i < visual->Capacity(); ++i)
+  {
+    visual->SetInstancePose(i,
+        math::Pose3d(i % 10 * 2.0, i / 10 * 2.0, 0, 0, 0, 0));
+  }
+  EXPECT_EQ(math::Pose3d(18, 18, 0, 0, 0, 0), visual->InstancePose(99u));
+
+  visual->SetInstanceScale(1u, math::Vector3d(2, 3, 4));
+  EXPECT_EQ(math::Vector3d(2, 3, 4), visual->InstanceScale(1u));
+
+  visual->SetInstanceVisible(2u, false);
+  EXPECT_FALSE(visual->InstanceVisible(2u));
+
+  visual->SetInstanceColor(3u, math::Color::Red);
+  EXPECT_EQ(math::Color::Red, visual->InstanceColor(3u));
+
+  // out of range instances are ignored
+  visual->SetInstancePose(100u, math::Pose3d(1, 2, 3, 0, 0, 0));
+  EXPECT_EQ(math::Pose3d::Zero, visual->InstancePose(100u));
+  EXPECT_FALSE(visual->InstanceVisible(100u));
+
+  // the bounds cover all the visible instances
+  scene->PreRender();
+  math::AxisAlignedBox box = visual->LocalBoundingBox();
+  EXPECT_NEAR(-0.5, box.Min().X(), 1e-3);
+  EXPECT_NEAR(18.5, box.Max().X(), 1e-3);
+  EXPECT_NEAR(18.5, box.Max().Y(), 1e-3);
+  EXPECT_NEAR(2.0, box.Max().Z(), 1e-3);
+
+  // render a frame
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetLocalPosition(-10, 9, 10);
+  camera->SetLocalRotation(0, 0.6, 0);
+  camera->SetImageWidth(320);
+  camera->SetImageHeight(240);
+  scene->RootVisual()->AddChild(camera);
+  camera->Update();
+
+  // Clean up
+  scene->DestroyVisual(visual);
+  EXPECT_FALSE(scene->HasVisual(visual));
+  engine->DestroyScene(scene);
+}
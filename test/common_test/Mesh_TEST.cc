@@ -26,7 +26,9 @@
 #include <gz/common/SkeletonAnimation.hh>
 
 #include "gz/rendering/Camera.hh"
+#include "gz/rendering/Image.hh"
 #include "gz/rendering/Mesh.hh"
+#include "gz/rendering/PixelFormat.hh"
 #include "gz/rendering/Scene.hh"
 
 using namespace gz;
@@ -310,3 +312,123 @@ TEST_F(MeshTest, MeshClone)
   // Clean up
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(MeshTest, MeshLod)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  EXPECT_FALSE(scene->MeshLodEnabled());
+  scene->SetMeshLodEnabled(true);
+  EXPECT_TRUE(scene->MeshLodEnabled());
+
+  // a sphere dense enough to be simplified
+  const std::string meshName = "mesh_lod_sphere";
+  common::MeshManager::Instance()->CreateSphere(meshName, 0.5f, 64, 64);
+  const common::Mesh *commonMesh =
+      common::MeshManager::Instance()->MeshByName(meshName);
+  ASSERT_NE(nullptr, commonMesh);
+
+  MeshDescriptor descriptor(commonMesh);
+  MeshPtr mesh = scene->CreateMesh(descriptor);
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(commonMesh->SubMeshCount(), mesh->SubMeshCount());
+
+  MaterialPtr material = scene->CreateMaterial();
+  material->SetDiffuse(0.0, 1.0, 0.0);
+  material->SetEmissive(0.0, 1.0, 0.0);
+
+  VisualPtr visual = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual);
+  visual->AddGeometry(mesh);
+  visual->SetMaterial(material, false);
+  visual->SetLocalPosition(20, 0, 0);
+  scene->RootVisual()->AddChild(visual);
+
+  // render from a distance where the simplified LODs are used, the sphere
+  // is still drawn
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(64);
+  camera->SetImageHeight(64);
+  scene->RootVisual()->AddChild(camera);
+
+  Image image = camera->CreateImage();
+  camera->Capture(image);
+  math::Vector2i px = camera->Project(visual->WorldPosition());
+  ASSERT_GE(px.X(), 0);
+  ASSERT_LT(px.X(), static_cast<int>(camera->ImageWidth()));
+  ASSERT_GE(px.Y(), 0);
+  ASSERT_LT(px.Y(), static_cast<int>(camera->ImageHeight()));
+  unsigned char *data = image.Data<unsigned char>();
+  unsigned int bpp = PixelUtil::BytesPerPixel(camera->ImageFormat());
+  unsigned int idx = (px.Y() * camera->ImageWidth() + px.X()) * bpp;
+  EXPECT_GT(data[idx + 1], 50u);
+  EXPECT_LT(data[idx], 50u);
+
+  // meshes loaded after disabling LODs are not simplified
+  scene->SetMeshLodEnabled(false);
+  EXPECT_FALSE(scene->MeshLodEnabled());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshTest, MeshQuantization)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  EXPECT_FALSE(scene->MeshQuantizationEnabled());
+  scene->SetMeshQuantizationEnabled(true);
+  EXPECT_TRUE(scene->MeshQuantizationEnabled());
+
+  // meshes with normals, texture coordinates and indices are packed
+  MeshDescriptor descriptor("unit_box");
+  MeshPtr mesh = scene->CreateMesh(descriptor);
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(1u, mesh->SubMeshCount());
+
+  descriptor = MeshDescriptor("unit_sphere");
+  mesh = scene->CreateMesh(descriptor);
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(1u, mesh->SubMeshCount());
+
+  MaterialPtr material = scene->CreateMaterial();
+  material->SetDiffuse(0.0, 1.0, 0.0);
+  material->SetEmissive(0.0, 1.0, 0.0);
+
+  VisualPtr visual = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual);
+  visual->AddGeometry(mesh);
+  visual->SetMaterial(material, false);
+  visual->SetLocalPosition(2, 0, 0);
+  scene->RootVisual()->AddChild(visual);
+
+  // the packed sphere is drawn
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(64);
+  camera->SetImageHeight(64);
+  scene->RootVisual()->AddChild(camera);
+
+  Image image = camera->CreateImage();
+  camera->Capture(image);
+  unsigned char *data = image.Data<unsigned char>();
+  unsigned int bpp = PixelUtil::BytesPerPixel(camera->ImageFormat());
+  unsigned int idx = (32u * camera->ImageWidth() + 32u) * bpp;
+  EXPECT_GT(data[idx + 1], 50u);
+  EXPECT_LT(data[idx], 50u);
+
+  scene->SetMeshQuantizationEnabled(false);
+  EXPECT_FALSE(scene->MeshQuantizationEnabled());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
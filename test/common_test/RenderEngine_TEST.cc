@@ -115,3 +115,31 @@ TEST_F(RenderEngineTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(RenderEngine))
   engine->DestroyScenes();
   EXPECT_EQ(engine->SceneCount(), 0u);
 }
+
+/////////////////////////////////////////////////
+TEST_F(RenderEngineTest, StartupTimings)
+{
+  // the engine is loaded and initialized by the test fixture
+  const StartupTimeline &timeline = engine->StartupTimings();
+  ASSERT_FALSE(timeline.phases.empty());
+
+  bool hasLoad = false;
+  bool hasInit = false;
+  for (const auto &phase : timeline.phases)
+  {
+    EXPECT_FALSE(phase.name.empty());
+    EXPECT_LE(phase.start + phase.duration, timeline.Total());
+    hasLoad = hasLoad || phase.name == "Load";
+    hasInit = hasInit || phase.name == "Init";
+  }
+  EXPECT_TRUE(hasLoad);
+  EXPECT_TRUE(hasInit);
+
+  // phases are ordered by start time
+  for (size_t i = 1u; i < timeline.phases.size(); ++i)
+  {
+    EXPECT_LE(timeline.phases[i - 1u].start, timeline.phases[i].start);
+  }
+
+  EXPECT_NE(std::string::npos, timeline.ChromeTrace().find("\"Load\""));
+}
@@ -17,8 +17,15 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <thread>
+
 #include "CommonRenderingTest.hh"
 
+#include "gz/rendering/Camera.hh"
+#include "gz/rendering/DirectionalLight.hh"
+#include "gz/rendering/Image.hh"
+#include "gz/rendering/PixelFormat.hh"
 #include "gz/rendering/RenderTarget.hh"
 #include "gz/rendering/Scene.hh"
 
@@ -751,3 +758,541 @@ TEST_F(SceneTest, Sky)
   // Clean up
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(SceneTest, ObjectPooling)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  auto scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  EXPECT_FALSE(scene->ObjectPoolingEnabled());
+  scene->SetObjectPoolingEnabled(true);
+  EXPECT_TRUE(scene->ObjectPoolingEnabled());
+
+  VisualPtr root = scene->RootVisual();
+  ASSERT_NE(nullptr, root);
+
+  // create and destroy visuals repeatedly so objects are recycled
+  for (unsigned int i = 0; i < 10; ++i)
+  {
+    VisualPtr visual = scene->CreateVisual();
+    ASSERT_NE(nullptr, visual);
+    visual->AddGeometry(scene->CreateBox());
+    visual->SetLocalPosition(i, i, i);
+    visual->SetVisible(false);
+    root->AddChild(visual);
+    EXPECT_EQ(1u, visual->GeometryCount());
+    EXPECT_EQ(1u, root->ChildCount());
+
+    scene->DestroyVisual(visual, true);
+    EXPECT_EQ(0u, root->ChildCount());
+  }
+
+  // verify recycled visuals start off in a default state
+  VisualPtr visual = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual);
+  EXPECT_EQ(math::Vector3d::Zero, visual->LocalPosition());
+  EXPECT_EQ(0u, visual->GeometryCount());
+  EXPECT_EQ(0u, visual->ChildCount());
+  scene->DestroyVisual(visual);
+
+  scene->SetObjectPoolingEnabled(false);
+  EXPECT_FALSE(scene->ObjectPoolingEnabled());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneTest, CreateVisuals)
+{
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  VisualPtr root = scene->RootVisual();
+  ASSERT_NE(nullptr, root);
+
+  MaterialPtr material = scene->CreateMaterial();
+  ASSERT_NE(nullptr, material);
+
+  std::vector<VisualDescriptor> batch(3);
+  batch[0].name = "parent";
+  batch[0].localPose = math::Pose3d(1, 2, 3, 0, 0, 0);
+  batch[1].parentIndex = 0;
+  batch[1].mesh = MeshDescriptor("unit_box");
+  batch[1].material = material;
+  batch[2].parentIndex = 0;
+  batch[2].mesh = MeshDescriptor("unit_box");
+  batch[2].localScale = math::Vector3d(2, 2, 2);
+
+  unsigned int visualCount = scene->VisualCount();
+  std::vector<VisualPtr> visuals = scene->CreateVisuals(batch, root);
+  ASSERT_EQ(3u, visuals.size());
+  for (const auto &visual : visuals)
+    ASSERT_NE(nullptr, visual);
+  EXPECT_EQ(visualCount + 3u, scene->VisualCount());
+
+  // verify hierarchy
+  EXPECT_EQ("parent", visuals[0]->Name());
+  EXPECT_EQ(root, visuals[0]->Parent());
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 0), visuals[0]->LocalPose());
+  EXPECT_EQ(2u, visuals[0]->ChildCount());
+  EXPECT_EQ(visuals[0], visuals[1]->Parent());
+  EXPECT_EQ(visuals[0], visuals[2]->Parent());
+
+  // verify geometries and materials
+  EXPECT_EQ(0u, visuals[0]->GeometryCount());
+  EXPECT_EQ(1u, visuals[1]->GeometryCount());
+  EXPECT_EQ(1u, visuals[2]->GeometryCount());
+  EXPECT_EQ(material, visuals[1]->Material());
+  EXPECT_EQ(math::Vector3d(2, 2, 2), visuals[2]->LocalScale());
+
+  // parent index must refer to a previous descriptor
+  std::vector<VisualDescriptor> invalidBatch(1);
+  invalidBatch[0].parentIndex = 0;
+  EXPECT_TRUE(scene->CreateVisuals(invalidBatch).empty());
+
+  // names must be unique
+  invalidBatch[0].parentIndex = -1;
+  invalidBatch[0].name = "parent";
+  EXPECT_TRUE(scene->CreateVisuals(invalidBatch).empty());
+  EXPECT_EQ(visualCount + 3u, scene->VisualCount());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneTest, ChangeJournal)
+{
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  VisualPtr root = scene->RootVisual();
+  ASSERT_NE(nullptr, root);
+
+  // nothing is recorded while the journal is disabled
+  EXPECT_FALSE(scene->ChangeJournalEnabled());
+  VisualPtr untracked = scene->CreateVisual();
+  ASSERT_NE(nullptr, untracked);
+  EXPECT_TRUE(scene->DrainChanges().empty());
+
+  scene->SetChangeJournalEnabled(true);
+  EXPECT_TRUE(scene->ChangeJournalEnabled());
+
+  VisualPtr visual = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual);
+  root->AddChild(visual);
+  visual->SetLocalPosition(1, 2, 3);
+  visual->SetLocalPosition(4, 5, 6);
+  visual->SetMaterial(scene->CreateMaterial());
+
+  std::vector<SceneChange> changes = scene->DrainChanges();
+  ASSERT_EQ(4u, changes.size());
+  EXPECT_EQ(SceneChangeType::NODE_CREATED, changes[0].type);
+  EXPECT_EQ(visual->Id(), changes[0].nodeId);
+  EXPECT_EQ(SceneChangeType::NODE_REPARENTED, changes[1].type);
+  EXPECT_EQ(visual->Id(), changes[1].nodeId);
+  EXPECT_EQ(root->Id(), changes[1].parentId);
+  // repeated pose changes are recorded once
+  EXPECT_EQ(SceneChangeType::POSE_CHANGED, changes[2].type);
+  EXPECT_EQ(visual->Id(), changes[2].nodeId);
+  EXPECT_EQ(SceneChangeType::MATERIAL_CHANGED, changes[3].type);
+  EXPECT_EQ(visual->Id(), changes[3].nodeId);
+
+  // journal is empty after draining
+  EXPECT_TRUE(scene->DrainChanges().empty());
+
+  // pose changes are recorded again after draining
+  visual->SetLocalPosition(7, 8, 9);
+  changes = scene->DrainChanges();
+  ASSERT_EQ(1u, changes.size());
+  EXPECT_EQ(SceneChangeType::POSE_CHANGED, changes[0].type);
+
+  // scale changes are recorded as pose changes
+  visual->SetLocalScale(2.0);
+  changes = scene->DrainChanges();
+  ASSERT_EQ(1u, changes.size());
+  EXPECT_EQ(SceneChangeType::POSE_CHANGED, changes[0].type);
+  EXPECT_EQ(visual->Id(), changes[0].nodeId);
+
+  unsigned int visualId = visual->Id();
+  scene->DestroyVisual(visual);
+  changes = scene->DrainChanges();
+  ASSERT_EQ(2u, changes.size());
+  EXPECT_EQ(SceneChangeType::NODE_REPARENTED, changes[0].type);
+  EXPECT_EQ(visualId, changes[0].nodeId);
+  EXPECT_EQ(0u, changes[0].parentId);
+  EXPECT_EQ(SceneChangeType::NODE_DESTROYED, changes[1].type);
+  EXPECT_EQ(visualId, changes[1].nodeId);
+
+  // disabling the journal discards recorded changes
+  untracked->SetLocalPosition(1, 1, 1);
+  scene->SetChangeJournalEnabled(false);
+  EXPECT_TRUE(scene->DrainChanges().empty());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneTest, Attributes)
+{
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  // keys read by the material switchers are interned on init
+  unsigned int tempHandle = scene->AttributeHandle("temperature");
+  unsigned int labelHandle = scene->AttributeHandle("label");
+  EXPECT_NE(0u, tempHandle);
+  EXPECT_NE(0u, labelHandle);
+  EXPECT_EQ(tempHandle,
+      scene->InternAttribute("temperature", NodeAttributeType::FLOAT));
+  EXPECT_EQ(0u, scene->InternAttribute("temperature", NodeAttributeType::INT));
+  EXPECT_EQ(0u, scene->InternAttribute("", NodeAttributeType::FLOAT));
+  EXPECT_EQ(0u, scene->AttributeHandle("unknown"));
+
+  // user data of interned keys is mirrored
+  VisualPtr visual = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual);
+  float temp = 0.0f;
+  EXPECT_FALSE(scene->FloatAttribute(tempHandle, visual->Id(), temp));
+  visual->SetUserData("temperature", 300.5);
+  EXPECT_TRUE(scene->FloatAttribute(tempHandle, visual->Id(), temp));
+  EXPECT_FLOAT_EQ(300.5f, temp);
+  visual->SetUserData("temperature", 200);
+  EXPECT_TRUE(scene->FloatAttribute(tempHandle, visual->Id(), temp));
+  EXPECT_FLOAT_EQ(200.0f, temp);
+
+  // values of other types are not mirrored
+  visual->SetUserData("temperature", std::string("heat_signature.png"));
+  EXPECT_FALSE(scene->FloatAttribute(tempHandle, visual->Id(), temp));
+
+  int label = 0;
+  visual->SetUserData("label", 2.0f);
+  EXPECT_FALSE(scene->IntAttribute(labelHandle, visual->Id(), label));
+  visual->SetUserData("label", 3);
+  EXPECT_TRUE(scene->IntAttribute(labelHandle, visual->Id(), label));
+  EXPECT_EQ(3, label);
+  EXPECT_FALSE(scene->FloatAttribute(labelHandle, visual->Id(), temp));
+
+  // user data set before interning is picked up
+  visual->SetUserData("custom", 1.5f);
+  unsigned int customHandle =
+      scene->InternAttribute("custom", NodeAttributeType::FLOAT);
+  EXPECT_NE(0u, customHandle);
+  EXPECT_TRUE(scene->FloatAttribute(customHandle, visual->Id(), temp));
+  EXPECT_FLOAT_EQ(1.5f, temp);
+
+  // values are removed when the node is destroyed
+  VisualPtr other = scene->CreateVisual();
+  ASSERT_NE(nullptr, other);
+  other->SetUserData("label", 7);
+  unsigned int visualId = visual->Id();
+  scene->DestroyVisual(visual);
+  EXPECT_FALSE(scene->IntAttribute(labelHandle, visualId, label));
+  EXPECT_TRUE(scene->IntAttribute(labelHandle, other->Id(), label));
+  EXPECT_EQ(7, label);
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneTest, StaticBatching)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  scene->SetAmbientLight(0.3, 0.3, 0.3);
+
+  VisualPtr root = scene->RootVisual();
+  ASSERT_NE(nullptr, root);
+
+  DirectionalLightPtr light = scene->CreateDirectionalLight();
+  ASSERT_NE(nullptr, light);
+  light->SetDirection(1, 0, 0);
+  light->SetDiffuseColor(1, 1, 1);
+  root->AddChild(light);
+
+  // nothing to batch yet
+  EXPECT_EQ(0u, scene->BuildStaticBatches());
+  EXPECT_EQ(0u, scene->StaticBatchCount());
+
+  // static boxes sharing a material, side by side in one grid cell
+  MaterialPtr material = scene->CreateMaterial();
+  material->SetDiffuse(0.0, 1.0, 0.0);
+  material->SetEmissive(0.0, 1.0, 0.0);
+  auto createBox = [&](double _y)
+  {
+    VisualPtr box = scene->CreateVisual();
+    box->AddGeometry(scene->CreateBox());
+    box->SetMaterial(material, false);
+    box->SetLocalPosition(0, _y, 0);
+    box->SetLocalScale(0.5);
+    return box;
+  };
+
+  std::vector<VisualPtr> boxes;
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    VisualPtr box = createBox(0.5 + i);
+    ASSERT_NE(nullptr, box);
+    EXPECT_FALSE(box->Static());
+    box->SetStatic(true);
+    EXPECT_TRUE(box->Static());
+    root->AddChild(box);
+    boxes.push_back(box);
+  }
+
+  // static box under a non static parent
+  VisualPtr parent = scene->CreateVisual();
+  ASSERT_NE(nullptr, parent);
+  root->AddChild(parent);
+  VisualPtr child = createBox(4.5);
+  ASSERT_NE(nullptr, child);
+  child->SetStatic(true);
+  parent->AddChild(child);
+
+  // non static box with the same material, out of view
+  VisualPtr dynamicBox = createBox(0.0);
+  ASSERT_NE(nullptr, dynamicBox);
+  dynamicBox->SetLocalPosition(0, 0, 100);
+  root->AddChild(dynamicBox);
+
+  // clones keep the static flag
+  VisualPtr clone = boxes[0]->Clone("", root);
+  ASSERT_NE(nullptr, clone);
+  EXPECT_TRUE(clone->Static());
+  scene->DestroyVisual(clone);
+
+  // camera looking at the row of boxes
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetLocalPosition(-5, 2.5, 0);
+  camera->SetImageWidth(64);
+  camera->SetImageHeight(64);
+  root->AddChild(camera);
+
+  // check whether a box is drawn at the center of its projection
+  Image image = camera->CreateImage();
+  auto drawn = [&](const VisualPtr &_box)
+  {
+    math::Vector2i px = camera->Project(_box->WorldPosition());
+    EXPECT_GE(px.X(), 0);
+    EXPECT_LT(px.X(), static_cast<int>(camera->ImageWidth()));
+    EXPECT_GE(px.Y(), 0);
+    EXPECT_LT(px.Y(), static_cast<int>(camera->ImageHeight()));
+    unsigned char *data = image.Data<unsigned char>();
+    unsigned int bpp = PixelUtil::BytesPerPixel(camera->ImageFormat());
+    unsigned int idx = (px.Y() * camera->ImageWidth() + px.X()) * bpp;
+    return data[idx + 1] > 50u;
+  };
+
+  // all five boxes share the material and the cell
+  EXPECT_EQ(1u, scene->BuildStaticBatches());
+  EXPECT_EQ(1u, scene->StaticBatchCount());
+  camera->Capture(image);
+  for (const auto &box : boxes)
+    EXPECT_TRUE(drawn(box));
+  EXPECT_TRUE(drawn(child));
+
+  // batches are rebuilt from scratch
+  EXPECT_EQ(1u, scene->BuildStaticBatches(100.0));
+  EXPECT_EQ(1u, scene->StaticBatchCount());
+
+  // invalid cell size
+  EXPECT_EQ(0u, scene->BuildStaticBatches(0.0));
+  EXPECT_EQ(0u, scene->StaticBatchCount());
+
+  // a visual that is not static any more dissolves its batch, the other
+  // boxes are drawn individually
+  EXPECT_EQ(1u, scene->BuildStaticBatches());
+  boxes[0]->SetStatic(false);
+  EXPECT_FALSE(boxes[0]->Static());
+  EXPECT_EQ(0u, scene->StaticBatchCount());
+  camera->Capture(image);
+  for (const auto &box : boxes)
+    EXPECT_TRUE(drawn(box));
+  EXPECT_TRUE(drawn(child));
+
+  // hidden visual
+  EXPECT_EQ(1u, scene->BuildStaticBatches());
+  boxes[1]->SetVisible(false);
+  EXPECT_EQ(0u, scene->StaticBatchCount());
+  camera->Capture(image);
+  EXPECT_FALSE(drawn(boxes[1]));
+  EXPECT_TRUE(drawn(boxes[2]));
+
+  // hidden visuals are not batched
+  EXPECT_EQ(1u, scene->BuildStaticBatches());
+  camera->Capture(image);
+  EXPECT_FALSE(drawn(boxes[1]));
+  EXPECT_TRUE(drawn(boxes[2]));
+
+  // child of a hidden parent
+  parent->SetVisible(false);
+  EXPECT_EQ(0u, scene->StaticBatchCount());
+  camera->Capture(image);
+  EXPECT_FALSE(drawn(child));
+  EXPECT_TRUE(drawn(boxes[2]));
+  parent->SetVisible(true);
+
+  // visual removed from its parent
+  EXPECT_EQ(1u, scene->BuildStaticBatches());
+  root->RemoveChild(boxes[2]);
+  EXPECT_EQ(0u, scene->StaticBatchCount());
+  camera->Capture(image);
+  EXPECT_FALSE(drawn(boxes[2]));
+  EXPECT_TRUE(drawn(boxes[3]));
+
+  // removed visuals are not batched
+  EXPECT_EQ(1u, scene->BuildStaticBatches());
+  camera->Capture(image);
+  EXPECT_FALSE(drawn(boxes[2]));
+  EXPECT_TRUE(drawn(boxes[3]));
+
+  // destroyed visual
+  scene->DestroyVisual(boxes[3]);
+  EXPECT_EQ(0u, scene->StaticBatchCount());
+
+  scene->ClearStaticBatches();
+  EXPECT_EQ(0u, scene->StaticBatchCount());
+  camera->Update();
+
+  // batches are destroyed with the scene
+  scene->BuildStaticBatches();
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneTest, AsyncAssets)
+{
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  EXPECT_EQ(std::chrono::milliseconds(4), scene->AssetUploadBudget());
+  scene->SetAssetUploadBudget(std::chrono::milliseconds(2));
+  EXPECT_EQ(std::chrono::milliseconds(2), scene->AssetUploadBudget());
+
+  // nothing to wait for
+  EXPECT_TRUE(scene->WaitForAssets({}));
+
+  const std::string mediaPath =
+      common::joinPaths(std::string(PROJECT_SOURCE_PATH), "test", "media");
+  const std::string meshFile =
+      common::joinPaths(mediaPath, "meshes", "mesh.dae");
+  const std::string textureFile =
+      common::joinPaths(mediaPath, "materials", "textures", "texture.png");
+
+  AsyncAssetPtr meshAsset = scene->LoadMeshAsync(MeshDescriptor(meshFile));
+  ASSERT_NE(nullptr, meshAsset);
+  EXPECT_EQ(AsyncAssetType::MESH, meshAsset->Type());
+  EXPECT_EQ(meshFile, meshAsset->Name());
+
+  AsyncAssetPtr textureAsset = scene->LoadTextureAsync(textureFile);
+  ASSERT_NE(nullptr, textureAsset);
+  EXPECT_EQ(AsyncAssetType::TEXTURE, textureAsset->Type());
+
+  // missing files fail right away
+  AsyncAssetPtr missing = scene->LoadTextureAsync("no_such_texture.png");
+  ASSERT_NE(nullptr, missing);
+  EXPECT_EQ(AsyncAssetState::FAILED, missing->State());
+
+  // only the assets waited for are uploaded, the others are left to
+  // PreRender
+  EXPECT_TRUE(scene->WaitForAssets({meshAsset}));
+  EXPECT_EQ(AsyncAssetState::READY, meshAsset->State());
+  EXPECT_EQ(AsyncAssetState::PENDING, textureAsset->State());
+
+  EXPECT_TRUE(scene->WaitForAssets({meshAsset, textureAsset}));
+  EXPECT_EQ(AsyncAssetState::READY, meshAsset->State());
+  EXPECT_EQ(AsyncAssetState::READY, textureAsset->State());
+  EXPECT_FALSE(scene->WaitForAssets({meshAsset, missing}));
+
+  // the loaded assets can be used like synchronously loaded ones
+  MeshPtr mesh = meshAsset->Mesh();
+  ASSERT_NE(nullptr, mesh);
+  VisualPtr visual = scene->CreateVisual();
+  visual->AddGeometry(mesh);
+  scene->RootVisual()->AddChild(visual);
+
+  ASSERT_NE(nullptr, textureAsset->Image());
+  EXPECT_LT(0u, textureAsset->Image()->Width());
+  MaterialPtr material = scene->CreateMaterial();
+  material->SetTexture(textureAsset->Name(), textureAsset->Image());
+  visual->SetMaterial(material);
+
+  // assets loaded in the background are uploaded during PreRender
+  // give up after at least 10 s rather than hang if the upload never
+  // happens
+  AsyncAssetPtr again = scene->LoadMeshAsync(MeshDescriptor(meshFile));
+  unsigned int frames = 0u;
+  while (again->State() == AsyncAssetState::PENDING && frames++ < 10000u)
+  {
+    scene->PreRender();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_NE(AsyncAssetState::PENDING, again->State())
+      << "Asset still pending after " << frames << " frames";
+  EXPECT_EQ(AsyncAssetState::READY, again->State());
+  scene->PostRender();
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneTest, WarmUp)
+{
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  // no cameras to warm up
+  EXPECT_EQ(0u, scene->WarmUp());
+
+  VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetMaterial(scene->CreateMaterial());
+  box->SetLocalPosition(2, 0, 0);
+  scene->RootVisual()->AddChild(box);
+
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(32);
+  camera->SetImageHeight(32);
+  camera->SetLocalRotation(0, 0.3, 0.5);
+  scene->RootVisual()->AddChild(camera);
+
+  unsigned int frames = 0u;
+  common::ConnectionPtr connection = camera->ConnectNewImageFrame(
+      [&frames](const unsigned char *, unsigned int, unsigned int,
+                unsigned int, const std::string &)
+      {
+        ++frames;
+      });
+
+  const math::Quaterniond rotation = camera->LocalRotation();
+
+  WarmUpOptions options;
+  options.allDirections = false;
+  EXPECT_EQ(1u, scene->WarmUp(options));
+  EXPECT_EQ(1u, scene->WarmUp());
+
+  // the camera keeps its pose and no frames are emitted
+  EXPECT_EQ(rotation, camera->LocalRotation());
+  EXPECT_EQ(0u, frames);
+
+  // the camera still renders normally afterwards
+  camera->Update();
+  EXPECT_EQ(1u, frames);
+
+  // Clean up
+  connection.reset();
+  engine->DestroyScene(scene);
+}
@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 #include <string>
+#include <vector>
 
 #include "CommonRenderingTest.hh"
 
@@ -159,6 +160,110 @@ TEST_F(VisualTest, Children)
   engine->DestroyScene(scene);
 }
 
+/////////////////////////////////////////////////
+TEST_F(VisualTest, ChildOrder)
+{
+  ScenePtr scene = engine->CreateScene("scene2");
+  ASSERT_NE(nullptr, scene);
+
+  VisualPtr visual = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual);
+
+  // children are indexed in name order regardless of insertion order
+  VisualPtr childC = scene->CreateVisual("child_c");
+  VisualPtr childA = scene->CreateVisual("child_a");
+  VisualPtr childB = scene->CreateVisual("child_b");
+  ASSERT_NE(nullptr, childC);
+  ASSERT_NE(nullptr, childA);
+  ASSERT_NE(nullptr, childB);
+  visual->AddChild(childC);
+  visual->AddChild(childA);
+  visual->AddChild(childB);
+  ASSERT_EQ(3u, visual->ChildCount());
+  EXPECT_EQ(childA, visual->ChildByIndex(0u));
+  EXPECT_EQ(childB, visual->ChildByIndex(1u));
+  EXPECT_EQ(childC, visual->ChildByIndex(2u));
+  EXPECT_EQ(childB, visual->ChildByName("child_b"));
+  EXPECT_EQ(nullptr, visual->ChildByName("child_d"));
+
+  // removal keeps the remaining children in order
+  EXPECT_EQ(childB, visual->RemoveChildByName("child_b"));
+  ASSERT_EQ(2u, visual->ChildCount());
+  EXPECT_EQ(childA, visual->ChildByIndex(0u));
+  EXPECT_EQ(childC, visual->ChildByIndex(1u));
+
+  // material propagates to every child
+  MaterialPtr material = scene->CreateMaterial();
+  visual->SetMaterial(material, false);
+  EXPECT_EQ(material, childA->Material());
+  EXPECT_EQ(material, childC->Material());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(VisualTest, ManyChildren)
+{
+  ScenePtr scene = engine->CreateScene("scene2");
+  ASSERT_NE(nullptr, scene);
+
+  VisualPtr visual = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual);
+
+  // enough children to move the store past its small vector, added out of
+  // name order
+  const unsigned int count = 1000u;
+  auto childName = [](unsigned int _i)
+  {
+    std::string digits = std::to_string(_i);
+    return "child_" + std::string(4u - digits.size(), '0') + digits;
+  };
+  std::vector<VisualPtr> children(count);
+  for (unsigned int i = 0u; i < count; ++i)
+  {
+    // 7 and 1000 are coprime, so every index is visited once
+    const unsigned int index = (i * 7u) % count;
+    children[index] = scene->CreateVisual(childName(index));
+    ASSERT_NE(nullptr, children[index]);
+    visual->AddChild(children[index]);
+  }
+  ASSERT_EQ(count, visual->ChildCount());
+  for (unsigned int i = 0u; i < count; ++i)
+  {
+    EXPECT_EQ(children[i], visual->ChildByIndex(i));
+    EXPECT_EQ(children[i], visual->ChildByName(childName(i)));
+    EXPECT_EQ(visual, children[i]->Parent());
+  }
+  EXPECT_EQ(nullptr, visual->ChildByName("child_1000"));
+
+  // remove every other child by name, then a few by index
+  for (unsigned int i = 0u; i < count; i += 2u)
+    EXPECT_EQ(children[i], visual->RemoveChildByName(childName(i)));
+  ASSERT_EQ(count / 2u, visual->ChildCount());
+  for (unsigned int i = 0u; i < count / 2u; ++i)
+    EXPECT_EQ(children[i * 2u + 1u], visual->ChildByIndex(i));
+  EXPECT_EQ(children[1], visual->RemoveChildByIndex(0u));
+  EXPECT_EQ(children[count - 1u],
+      visual->RemoveChildByIndex(visual->ChildCount() - 1u));
+  ASSERT_EQ(count / 2u - 2u, visual->ChildCount());
+  EXPECT_EQ(children[3], visual->ChildByIndex(0u));
+  EXPECT_EQ(children[count - 3u],
+      visual->ChildByIndex(visual->ChildCount() - 1u));
+
+  // emptied stores can be filled again
+  visual->RemoveChildren();
+  EXPECT_EQ(0u, visual->ChildCount());
+  visual->AddChild(children[2]);
+  visual->AddChild(children[1]);
+  ASSERT_EQ(2u, visual->ChildCount());
+  EXPECT_EQ(children[1], visual->ChildByIndex(0u));
+  EXPECT_EQ(children[2], visual->ChildByIndex(1u));
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
 /////////////////////////////////////////////////
 TEST_F(VisualTest, Scale)
 {
@@ -29,6 +29,7 @@
 #include "gz/rendering/Heightmap.hh"
 #include "gz/rendering/Image.hh"
 #include "gz/rendering/PixelFormat.hh"
+#include "gz/rendering/RayQuery.hh"
 #include "gz/rendering/Scene.hh"
 
 #include <gz/utils/ExtraTestMacros.hh>
@@ -592,3 +593,62 @@ TEST_F(HeightmapTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(HeightmapGpuRays))
   // Clean up
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(HeightmapRayQuery))
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  VisualPtr root = scene->RootVisual();
+  ASSERT_NE(nullptr, root);
+
+  auto data = std::make_shared<common::ImageHeightmap>();
+  data->Load(common::joinPaths(TEST_MEDIA_PATH, "heightmap_bowl.png"));
+
+  HeightmapDescriptor desc;
+  desc.SetName("example_bowl");
+  desc.SetData(data);
+  desc.SetSize({ 17, 17, 7.0 });
+  desc.SetSampling(2u);
+
+  auto heightmap = scene->CreateHeightmap(desc);
+  ASSERT_NE(nullptr, heightmap);
+
+  auto vis = scene->CreateVisual();
+  vis->AddGeometry(heightmap);
+  root->AddChild(vis);
+
+  // heightmaps are intersected on the CPU, without rendering
+  RayQueryPtr rayQuery = scene->CreateRayQuery();
+  ASSERT_NE(nullptr, rayQuery);
+  rayQuery->SetOrigin(math::Vector3d(0.5, -0.5, 20.0));
+  rayQuery->SetDirection(-math::Vector3d::UnitZ);
+  RayQueryResult result = rayQuery->ClosestPoint();
+  EXPECT_TRUE(result);
+  EXPECT_EQ(vis->Id(), result.objectId);
+  EXPECT_NEAR(0.5, result.point.X(), DOUBLE_TOL);
+  EXPECT_NEAR(-0.5, result.point.Y(), DOUBLE_TOL);
+  EXPECT_LE(data->MinElevation() - DOUBLE_TOL, result.point.Z());
+  EXPECT_GE(data->MinElevation() + 7.0 + DOUBLE_TOL, result.point.Z());
+  EXPECT_NEAR(20.0 - result.point.Z(), result.distance, DOUBLE_TOL);
+
+  // the bowl is higher at its edge than at its center
+  rayQuery->SetOrigin(math::Vector3d(7.0, 0.0, 20.0));
+  RayQueryResult edgeResult = rayQuery->ClosestPoint();
+  EXPECT_TRUE(edgeResult);
+  EXPECT_GT(edgeResult.point.Z(), result.point.Z());
+
+  // outside of the heightmap
+  rayQuery->SetOrigin(math::Vector3d(100.0, 100.0, 20.0));
+  EXPECT_FALSE(rayQuery->ClosestPoint());
+
+  // hidden heightmaps are ignored
+  rayQuery->SetOrigin(math::Vector3d(0.5, -0.5, 20.0));
+  vis->SetVisible(false);
+  EXPECT_FALSE(rayQuery->ClosestPoint());
+
+  engine->DestroyScene(scene);
+}
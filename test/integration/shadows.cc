@@ -187,3 +187,93 @@ TEST_F(ShadowsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Shadows))
   // Clean up
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(ShadowsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(LightCastShadowsToggle))
+{
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  scene->SetAmbientLight(0.3, 0.3, 0.3);
+
+  VisualPtr root = scene->RootVisual();
+  ASSERT_NE(nullptr, root);
+
+  // downward looking camera
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(10);
+  camera->SetImageHeight(10);
+  camera->SetLocalRotation(0, 1.57, 0);
+  root->AddChild(camera);
+
+  DirectionalLightPtr light = scene->CreateDirectionalLight();
+  light->SetDirection(0.0, 0.0, -1);
+  light->SetDiffuseColor(0.5, 0.5, 0.5);
+  light->SetSpecularColor(0.5, 0.5, 0.5);
+  root->AddChild(light);
+
+  // box casting a shadow on the left half of the image
+  VisualPtr boxTop = scene->CreateVisual();
+  boxTop->AddGeometry(scene->CreateBox());
+  boxTop->SetLocalPosition(0.0, 0.5, 0.55);
+  root->AddChild(boxTop);
+
+  MaterialPtr green = scene->CreateMaterial();
+  green->SetAmbient(0.0, 0.5, 0.0);
+  green->SetDiffuse(0.0, 0.7, 0.0);
+  VisualPtr boxBottom = scene->CreateVisual();
+  boxBottom->AddGeometry(scene->CreateBox());
+  boxBottom->SetLocalPosition(0.0, 0.0, -1.0);
+  boxBottom->SetMaterial(green);
+  root->AddChild(boxBottom);
+
+  Image image = camera->CreateImage();
+  unsigned int bpp = PixelUtil::BytesPerPixel(camera->ImageFormat());
+  unsigned int step = camera->ImageWidth() * bpp;
+
+  // difference between the right and left halves of the image
+  auto contrast = [&]()
+  {
+    camera->Capture(image);
+    unsigned char *data = image.Data<unsigned char>();
+    int left = 0;
+    int right = 0;
+    for (unsigned int i = 0; i < camera->ImageHeight(); ++i)
+    {
+      for (unsigned int j = 0; j < step; j += bpp)
+      {
+        unsigned int idx = i * step + j;
+        int sum = data[idx] + data[idx + 1] + data[idx + 2];
+        if (j < step / 2)
+          left += sum;
+        else
+          right += sum;
+      }
+    }
+    return right - left;
+  };
+
+  // the camera keeps rendering correctly while the shadow node switches
+  // between light configurations, including back to one used before
+  for (unsigned int k = 0; k < 3; ++k)
+  {
+    light->SetCastShadows(true);
+    int shadowed = contrast();
+
+    light->SetCastShadows(false);
+    int unshadowed = contrast();
+
+    // setting the same value again does not change the configuration
+    light->SetCastShadows(false);
+    EXPECT_EQ(unshadowed, contrast());
+
+    // Test currently fails on macOS
+#ifndef __APPLE__
+    EXPECT_GT(shadowed, unshadowed);
+    EXPECT_NEAR(0, unshadowed, 5);
+#endif
+  }
+
+  scene->DestroyMaterial(green);
+  engine->DestroyScene(scene);
+}
@@ -22,9 +22,13 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include "CommonRenderingTest.hh"
 
 #include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
 
 #include <gz/utils/ExtraTestMacros.hh>
 
@@ -160,3 +164,52 @@ TEST_F(SceneFactoryTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(VisualMemoryLeak))
 
   this->checkMemLeak(function);
 }
+
+/////////////////////////////////////////////////
+TEST_F(SceneFactoryTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(LargeSceneMemory))
+{
+  auto function = [](ScenePtr _scene)
+  {
+    double residentStart = 0;
+    double shareStart = 0;
+    getMemInfo(residentStart, shareStart);
+
+    // 100k nodes: models under the root visual, each with a link holding a
+    // visual and a collision, like a world loaded from SDF
+    const unsigned int numModels = 25000;
+    VisualPtr root = _scene->RootVisual();
+    std::vector<VisualPtr> models;
+    models.reserve(numModels);
+    for (unsigned int i = 0; i < numModels; ++i)
+    {
+      std::string name = "model" + std::to_string(i);
+      auto model = _scene->CreateVisual(name);
+      auto link = _scene->CreateVisual(name + "::link");
+      auto visual = _scene->CreateVisual(name + "::link::visual");
+      auto collision = _scene->CreateVisual(name + "::link::collision");
+      visual->AddGeometry(_scene->CreateBox());
+      collision->AddGeometry(_scene->CreateBox());
+      link->AddChild(visual);
+      link->AddChild(collision);
+      model->AddChild(link);
+      root->AddChild(model);
+      models.push_back(model);
+    }
+    EXPECT_EQ(numModels, root->ChildCount());
+
+    double residentEnd = 0;
+    double shareEnd = 0;
+    getMemInfo(residentEnd, shareEnd);
+    gzdbg << "Resident memory of a " << numModels * 4 << " node scene ["
+          << residentEnd - residentStart << " KB], ["
+          << (residentEnd - residentStart) * 1024.0 / (numModels * 4)
+          << " bytes] per node" << std::endl;
+
+    // Recursive destroy, removing every model from the root visual
+    for (auto &model : models)
+      _scene->DestroyVisual(model, true);
+    EXPECT_EQ(0u, root->ChildCount());
+  };
+
+  this->checkMemLeak(function);
+}